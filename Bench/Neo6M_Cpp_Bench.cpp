@@ -0,0 +1,147 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Cpp_Bench.cpp
+  * @author  Huy Nguyen
+  * @brief   C++ front end against the C entry point over the sentence corpus
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Neo6M_Cpp.hpp"
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_DEFAULT_CORPUS                "Bench/Corpus/Neo6M_Corpus.nmea"
+#define BENCH_DEFAULT_MIN_MS                300U    /* Shortest measurement per row */
+
+/* Private variables ---------------------------------------------------------*/
+static std::vector<std::string> g_lines;
+static volatile uint32_t        g_sink;             /* Keeps the results alive */
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function runs a parse function over every corpus line until minMs elapsed.
+  * @param[in]  parse               Callable taking a line, returning 1 if it was decoded
+  * @param[in]  minMs               Shortest measurement
+  * @param[out] pDecoded            Lines decoded in one pass
+  * @retval     Nanoseconds per sentence
+  */
+template <typename Parse>
+static double Bench_Measure(Parse parse, const uint32_t minMs, uint32_t *pDecoded)
+{
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t    rounds      = 1U;
+    uint64_t    sentences   = 0U;
+    uint64_t    elapsedNs   = 0U;
+    uint32_t    decoded     = 0U;
+
+    /* Warm up, then double the rounds until the run is long enough to trust */
+    while (elapsedNs < (static_cast<uint64_t>(minMs) * 1000000ULL))
+    {
+        Clock::time_point start = Clock::now();
+
+        decoded = 0U;
+
+        for (uint64_t round = 0U; round < rounds; round++)
+        {
+            for (std::string const& line : g_lines)
+            {
+                decoded += parse(line);
+            }
+        }
+
+        elapsedNs   = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        sentences   = rounds * g_lines.size();
+        decoded    /= static_cast<uint32_t>(rounds);
+        rounds     *= 2U;
+    }
+
+    *pDecoded = decoded;
+
+    return static_cast<double>(elapsedNs) / static_cast<double>(sentences);
+}
+
+int main(int argc, char **argv)
+{
+    char const*     path    = (argc > 1) ? argv[1] : BENCH_DEFAULT_CORPUS;
+    uint32_t        minMs   = (argc > 2) ? static_cast<uint32_t>(atoi(argv[2])) : BENCH_DEFAULT_MIN_MS;
+    std::ifstream   file(path, std::ios::binary);
+    std::string     line;
+    uint32_t        decodedC;
+    uint32_t        decodedCpp;
+    double          nsC;
+    double          nsCpp;
+
+    Neo6m::Parser<Neo6m::Rmc, Neo6m::Vtg, Neo6m::Gga, Neo6m::Gsa> parser;
+
+    while (std::getline(file, line))
+    {
+        g_lines.push_back(line + "\n");
+    }
+
+    if (g_lines.empty())
+    {
+        (void) fprintf(stderr, "cannot read corpus %s\n", path);
+        return 1;
+    }
+
+    nsC = Bench_Measure([](std::string const& text) -> uint32_t
+    {
+        GPS_Sentence_t sentence;
+        uint32_t ok = (NEO6M_GPSNeo6_ParseSentence(text.c_str(), &sentence) == NEO6M_OK) ? 1U : 0U;
+
+        g_sink = sentence.info.gsa.pdop;
+        return ok;
+    }, minMs, &decodedC);
+
+    nsCpp = Bench_Measure([&parser](std::string const& text) -> uint32_t
+    {
+        auto result = parser.Parse(text);
+
+        g_sink = static_cast<uint32_t>(result.index());
+        return (result.index() != 0U) ? 1U : 0U;
+    }, minMs, &decodedCpp);
+
+    (void) printf("corpus %s, %zu lines\n", path, g_lines.size());
+    (void) printf("%-31s %12s %10s\n", "entry", "ns/sentence", "decoded");
+    (void) printf("%-31s %12.1f %10u\n", "NEO6M_GPSNeo6_ParseSentence", nsC, decodedC);
+    (void) printf("%-31s %12.1f %10u\n", "Neo6m::Parser<Rmc,Vtg,Gga,Gsa>", nsCpp, decodedCpp);
+    (void) printf("speed-up %.1fx\n", nsC / nsCpp);
+
+    return (decodedC == decodedCpp) ? 0 : 1;
+}
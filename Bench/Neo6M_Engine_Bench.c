@@ -0,0 +1,366 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Engine_Bench.c
+  * @author  Huy Nguyen
+  * @brief   Engine throughput benchmark with pty-backed fake receivers
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE                         /* posix_openpt, ptsname */
+#include <fcntl.h>
+#include <stdio.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Neo6M_Engine.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_DEFAULT_RECEIVERS             64U     /* Fake receivers */
+#define BENCH_DEFAULT_EPOCHS                2000U   /* Epochs sent by each receiver */
+#define BENCH_EPOCHS_PER_BLOCK              16U     /* Epochs written to a pty at once */
+#define BENCH_SENTENCES_PER_EPOCH           4U      /* RMC, VTG, GGA, GSA */
+#define BENCH_BLOCK_LENGTH                  4096U   /* Bytes of one block */
+#define BENCH_LATENCY_BUCKETS               40U     /* Latency histogram, bucket n holds [2^(n-1), 2^n) ns */
+
+/**
+ * @brief Data structure that contains one benchmark run
+*/
+typedef struct
+{
+    int         masters[ENGINE_MAX_RECEIVERS];  /* Writer side of each pty */
+    int         slaves[ENGINE_MAX_RECEIVERS];   /* Engine side of each pty */
+    char        block[BENCH_BLOCK_LENGTH];      /* Sentences written per pty per round */
+    uint32_t    blockLen;                       /* Bytes in block */
+    uint32_t    receivers;                      /* Receivers in use */
+    uint32_t    rounds;                         /* Blocks written to each pty */
+} Bench_Run_t;
+
+/**
+ * @brief Data structure that contains the byte-to-fix latencies of one run: from the read
+ *        that delivered the last byte of a sentence to the consumer popping its fix
+*/
+typedef struct
+{
+    uint64_t    bucket[BENCH_LATENCY_BUCKETS];  /* Fixes per power of two of nanoseconds */
+    uint64_t    count;                          /* Fixes measured */
+    uint64_t    maxNs;                          /* Slowest fix */
+} Bench_Latency_t;
+
+/* Private variables ---------------------------------------------------------*/
+static Engine_t     g_engine;
+static Bench_Run_t  g_run;
+
+static char const* const g_epoch[BENCH_SENTENCES_PER_EPOCH] =
+{
+    "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n",
+    "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n",
+    "$GPGGA,083559.00,4717.11437,N,00833.91522,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n",
+    "$GPGSA,A,3,04,05,09,12,,,,,,,,,2.56,1.27,2.22*0D\r\n"
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function opens a raw pty pair standing in for one serial receiver.
+  * @param[out] pMaster             Writer side
+  * @param[out] pSlave              Engine side
+  * @retval     NEO6M_OK if opened, NEO6M_NOK if not
+  */
+static CheckStatus_t Bench_OpenPty(int *pMaster, int *pSlave)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    struct termios tio;
+
+    *pMaster = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if ((*pMaster >= 0) && (grantpt(*pMaster) == 0) && (unlockpt(*pMaster) == 0))
+    {
+        *pSlave = open(ptsname(*pMaster), O_RDWR | O_NOCTTY);
+
+        if ((*pSlave >= 0) && (tcgetattr(*pSlave, &tio) == 0))
+        {
+            /* No line discipline: bytes reach the engine exactly as written */
+            cfmakeraw(&tio);
+            status = (tcsetattr(*pSlave, TCSANOW, &tio) == 0) ? NEO6M_OK : NEO6M_NOK;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      Writer thread: plays every receiver, one block per pty per round.
+  * @param[in]  pArg                Pointer to run
+  * @retval     NULL
+  */
+static void* Bench_Writer(void *pArg)
+{
+    Bench_Run_t *pRun = (Bench_Run_t*)pArg;
+    uint32_t round;
+    uint32_t index;
+    uint32_t sent;
+    ssize_t  written;
+
+    for (round = 0U; round < pRun->rounds; round++)
+    {
+        for (index = 0U; index < pRun->receivers; index++)
+        {
+            for (sent = 0U; sent < pRun->blockLen; sent += (uint32_t)written)
+            {
+                written = write(pRun->masters[index], &pRun->block[sent], pRun->blockLen - sent);
+
+                if (written <= 0)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+  * @brief      This function returns a monotonic time in seconds.
+  * @retval     Seconds
+  */
+static double Bench_Now(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/**
+  * @brief      This function adds one latency to a histogram.
+  * @param[out] pLatency            Pointer to histogram
+  * @param[in]  ns                  Latency
+  * @retval     None
+  */
+static void Bench_AddLatency(Bench_Latency_t *pLatency, const uint64_t ns)
+{
+    uint32_t bucket = (ns == 0U) ? 0U : (64U - (uint32_t)__builtin_clzll(ns));
+
+    if (bucket >= BENCH_LATENCY_BUCKETS)
+    {
+        bucket = BENCH_LATENCY_BUCKETS - 1U;
+    }
+
+    pLatency->bucket[bucket]++;
+    pLatency->count++;
+
+    if (ns > pLatency->maxNs)
+    {
+        pLatency->maxNs = ns;
+    }
+}
+
+/**
+  * @brief      This function reads a percentile off a histogram.
+  * @param[in]  pLatency            Pointer to histogram
+  * @param[in]  percent             Percentile
+  * @retval     Upper bound of the bucket holding the percentile, at most the slowest fix,
+  *             in microseconds
+  */
+static double Bench_Percentile(Bench_Latency_t const* pLatency, const double percent)
+{
+    uint64_t rank = (uint64_t)(((double)pLatency->count * percent) / 100.0);
+    uint64_t seen = 0U;
+    uint32_t bucket;
+
+    for (bucket = 0U; bucket < (BENCH_LATENCY_BUCKETS - 1U); bucket++)
+    {
+        seen += pLatency->bucket[bucket];
+
+        if (seen > rank)
+        {
+            break;
+        }
+    }
+
+    return (double)(((1ULL << bucket) < pLatency->maxNs) ? (1ULL << bucket) : pLatency->maxNs) / 1000.0;
+}
+
+/**
+  * @brief      This function prints the non-empty buckets of a histogram.
+  * @param[in]  pLatency            Pointer to histogram
+  * @param[in]  shards              Worker shards of the run
+  * @retval     None
+  */
+static void Bench_PrintLatency(Bench_Latency_t const* pLatency, const uint16_t shards)
+{
+    uint64_t seen = 0U;
+    uint32_t bucket;
+
+    (void) printf("byte-to-fix latency, %u shards\n", shards);
+    (void) printf("%14s %12s %8s\n", "below us", "fixes", "cum %");
+
+    for (bucket = 0U; bucket < BENCH_LATENCY_BUCKETS; bucket++)
+    {
+        if (pLatency->bucket[bucket] > 0U)
+        {
+            seen += pLatency->bucket[bucket];
+            (void) printf("%14.3f %12llu %7.2f%%\n", (double)(1ULL << bucket) / 1000.0,
+                          (unsigned long long)pLatency->bucket[bucket], ((double)seen * 100.0) / (double)pLatency->count);
+        }
+    }
+}
+
+/**
+  * @brief      This function runs the engine with the given number of shards.
+  * @param[in]  shards              Worker shards
+  * @param[out] pLatency            Pointer to byte-to-fix latency histogram
+  * @retval     Decoded sentences per second, 0 on error
+  */
+static double Bench_Run(const uint16_t shards, Bench_Latency_t *pLatency)
+{
+    Engine_Fix_t fix;
+    pthread_t    writer;
+    uint32_t     expected = g_run.receivers * g_run.rounds * BENCH_EPOCHS_PER_BLOCK * BENCH_SENTENCES_PER_EPOCH;
+    uint32_t     received = 0U;
+    uint32_t     index;
+    uint16_t     id;
+    double       start;
+    double       elapsed;
+
+    (void) NEO6M_Engine_Init(&g_engine, shards);
+
+    for (index = 0U; index < g_run.receivers; index++)
+    {
+        if (Bench_OpenPty(&g_run.masters[index], &g_run.slaves[index]) != NEO6M_OK)
+        {
+            (void) fprintf(stderr, "cannot open pty %u\n", index);
+            return 0.0;
+        }
+
+        (void) NEO6M_Engine_AddReceiver(&g_engine, g_run.slaves[index], &id);
+    }
+
+    start = Bench_Now();
+
+    (void) NEO6M_Engine_Start(&g_engine);
+    (void) pthread_create(&writer, NULL, Bench_Writer, &g_run);
+
+    (void) memset(pLatency, 0, sizeof(Bench_Latency_t));
+
+    while ((received < expected) && (NEO6M_Engine_Pop(&g_engine, &fix, 5000U) == NEO6M_OK))
+    {
+        Bench_AddLatency(pLatency, NEO6M_Stream_NowNs() - fix.stamp.lastNs);
+        received++;
+    }
+
+    elapsed = Bench_Now() - start;
+
+    (void) pthread_join(writer, NULL);
+
+    for (index = 0U; index < g_run.receivers; index++)
+    {
+        (void) close(g_run.masters[index]);
+    }
+
+    NEO6M_Engine_Stop(&g_engine);
+
+    for (index = 0U; index < g_run.receivers; index++)
+    {
+        (void) close(g_run.slaves[index]);
+    }
+
+    if (received != expected)
+    {
+        (void) fprintf(stderr, "shards %u: received %u of %u sentences\n", shards, received, expected);
+    }
+
+    return (double)received / elapsed;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      Benchmark entry: neo6m_engine_bench [receivers] [epochs per receiver]
+  * @retval     0
+  */
+int main(int argc, char **argv)
+{
+    long     cores  = sysconf(_SC_NPROCESSORS_ONLN);
+    static Bench_Latency_t latency[ENGINE_MAX_SHARDS + 1U];
+    double   base   = 0.0;
+    double   rate;
+    uint32_t epochs = BENCH_DEFAULT_EPOCHS;
+    uint16_t shards;
+    uint32_t index;
+
+    g_run.receivers = (argc > 1) ? (uint32_t)atoi(argv[1]) : BENCH_DEFAULT_RECEIVERS;
+    epochs          = (argc > 2) ? (uint32_t)atoi(argv[2]) : epochs;
+
+    if ((g_run.receivers == 0U) || (g_run.receivers > ENGINE_MAX_RECEIVERS))
+    {
+        g_run.receivers = BENCH_DEFAULT_RECEIVERS;
+    }
+
+    g_run.rounds = (epochs + BENCH_EPOCHS_PER_BLOCK - 1U) / BENCH_EPOCHS_PER_BLOCK;
+
+    for (index = 0U; index < (BENCH_EPOCHS_PER_BLOCK * BENCH_SENTENCES_PER_EPOCH); index++)
+    {
+        char const* line = g_epoch[index % BENCH_SENTENCES_PER_EPOCH];
+
+        (void) memcpy(&g_run.block[g_run.blockLen], line, strlen(line));
+        g_run.blockLen += (uint32_t)strlen(line);
+    }
+
+    (void) printf("receivers %u, sentences per receiver %u, cores %ld\n",
+                  g_run.receivers, g_run.rounds * BENCH_EPOCHS_PER_BLOCK * BENCH_SENTENCES_PER_EPOCH, cores);
+    (void) printf("%8s %16s %10s %10s %10s %10s %10s\n",
+                  "shards", "sentences/s", "speedup", "p50 us", "p99 us", "p99.9 us", "max us");
+
+    for (shards = 1U; (shards <= ENGINE_MAX_SHARDS) && (shards <= (uint16_t)cores); shards *= 2U)
+    {
+        rate = Bench_Run(shards, &latency[shards]);
+
+        if (shards == 1U)
+        {
+            base = rate;
+        }
+
+        (void) printf("%8u %16.0f %9.2fx %10.1f %10.1f %10.1f %10.1f\n", shards, rate, (base > 0.0) ? (rate / base) : 0.0,
+                      Bench_Percentile(&latency[shards], 50.0), Bench_Percentile(&latency[shards], 99.0),
+                      Bench_Percentile(&latency[shards], 99.9), (double)latency[shards].maxNs / 1000.0);
+    }
+
+    for (shards = 1U; (shards <= ENGINE_MAX_SHARDS) && (shards <= (uint16_t)cores); shards *= 2U)
+    {
+        Bench_PrintLatency(&latency[shards], shards);
+    }
+
+    return 0;
+}
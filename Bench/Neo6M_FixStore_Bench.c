@@ -0,0 +1,323 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_FixStore_Bench.c
+  * @author  Huy Nguyen
+  * @brief   Reader scaling of the latest-fix store against a mutex
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE                         /* pthread_setaffinity_np, CPU_SET */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Neo6M_FixStore.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_MAX_READERS                   64U     /* Reader threads */
+#define BENCH_DEFAULT_MS                    500U    /* Measurement per row */
+#define BENCH_DEFAULT_PERIOD_US             100U    /* Writer period, far faster than any receiver */
+
+/**
+ * @brief Data structure that contains the fix guarded by a mutex, the design the store replaces
+*/
+typedef struct
+{
+    pthread_mutex_t lock;       /* Protects fix and version */
+    GPRMC_Info_t    fix;        /* Latest fix */
+    uint32_t        version;    /* Fixes published */
+} Bench_MutexStore_t;
+
+/**
+ * @brief Data structure that contains the counters of one reader, on a line of its own
+*/
+typedef struct
+{
+    uint64_t        reads __attribute__((aligned(FIXSTORE_CACHE_LINE_SIZE)));  /* Complete fixes read */
+    uint64_t        torn;                                                       /* Reads that gave up on a torn fix */
+    pthread_t       thread;                                                     /* Reader thread */
+} Bench_Reader_t;
+
+/* Private variables ---------------------------------------------------------*/
+static FixStore_t           g_store;
+static Bench_MutexStore_t   g_mutexStore = {PTHREAD_MUTEX_INITIALIZER};
+static Bench_Reader_t       g_readers[BENCH_MAX_READERS];
+static uint8_t              g_useMutex;         /* Design measured by the current row */
+static uint8_t              g_stop;             /* Readers and writer must exit */
+static uint32_t             g_periodUs = BENCH_DEFAULT_PERIOD_US;
+static long                 g_cores;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function returns a monotonic time in seconds.
+  * @retval     Seconds
+  */
+static double Bench_Now(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/**
+  * @brief      This function pins a thread to core n % (online cores).
+  * @param[in]  thread              Thread
+  * @param[in]  n                   Core index before the modulo
+  * @retval     None
+  */
+static void Bench_Pin(pthread_t thread, const uint32_t n)
+{
+    cpu_set_t set;
+
+    if (g_cores > 0)
+    {
+        CPU_ZERO(&set);
+        CPU_SET((int)(n % (uint32_t)g_cores), &set);
+        (void) pthread_setaffinity_np(thread, sizeof(set), &set);
+    }
+}
+
+/**
+  * @brief      Writer thread: publishes a new fix every period, like the parser thread.
+  * @param[in]  pArg                Unused
+  * @retval     NULL
+  */
+static void* Bench_Writer(void *pArg)
+{
+    struct timespec period = {0, (long)g_periodUs * 1000L};
+    GPRMC_Info_t    fix;
+    uint32_t        n = 0U;
+
+    (void) pArg;
+    (void) memset(&fix, 0, sizeof(fix));
+
+    while (__atomic_load_n(&g_stop, __ATOMIC_ACQUIRE) == 0U)
+    {
+        n++;
+        fix.lat.fracDegs    = n;
+        fix.lng.fracDegs    = n;
+        fix.time.sec        = (uint8_t)(n % 60U);
+
+        if (g_useMutex != 0U)
+        {
+            (void) pthread_mutex_lock(&g_mutexStore.lock);
+            g_mutexStore.fix = fix;
+            g_mutexStore.version++;
+            (void) pthread_mutex_unlock(&g_mutexStore.lock);
+        }
+        else
+        {
+            NEO6M_FixStore_Publish(&g_store, &fix);
+        }
+
+        if (g_periodUs > 0U)
+        {
+            (void) nanosleep(&period, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+  * @brief      Reader thread: reads the current position as fast as it can.
+  * @param[in]  pArg                Pointer to reader
+  * @retval     NULL
+  */
+static void* Bench_ReaderLoop(void *pArg)
+{
+    Bench_Reader_t *pReader = (Bench_Reader_t*)pArg;
+    GPRMC_Info_t    fix;
+    uint64_t        reads = 0U;
+    uint64_t        torn  = 0U;
+
+    while (__atomic_load_n(&g_stop, __ATOMIC_RELAXED) == 0U)
+    {
+        if (g_useMutex != 0U)
+        {
+            (void) pthread_mutex_lock(&g_mutexStore.lock);
+            fix = g_mutexStore.fix;
+            (void) pthread_mutex_unlock(&g_mutexStore.lock);
+            reads++;
+        }
+        else if (NEO6M_FixStore_Read(&g_store, &fix, NULL) == NEO6M_OK)
+        {
+            reads++;
+        }
+        else
+        {
+            torn++;
+        }
+
+        /* Keep the copy alive */
+        __asm__ __volatile__("" : : "r"(&fix) : "memory");
+    }
+
+    pReader->reads  = reads;
+    pReader->torn   = torn;
+
+    return NULL;
+}
+
+/**
+  * @brief      This function returns the reader count of the next row. Rows double,
+  *             and a last one runs at maxReaders when it is not a power of two.
+  * @param[in]  readers             Reader count of the current row
+  * @param[in]  maxReaders          Reader count of the last row
+  * @retval     Reader count of the next row, 0 after the last one
+  */
+static uint32_t Bench_NextReaders(const uint32_t readers, const uint32_t maxReaders)
+{
+    uint32_t next = readers * 2U;
+
+    if (readers == maxReaders)
+    {
+        next = 0U;
+    }
+    else if (next > maxReaders)
+    {
+        next = maxReaders;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return next;
+}
+
+/**
+  * @brief      This function measures one design with the given number of readers.
+  * @param[in]  readers             Reader threads
+  * @param[in]  useMutex            1 for the mutex, 0 for the store
+  * @param[in]  ms                  Measurement time
+  * @param[out] pTorn               Pointer to torn reads per second
+  * @retval     Complete reads per second, all readers together
+  */
+static double Bench_Run(const uint32_t readers, const uint8_t useMutex, const uint32_t ms, double *pTorn)
+{
+    struct timespec duration = {(time_t)(ms / 1000U), (long)(ms % 1000U) * 1000000L};
+    pthread_t       writer;
+    GPRMC_Info_t    fix;
+    uint64_t        reads = 0U;
+    uint64_t        torn  = 0U;
+    double          start;
+    double          elapsed;
+    uint32_t        index;
+
+    g_useMutex  = useMutex;
+    g_stop      = 0U;
+    (void) memset(&fix, 0, sizeof(fix));
+    NEO6M_FixStore_Init(&g_store);
+    NEO6M_FixStore_Publish(&g_store, &fix);
+
+    /* The writer gets core 0, the readers the cores after it */
+    (void) pthread_create(&writer, NULL, Bench_Writer, NULL);
+    Bench_Pin(writer, 0U);
+
+    start = Bench_Now();
+
+    for (index = 0U; index < readers; index++)
+    {
+        (void) pthread_create(&g_readers[index].thread, NULL, Bench_ReaderLoop, &g_readers[index]);
+        Bench_Pin(g_readers[index].thread, index + 1U);
+    }
+
+    (void) nanosleep(&duration, NULL);
+    __atomic_store_n(&g_stop, 1U, __ATOMIC_RELEASE);
+
+    for (index = 0U; index < readers; index++)
+    {
+        (void) pthread_join(g_readers[index].thread, NULL);
+        reads  += g_readers[index].reads;
+        torn   += g_readers[index].torn;
+    }
+
+    elapsed = Bench_Now() - start;
+
+    (void) pthread_join(writer, NULL);
+
+    *pTorn = (double)torn / elapsed;
+
+    return (double)reads / elapsed;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      Benchmark entry: Neo6M_FixStore_Bench [max readers] [ms per row] [writer period us]
+  * @retval     0
+  */
+int main(int argc, char **argv)
+{
+    uint32_t maxReaders;
+    uint32_t ms;
+    uint32_t readers;
+    double   seqlock;
+    double   mutex;
+    double   base = 0.0;
+    double   torn;
+    double   unused;
+
+    g_cores     = sysconf(_SC_NPROCESSORS_ONLN);
+    maxReaders  = (argc > 1) ? (uint32_t)atoi(argv[1]) : (uint32_t)((g_cores > 1) ? (g_cores - 1) : 1);
+    ms          = (argc > 2) ? (uint32_t)atoi(argv[2]) : BENCH_DEFAULT_MS;
+    g_periodUs  = (argc > 3) ? (uint32_t)atoi(argv[3]) : BENCH_DEFAULT_PERIOD_US;
+
+    if ((maxReaders == 0U) || (maxReaders > BENCH_MAX_READERS))
+    {
+        maxReaders = BENCH_MAX_READERS;
+    }
+
+    (void) printf("cores %ld, writer period %u us, %u ms per row\n", g_cores, g_periodUs, ms);
+    (void) printf("%8s %16s %10s %16s %12s\n", "readers", "seqlock reads/s", "scaling", "mutex reads/s", "torn/s");
+
+    for (readers = 1U; readers != 0U; readers = Bench_NextReaders(readers, maxReaders))
+    {
+        seqlock = Bench_Run(readers, 0U, ms, &torn);
+        mutex   = Bench_Run(readers, 1U, ms, &unused);
+
+        if (readers == 1U)
+        {
+            base = seqlock;
+        }
+
+        (void) printf("%8u %16.0f %9.2fx %16.0f %12.1f\n", readers, seqlock,
+                      (base > 0.0) ? (seqlock / base) : 0.0, mutex, torn);
+    }
+
+    return 0;
+}
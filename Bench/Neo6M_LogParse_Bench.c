@@ -0,0 +1,133 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_LogParse_Bench.c
+  * @author  Huy Nguyen
+  * @brief   Log parser scaling benchmark: serial path against the work-stealing pool
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Neo6M_LogParse.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_DEFAULT_MEGABYTES             64U     /* Size of the synthetic log */
+
+/* Private variables ---------------------------------------------------------*/
+static char const* const g_epoch =
+    "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n"
+    "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n"
+    "$GPGGA,083559.00,4717.11437,N,00833.91522,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n"
+    "$GPGSA,A,3,04,05,09,12,,,,,,,,,2.56,1.27,2.22*0D\r\n"
+    "$GPGSV,2,1,05,04,,,44,08,,,41,09,,,37,21,,,26*7C\r\n";
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function returns a monotonic time in seconds.
+  * @retval     Seconds
+  */
+static double Bench_Now(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      Benchmark entry: Neo6M_LogParse_Bench [megabytes]
+  * @retval     0 if every parallel run matched the serial one, 1 if not
+  */
+int main(int argc, char **argv)
+{
+    LogParse_Result_t serial;
+    LogParse_Result_t parallel;
+    long     cores  = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t size   = (uint64_t)((argc > 1) ? atoi(argv[1]) : BENCH_DEFAULT_MEGABYTES) << 20;
+    uint64_t epochLen = strlen(g_epoch);
+    uint64_t used   = 0U;
+    uint16_t threads;
+    double   start;
+    double   serialTime;
+    double   elapsed;
+    char    *log;
+    int      result = 0;
+
+    log = (char*) malloc(size);
+
+    if (log == NULL)
+    {
+        return 1;
+    }
+
+    while ((used + epochLen) <= size)
+    {
+        (void) memcpy(&log[used], g_epoch, epochLen);
+        used += epochLen;
+    }
+
+    start = Bench_Now();
+    (void) NEO6M_LogParse_Buffer(log, used, &serial);
+    serialTime = Bench_Now() - start;
+
+    (void) printf("log %lu bytes, %lu sentences decoded, cores %ld\n", used, serial.count, cores);
+    (void) printf("%8s %12s %10s\n", "threads", "MB/s", "speedup");
+    (void) printf("%8s %12.1f %9.2fx\n", "serial", ((double)used / 1e6) / serialTime, 1.0);
+
+    for (threads = 1U; (threads <= LOGPARSE_MAX_THREADS) && (threads <= (uint16_t)cores); threads *= 2U)
+    {
+        start = Bench_Now();
+        (void) NEO6M_LogParse_BufferParallel(log, used, threads, 0U, &parallel);
+        elapsed = Bench_Now() - start;
+
+        if ((parallel.count != serial.count)
+            || (memcmp(parallel.records, serial.records, serial.count * sizeof(LogParse_Record_t)) != 0))
+        {
+            (void) printf("threads %u: output differs from the serial path\n", threads);
+            result = 1;
+        }
+
+        (void) printf("%8u %12.1f %9.2fx\n", threads, ((double)used / 1e6) / elapsed, serialTime / elapsed);
+
+        NEO6M_LogParse_Free(&parallel);
+    }
+
+    NEO6M_LogParse_Free(&serial);
+    free(log);
+
+    return result;
+}
@@ -0,0 +1,342 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Parser_Bench.c
+  * @author  Huy Nguyen
+  * @brief   Parser throughput benchmark over the sentence corpus
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Neo6M_GPSNeo6M.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_DEFAULT_CORPUS                "Bench/Corpus/Neo6M_Corpus.nmea"
+#define BENCH_DEFAULT_MIN_MS                300U    /* Shortest measurement per row */
+#define BENCH_MAX_LINES                     1024U   /* Lines kept from the corpus */
+#define BENCH_MAX_LINE_LENGTH               256U    /* Longest line kept from the corpus */
+#define BENCH_CATEGORIES                    8U      /* Rows of the report */
+#define BENCH_ENTRIES                       6U      /* Parser entry points measured */
+
+/**
+ * @brief Data structure that contains one corpus line
+*/
+typedef struct
+{
+    char        text[BENCH_MAX_LINE_LENGTH + 1U];   /* NUL terminated line */
+    uint32_t    len;                                /* Bytes without NUL */
+    uint8_t     category;                           /* Index in g_categories */
+} Bench_Line_t;
+
+/**
+ * @brief Data structure that contains one measurement
+*/
+typedef struct
+{
+    double      nsPerSentence;          /* Wall time per sentence */
+    double      sentencesPerSec;        /* Throughput */
+    double      cyclesPerByte;          /* TSC cycles per input byte, 0 when not available */
+    double      allocsPerSentence;      /* malloc, calloc and realloc calls per sentence */
+} Bench_Result_t;
+
+/* Private variables ---------------------------------------------------------*/
+static char const* const g_entries[BENCH_ENTRIES] =
+{
+    "Api", "ParseSentence", "Fields(pos)", "Lazy(drop)", "Lazy(pos)", "InPlace"
+};
+
+static char const* const g_categories[BENCH_CATEGORIES] =
+{
+    "GPRMC", "GPVTG", "GPGGA", "GPGSA", "GPGSV", "other", "malformed", "all"
+};
+
+static Bench_Line_t     g_lines[BENCH_MAX_LINES];
+static uint32_t         g_lineCount;
+static uint64_t         g_allocs;               /* Counted by the --wrap hooks below */
+
+/* Allocation hooks, active because the benchmark is linked with -Wl,--wrap=<name> */
+extern void* __real_malloc(size_t size);
+extern void* __real_calloc(size_t count, size_t size);
+extern void* __real_realloc(void *ptr, size_t size);
+
+void* __wrap_malloc(size_t size)
+{
+    g_allocs++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    g_allocs++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void *ptr, size_t size)
+{
+    g_allocs++;
+    return __real_realloc(ptr, size);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function returns a monotonic time in nanoseconds.
+  * @retval     Nanoseconds
+  */
+static uint64_t Bench_NowNs(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/**
+  * @brief      This function reads the time stamp counter.
+  * @retval     Cycles, 0 when the target has no TSC
+  */
+static uint64_t Bench_Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0U;
+#endif
+}
+
+/**
+  * @brief      This function sorts a corpus line into a report row.
+  * @param[in]  pLine               Pointer to line
+  * @retval     Category index
+  */
+static uint8_t Bench_Categorize(Bench_Line_t const* pLine)
+{
+    uint8_t category = 6U;  /* malformed */
+    uint8_t index;
+
+    if ((pLine->len >= 2U)
+        && (pLine->text[pLine->len - 2U] == '\r')
+        && (NEO6M_GPSNeo6_VerifyChecksum(pLine->text) == NEO6M_OK)
+    )
+    {
+        category = 5U;      /* other */
+
+        for (index = 0U; index < 5U; index++)
+        {
+            if (strncmp(&pLine->text[1], g_categories[index], 5U) == 0)
+            {
+                category = index;
+            }
+        }
+    }
+
+    return category;
+}
+
+/**
+  * @brief      This function loads the corpus, one entry per '\n' terminated line.
+  * @param[in]  path                Corpus path
+  * @retval     NEO6M_OK if at least one line was loaded, NEO6M_NOK if not
+  */
+static CheckStatus_t Bench_Load(char const* path)
+{
+    char    buffer[BENCH_MAX_LINE_LENGTH + 1U];
+    FILE   *pFile = fopen(path, "rb");
+
+    if (pFile != NULL)
+    {
+        while ((g_lineCount < BENCH_MAX_LINES) && (fgets(buffer, sizeof(buffer), pFile) != NULL))
+        {
+            (void) strcpy(g_lines[g_lineCount].text, buffer);
+            g_lines[g_lineCount].len        = (uint32_t)strlen(buffer);
+            g_lines[g_lineCount].category   = Bench_Categorize(&g_lines[g_lineCount]);
+            g_lineCount++;
+        }
+
+        (void) fclose(pFile);
+    }
+
+    return (g_lineCount > 0U) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      This function runs one parser entry over the lines of a category until
+  *             minMs elapsed.
+  * @param[in]  category            Category index, "all" takes every line
+  * @param[in]  entry               Index in g_entries
+  * @param[in]  minMs               Shortest measurement
+  * @param[out] pResult             Pointer to measurement
+  * @retval     NEO6M_OK if the category has lines, NEO6M_NOK if not
+  */
+static CheckStatus_t Bench_Measure(const uint8_t category, const uint8_t entry, const uint32_t minMs, Bench_Result_t *pResult)
+{
+    GPS_Sentence_t sentence;
+    NEO6M_Ctx_t ctx;
+    GPS_Lazy_t lazy;
+    GPS_InPlace_t tok;
+    char line[BENCH_MAX_LINE_LENGTH + 1U];
+    uint32_t selected[BENCH_MAX_LINES];
+    uint32_t count = 0U;
+    uint64_t bytes = 0U;
+    uint64_t sentences = 0U;
+    uint64_t rounds = 1U;
+    uint64_t round;
+    uint64_t startNs;
+    uint64_t elapsedNs = 0U;
+    uint64_t startCycles;
+    uint64_t cycles = 0U;
+    uint64_t allocs = 0U;
+    uint32_t index;
+
+    for (index = 0U; index < g_lineCount; index++)
+    {
+        if ((category == (BENCH_CATEGORIES - 1U)) || (g_lines[index].category == category))
+        {
+            selected[count++] = index;
+        }
+    }
+
+    if (count == 0U)
+    {
+        return NEO6M_NOK;
+    }
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    /* Warm up, then double the rounds until the run is long enough to trust */
+    while (elapsedNs < ((uint64_t)minMs * 1000000ULL))
+    {
+        g_allocs    = 0U;
+        bytes       = 0U;
+        startNs     = Bench_NowNs();
+        startCycles = Bench_Cycles();
+
+        for (round = 0U; round < rounds; round++)
+        {
+            for (index = 0U; index < count; index++)
+            {
+                if (entry == 0U)
+                {
+                    (void) NEO6M_GPSNeo6_Api(g_lines[selected[index]].text, &sentence.info);
+                }
+                else if (entry == 1U)
+                {
+                    (void) NEO6M_GPSNeo6_ParseSentence(g_lines[selected[index]].text, &sentence);
+                }
+                else if (entry == 2U)
+                {
+                    /* Geofence path: position only */
+                    (void) NEO6M_GPSNeo6_ParseSentenceFields(&ctx, g_lines[selected[index]].text, &sentence, NEO6M_FIELD_POSITION);
+                }
+                else if (entry == 3U)
+                {
+                    /* Sentence dropped after the type and validity check */
+                    (void) NEO6M_GPSNeo6_LazyParse(&lazy, g_lines[selected[index]].text);
+                }
+                else if (entry == 4U)
+                {
+                    if (NEO6M_GPSNeo6_LazyParse(&lazy, g_lines[selected[index]].text) == NEO6M_OK)
+                    {
+                        (void) NEO6M_GPSNeo6_LazyGet(&lazy, NEO6M_FIELD_POSITION);
+                    }
+                }
+                else
+                {
+                    /* The copy stands in for the receive buffer the line arrives in */
+                    (void) memcpy(line, g_lines[selected[index]].text, g_lines[selected[index]].len + 1U);
+                    (void) NEO6M_GPSNeo6_ParseInPlace(&tok, line, &sentence, NEO6M_FIELD_ALL);
+                }
+
+                bytes += g_lines[selected[index]].len;
+            }
+        }
+
+        cycles      = Bench_Cycles() - startCycles;
+        elapsedNs   = Bench_NowNs() - startNs;
+        allocs      = g_allocs;
+        sentences   = rounds * count;
+        rounds     *= 2U;
+    }
+
+    pResult->nsPerSentence      = (double)elapsedNs / (double)sentences;
+    pResult->sentencesPerSec    = ((double)sentences * 1e9) / (double)elapsedNs;
+    pResult->cyclesPerByte      = (double)cycles / (double)bytes;
+    pResult->allocsPerSentence  = (double)allocs / (double)sentences;
+
+    return NEO6M_OK;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      Benchmark entry: Neo6M_Parser_Bench [corpus] [min ms per row]
+  * @retval     0 on success, 1 if the corpus could not be read
+  */
+int main(int argc, char **argv)
+{
+    char const*     path  = (argc > 1) ? argv[1] : BENCH_DEFAULT_CORPUS;
+    uint32_t        minMs = (argc > 2) ? (uint32_t)atoi(argv[2]) : BENCH_DEFAULT_MIN_MS;
+    Bench_Result_t  result;
+    uint8_t         category;
+    uint8_t         entry;
+
+    if (Bench_Load(path) != NEO6M_OK)
+    {
+        (void) fprintf(stderr, "cannot read corpus %s\n", path);
+        return 1;
+    }
+
+    (void) printf("corpus %s, %u lines\n", path, g_lineCount);
+    (void) printf("%-14s %-10s %12s %14s %12s %14s\n",
+                  "entry", "sentences", "ns/sentence", "sentences/s", "cycles/byte", "allocs/sentence");
+
+    for (entry = 0U; entry < BENCH_ENTRIES; entry++)
+    {
+        for (category = 0U; category < BENCH_CATEGORIES; category++)
+        {
+            if (Bench_Measure(category, entry, minMs, &result) == NEO6M_OK)
+            {
+                (void) printf("%-14s %-10s %12.1f %14.0f %12.2f %14.2f\n",
+                              g_entries[entry], g_categories[category],
+                              result.nsPerSentence, result.sentencesPerSec,
+                              result.cyclesPerByte, result.allocsPerSentence);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_AidCache.h
+  * @author  Huy Nguyen
+  * @brief   Warm-start cache of UBX AID messages for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_AIDCACHE_H
+#define NEO6M_AIDCACHE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+#include "Neo6M_UBX.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define UBX_ID_AID_INI                      0x01U   /* Initial position and time */
+#define UBX_ID_AID_ALM                      0x30U   /* Almanac of one SV */
+#define UBX_ID_AID_EPH                      0x31U   /* Ephemeris of one SV */
+
+#define AIDCACHE_MAX_SV                     32U     /* GPS SVs 1..32 */
+#define AIDCACHE_INI_LENGTH                 48U     /* AID-INI payload length */
+#define AIDCACHE_ALM_LENGTH                 40U     /* AID-ALM payload length with almanac */
+#define AIDCACHE_EPH_LENGTH                 104U    /* AID-EPH payload length with ephemeris */
+#define AIDCACHE_EPH_MAX_AGE_S              14400U  /* Ephemeris validity; older ones are not replayed */
+
+/* Largest serialized cache: header, INI, every almanac, every ephemeris and checksum */
+#define AIDCACHE_MAX_SERIALIZED_LENGTH      (18U + AIDCACHE_INI_LENGTH \
+                                            + (AIDCACHE_MAX_SV * AIDCACHE_ALM_LENGTH) \
+                                            + (AIDCACHE_MAX_SV * AIDCACHE_EPH_LENGTH) + 2U)
+
+/**
+ * @brief Data structure that contains the captured assistance data. Only payloads that
+ *        actually carry data are kept; the "no data" short replies are ignored.
+*/
+typedef struct
+{
+    uint8_t  ini[AIDCACHE_INI_LENGTH];                      /* AID-INI payload */
+    uint8_t  alm[AIDCACHE_MAX_SV][AIDCACHE_ALM_LENGTH];     /* AID-ALM payloads by SV */
+    uint8_t  eph[AIDCACHE_MAX_SV][AIDCACHE_EPH_LENGTH];     /* AID-EPH payloads by SV */
+    uint32_t almMask;                                       /* Bit n set: almanac of SV n+1 present */
+    uint32_t ephMask;                                       /* Bit n set: ephemeris of SV n+1 present */
+    uint32_t captureS;                                      /* Unix time of the capture, 0 if unknown */
+    uint8_t  hasIni;                                        /* AID-INI present */
+} AidCache_t;
+
+extern void NEO6M_AidCache_Init(AidCache_t *pCache);
+extern void NEO6M_AidCache_RequestAll(NEO6M_WriteFn_t writeFn, void *pUser);
+extern CheckStatus_t NEO6M_AidCache_OnFrame(AidCache_t *pCache, UBX_Frame_t const* pFrame);
+extern void NEO6M_AidCache_Stamp(AidCache_t *pCache, const uint32_t nowS);
+extern uint16_t NEO6M_AidCache_Replay(AidCache_t const* pCache, const uint32_t nowS, NEO6M_WriteFn_t writeFn, void *pUser);
+extern uint32_t NEO6M_AidCache_Serialize(AidCache_t const* pCache, uint8_t *outBuf, const uint32_t outSize);
+extern CheckStatus_t NEO6M_AidCache_Deserialize(AidCache_t *pCache, uint8_t const* data, const uint32_t len);
+extern CheckStatus_t NEO6M_AidCache_Save(AidCache_t const* pCache, char const* const path);
+extern CheckStatus_t NEO6M_AidCache_Load(AidCache_t *pCache, char const* const path);
+
+#endif /* NEO6M_AIDCACHE_H */
@@ -0,0 +1,87 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_BaudDetect.h
+  * @author  Huy Nguyen
+  * @brief   Baud rate and protocol auto-detection for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_BAUDDETECT_H
+#define NEO6M_BAUDDETECT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+#include "Neo6M_Stream.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define BAUDDETECT_MAX_CANDIDATES           8U      /* Max candidate baud rates */
+#define BAUDDETECT_LOCK_HITS                2U      /* Valid messages needed to lock */
+#define BAUDDETECT_MAX_ERROR_PERCENT        5U      /* Max framing errors per 100 bytes when locked */
+
+#define BAUDDETECT_PROTO_NONE               0x00U   /* No protocol recognised */
+#define BAUDDETECT_PROTO_NMEA               0x01U   /* NMEA with valid checksums seen */
+#define BAUDDETECT_PROTO_UBX                0x02U   /* UBX with valid checksums seen */
+
+/**
+ * @brief Data structure that contains the evidence collected for one candidate baud rate
+*/
+typedef struct
+{
+    uint32_t baud;              /* Candidate baud rate */
+    uint32_t bytes;             /* Bytes captured */
+    uint32_t framingErrors;     /* Framing errors reported by the UART */
+    uint16_t nmeaHits;          /* NMEA lines with a valid checksum */
+    uint16_t nmeaMisses;        /* NMEA lines with a bad or missing checksum */
+    uint16_t ubxHits;           /* UBX frames with a valid checksum */
+    uint16_t ubxSyncs;          /* UBX sync pairs, valid frame or not */
+    int32_t  score;             /* Weighted score, higher is better */
+    uint8_t  protocols;         /* BAUDDETECT_PROTO_* bits */
+} BaudDetect_Score_t;
+
+/**
+ * @brief Data structure that contains the detector context
+*/
+typedef struct
+{
+    BaudDetect_Score_t  scores[BAUDDETECT_MAX_CANDIDATES];  /* Evidence per candidate */
+    Stream_Ctx_t        stream;                             /* Framer for the current candidate */
+    uint8_t             count;                              /* Number of candidates */
+    uint8_t             current;                            /* Candidate fed last */
+    uint8_t             locked;                             /* Index of locked candidate + 1, 0 if none */
+} BaudDetect_Ctx_t;
+
+extern void NEO6M_BaudDetect_Init(BaudDetect_Ctx_t *pCtx, uint32_t const* bauds, const uint8_t count);
+extern CheckStatus_t NEO6M_BaudDetect_Feed(BaudDetect_Ctx_t *pCtx, const uint8_t candidate,
+                                           uint8_t const* data, const uint32_t len, const uint32_t framingErrors);
+extern CheckStatus_t NEO6M_BaudDetect_GetBest(BaudDetect_Ctx_t const* pCtx, uint32_t *pBaud, uint8_t *pProtocols);
+extern void NEO6M_BaudDetect_Score(uint8_t const* data, const uint32_t len, const uint32_t framingErrors,
+                                   BaudDetect_Score_t *pScore);
+
+#endif /* NEO6M_BAUDDETECT_H */
@@ -0,0 +1,85 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Config.h
+  * @author  Huy Nguyen
+  * @brief   Compile-time configuration for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_CONFIG_H
+#define NEO6M_CONFIG_H
+
+/*
+ * Every option can be overridden from the compiler command line, e.g.
+ * -DNEO6M_CFG_ENABLE_GPVTG=0. A disabled decoder, its dispatch entry and the
+ * converters only it uses are not compiled at all; its sentences are then
+ * reported as SENTENCE_UNKNOWN. "make size-report" shows the code size of a few
+ * configurations.
+ */
+
+/* Exported defines ----------------------------------------------------------*/
+#ifndef NEO6M_CFG_ENABLE_GPRMC
+#define NEO6M_CFG_ENABLE_GPRMC              1       /* Decode RMC, Recommended Minimum */
+#endif
+
+#ifndef NEO6M_CFG_ENABLE_GPVTG
+#define NEO6M_CFG_ENABLE_GPVTG              1       /* Decode VTG, Course over ground and Ground speed */
+#endif
+
+#ifndef NEO6M_CFG_ENABLE_GPGGA
+#define NEO6M_CFG_ENABLE_GPGGA              1       /* Decode GGA, Fix data */
+#endif
+
+#ifndef NEO6M_CFG_ENABLE_GPGSA
+#define NEO6M_CFG_ENABLE_GPGSA              1       /* Decode GSA, DOP and active satellites */
+#endif
+
+#ifndef NEO6M_CFG_FIELD_CACHE
+#define NEO6M_CFG_FIELD_CACHE               1       /* Reuse the date and coordinates of the previous
+                                                       sentence of a context when their text is unchanged */
+#endif
+
+#ifndef NEO6M_CFG_STATIC_POOL
+#define NEO6M_CFG_STATIC_POOL               0       /* 1 to take the list of the eager parse from a
+                                                       pool inside each context instead of malloc */
+#endif
+
+#ifndef NEO6M_CFG_STREAM_TIMESTAMP
+#define NEO6M_CFG_STREAM_TIMESTAMP          1       /* Stamp the messages of NEO6M_Stream_Feed with the
+                                                       CLOCK_MONOTONIC time of their first and last byte;
+                                                       0 on targets without clock_gettime */
+#endif
+
+#ifndef NEO6M_STATS_ENABLE
+#define NEO6M_STATS_ENABLE                  0       /* 1 to count and time every decode */
+#endif
+
+#endif /* NEO6M_CONFIG_H */
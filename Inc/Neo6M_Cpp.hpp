@@ -0,0 +1,526 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Cpp.hpp
+  * @author  Huy Nguyen
+  * @brief   Header-only C++17 front end with compile-time sentence dispatch for GPS Neo 6M
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_CPP_HPP
+#define NEO6M_CPP_HPP
+
+#if (__cplusplus < 201703L)
+#error "Neo6M_Cpp.hpp needs C++17"
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+extern "C" {
+    #include "Neo6M_GPSNeo6M.h"
+}
+
+/*
+ * Usage:
+ *
+ *     Neo6m::Parser<Neo6m::Rmc, Neo6m::Gga> parser;
+ *     auto result = parser.Parse(line);
+ *
+ *     if (auto const* pRmc = std::get_if<GPRMC_Info_t>(&result)) { ... }
+ *
+ * Only the listed sentence types are compiled in; their header compares, decoders
+ * and converters are all inlined into Parse. Results match the C entry points
+ * field for field: the same converters, rewritten over std::string_view.
+ */
+namespace Neo6m
+{
+
+/* Exported defines ----------------------------------------------------------*/
+constexpr std::size_t MaxLineLength = 100U;     /* Same limit as the C tokenizer */
+
+/**
+ * @brief Comma separated fields of one line, kept as offsets into the caller's buffer
+*/
+class Fields
+{
+public:
+    /**
+      * @brief      Splits a line. The last field ends at '\r' or at the end of the view.
+      * @param[in]  line                Line starting with the '$' header
+      * @retval     true if the line was split, false on an embedded NUL, a non-printable byte or an overlong line
+      */
+    bool Split(std::string_view line)
+    {
+        std::size_t index;
+        std::size_t begin   = 0U;
+        std::size_t length  = (line.size() < MaxLineLength) ? line.size() : MaxLineLength;
+        bool        ok      = (line.size() < MaxLineLength);
+
+        m_line      = line;
+        m_count     = 0U;
+        m_present   = 0U;
+
+        for (index = 0U; index < length; index++)
+        {
+            char const c = line[index];
+
+            if (c == '\r')
+            {
+                ok = true;
+                break;
+            }
+            else if ((c < ' ') || (c > '~'))
+            {
+                /* Embedded NUL or line noise */
+                ok = false;
+                break;
+            }
+            else if (c == ',')
+            {
+                Add(begin, index);
+                begin = index + 1U;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+
+        if (ok)
+        {
+            Add(begin, index);
+        }
+
+        return ok;
+    }
+
+    /**
+      * @brief      Returns a field, or an empty view for fields missing from the line.
+      * @param[in]  index               Field index, 0 is the header
+      * @retval     Field text
+      */
+    std::string_view operator[](std::size_t index) const
+    {
+        return (index < m_count) ? m_line.substr(m_begin[index], m_end[index] - m_begin[index]) : std::string_view();
+    }
+
+    /**
+      * @brief      Returns the number of fields.
+      * @retval     Field count
+      */
+    std::size_t Count() const
+    {
+        return m_count;
+    }
+
+    /**
+      * @brief      Returns the NEO6M_PRESENT bits of the non-empty fields, as the C tokenizer
+      *             fills them in.
+      * @retval     Presence mask
+      */
+    uint32_t Present() const
+    {
+        return m_present;
+    }
+
+private:
+    void Add(std::size_t begin, std::size_t end)
+    {
+        m_begin[m_count]    = static_cast<uint8_t>(begin);
+        m_end[m_count]      = static_cast<uint8_t>(end);
+
+        /* A field holding only the "*hh" checksum is empty */
+        if ((end > begin) && (m_line[begin] != '*') && (m_count < 32U))
+        {
+            m_present |= NEO6M_PRESENT(m_count);
+        }
+
+        m_count++;
+    }
+
+    std::string_view                    m_line;
+    std::size_t                         m_count = 0U;
+    uint32_t                            m_present = 0U;
+    std::array<uint8_t, MaxLineLength>  m_begin {};
+    std::array<uint8_t, MaxLineLength>  m_end {};
+};
+
+namespace Detail
+{
+
+/**
+  * @brief      Reads character index of a field, '\0' past its end like the C strings.
+  */
+constexpr char At(std::string_view str, std::size_t index)
+{
+    return (index < str.size()) ? str[index] : '\0';
+}
+
+constexpr bool IsDigit(char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+/**
+  * @brief      Mirrors NEO6M_ConvertStr2Uint32: skips '.', stops at '*', 0 on other characters.
+  */
+constexpr uint32_t ConvertStr2Uint32(std::string_view str)
+{
+    uint32_t number = 0U;
+
+    for (char const c : str)
+    {
+        if (c == '.')
+        {
+            continue;
+        }
+
+        if (c == '*')
+        {
+            break;
+        }
+
+        if (!IsDigit(c))
+        {
+            number = 0U;
+            break;
+        }
+
+        number = (number * 10U) + static_cast<uint32_t>(c - '0');
+    }
+
+    return number;
+}
+
+/**
+  * @brief      Mirrors NEO6M_ConvertStr2Int32.
+  */
+constexpr int32_t ConvertStr2Int32(std::string_view str)
+{
+    return (At(str, 0U) == '-') ? -static_cast<int32_t>(ConvertStr2Uint32(str.substr(1U)))
+                                : static_cast<int32_t>(ConvertStr2Uint32(str));
+}
+
+/**
+  * @brief      Mirrors NEO6M_ConvertStr2TimeFormat and NEO6M_ConvertStr2DateFormat:
+  *             three two-digit numbers, all 255 if one of the six characters is not a digit.
+  */
+constexpr bool ConvertStr2Pairs(std::string_view str, uint8_t &first, uint8_t &second, uint8_t &third)
+{
+    for (std::size_t index = 0U; index < 6U; index++)
+    {
+        if (!IsDigit(At(str, index)))
+        {
+            first = second = third = 255U;
+            return false;
+        }
+    }
+
+    first   = static_cast<uint8_t>(((str[0] - '0') * 10) + (str[1] - '0'));
+    second  = static_cast<uint8_t>(((str[2] - '0') * 10) + (str[3] - '0'));
+    third   = static_cast<uint8_t>(((str[4] - '0') * 10) + (str[5] - '0'));
+
+    return true;
+}
+
+inline Time_Info_t ConvertStr2TimeFormat(std::string_view str)
+{
+    Time_Info_t time {};
+
+    (void) ConvertStr2Pairs(str, time.hr, time.min, time.sec);
+
+    return time;
+}
+
+inline Date_Info_t ConvertStr2DateFormat(std::string_view str)
+{
+    Date_Info_t date {};
+
+    (void) ConvertStr2Pairs(str, date.day, date.month, date.year);
+
+    return date;
+}
+
+/**
+  * @brief      Mirrors NEO6M_ConvertStr2Coord.
+  */
+inline Coord_Info_t ConvertStr2Coord(std::string_view str, std::string_view pole)
+{
+    Coord_Info_t    coord {};
+    char const      p           = At(pole, 0U);
+    std::size_t     degDigits   = ((p == 'N') || (p == 'S')) ? 2U : 3U;
+    uint32_t        fracDegs    = 0U;
+
+    if ((p != 'N') && (p != 'E') && (p != 'W') && (p != 'S'))
+    {
+        return Coord_Info_t {255U, 255U, 'I'};
+    }
+
+    for (std::size_t index = 0U; index < str.size(); index++)
+    {
+        char const c = str[index];
+
+        if (c == '.')
+        {
+            continue;
+        }
+
+        if (!IsDigit(c))
+        {
+            return Coord_Info_t {255U, 255U, 'I'};
+        }
+
+        if (index < degDigits)
+        {
+            coord.degs = static_cast<uint8_t>((coord.degs * 10U) + static_cast<uint8_t>(c - '0'));
+        }
+        else
+        {
+            fracDegs = (fracDegs * 10U) + static_cast<uint32_t>(c - '0');
+        }
+    }
+
+    coord.fracDegs  = fracDegs / 60U;
+    coord.pole      = p;
+
+    return coord;
+}
+
+}   /* namespace Detail */
+
+/**
+ * @brief Sentence types. Each one names its header, its C result struct and its decoder.
+*/
+struct Rmc
+{
+    using Info = GPRMC_Info_t;
+    static constexpr std::string_view header    = "GPRMC";
+    static constexpr SentenceType_t type        = SENTENCE_GPRMC;
+
+    static bool Decode(Fields const& fields, Info &info)
+    {
+        bool ok = (Detail::At(fields[2], 0U) == 'A');
+
+        info = Info {};
+        info.present = fields.Present();
+
+        if (ok)
+        {
+            info.time   = Detail::ConvertStr2TimeFormat(fields[1]);
+            info.date   = Detail::ConvertStr2DateFormat(fields[9]);
+            info.lat    = Detail::ConvertStr2Coord(fields[3], fields[4]);
+            info.lng    = Detail::ConvertStr2Coord(fields[5], fields[6]);
+        }
+
+        return ok;
+    }
+};
+
+struct Vtg
+{
+    using Info = GPVTG_Info_t;
+    static constexpr std::string_view header    = "GPVTG";
+    static constexpr SentenceType_t type        = SENTENCE_GPVTG;
+
+    static bool Decode(Fields const& fields, Info &info)
+    {
+        bool ok = (Detail::At(fields[9], 0U) == 'A');
+
+        info = Info {};
+        info.present = fields.Present();
+
+        if (ok)
+        {
+            info.cogt   = Detail::ConvertStr2Uint32(fields[1]);
+            info.sknots = Detail::ConvertStr2Uint32(fields[5]);
+            info.skph   = Detail::ConvertStr2Uint32(fields[7]);
+        }
+
+        return ok;
+    }
+};
+
+struct Gga
+{
+    using Info = GPGGA_Info_t;
+    static constexpr std::string_view header    = "GPGGA";
+    static constexpr SentenceType_t type        = SENTENCE_GPGGA;
+
+    static bool Decode(Fields const& fields, Info &info)
+    {
+        char const  quality = Detail::At(fields[6], 0U);
+        bool        ok      = (quality > '0') && (quality <= '9');
+
+        info = Info {};
+        info.present = fields.Present();
+
+        if (ok)
+        {
+            info.time       = Detail::ConvertStr2TimeFormat(fields[1]);
+            info.lat        = Detail::ConvertStr2Coord(fields[2], fields[3]);
+            info.lng        = Detail::ConvertStr2Coord(fields[4], fields[5]);
+            info.quality    = static_cast<uint8_t>(quality - '0');
+            info.numSats    = static_cast<uint8_t>(Detail::ConvertStr2Uint32(fields[7]));
+            info.hdop       = Detail::ConvertStr2Uint32(fields[8]);
+            info.alt        = Detail::ConvertStr2Int32(fields[9]);
+        }
+
+        return ok;
+    }
+};
+
+struct Gsa
+{
+    using Info = GPGSA_Info_t;
+    static constexpr std::string_view header    = "GPGSA";
+    static constexpr SentenceType_t type        = SENTENCE_GPGSA;
+
+    static bool Decode(Fields const& fields, Info &info)
+    {
+        char const  fixType = Detail::At(fields[2], 0U);
+        bool        ok      = (fixType == '2') || (fixType == '3');
+
+        info = Info {};
+        info.present = fields.Present();
+
+        if (ok)
+        {
+            info.mode       = Detail::At(fields[1], 0U);
+            info.fixType    = static_cast<uint8_t>(fixType - '0');
+
+            for (std::size_t index = 0U; index < GPGSA_MAX_SV; index++)
+            {
+                info.sv[index] = static_cast<uint8_t>(Detail::ConvertStr2Uint32(fields[3U + index]));
+            }
+
+            info.pdop       = Detail::ConvertStr2Uint32(fields[15]);
+            info.hdop       = Detail::ConvertStr2Uint32(fields[16]);
+            info.vdop       = Detail::ConvertStr2Uint32(fields[17]);
+        }
+
+        return ok;
+    }
+};
+
+/**
+ * @brief Parser for the sentence types Ts. Stateless apart from the field offsets, so
+ *        give each thread its own instance.
+*/
+template <typename... Ts>
+class Parser
+{
+    static_assert(sizeof...(Ts) > 0U, "Parser needs at least one sentence type");
+
+public:
+    /* Decoded sentence, std::monostate if the line was not decoded */
+    using Result = std::variant<std::monostate, typename Ts::Info...>;
+
+    /**
+      * @brief      Decodes one line.
+      * @param[in]  line                Line from '$' up to "\r\n" or the end of the view
+      * @retval     The decoded sentence, std::monostate for an unsupported, malformed or
+      *             invalid line
+      */
+    Result Parse(std::string_view line)
+    {
+        Result result;
+
+        if (m_fields.Split(line))
+        {
+            std::string_view const header = m_fields[0];
+
+            /* An empty header field has nothing after its first character */
+            if (!header.empty())
+            {
+                (void) (TryDecode<Ts>(header.substr(1U), result) || ...);
+            }
+        }
+
+        return result;
+    }
+
+    /**
+      * @brief      Decodes one line and hands the result to visitor, which is called with
+      *             the Info struct of the decoded type only.
+      * @param[in]  line                Line from '$' up to "\r\n" or the end of the view
+      * @param[in]  visitor             Callable accepting every Ts::Info
+      * @retval     true if the visitor was called
+      */
+    template <typename Visitor>
+    bool Visit(std::string_view line, Visitor &&visitor)
+    {
+        Result result = Parse(line);
+        bool   ok     = (result.index() != 0U);
+
+        if (ok)
+        {
+            std::visit([&visitor](auto const& info)
+            {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(info)>, std::monostate>)
+                {
+                    std::forward<Visitor>(visitor)(info);
+                }
+            }, result);
+        }
+
+        return ok;
+    }
+
+private:
+    template <typename T>
+    bool TryDecode(std::string_view header, Result &result)
+    {
+        bool matched = (header == T::header);
+
+        if (matched)
+        {
+            typename T::Info info;
+
+            if (T::Decode(m_fields, info))
+            {
+                result.template emplace<typename T::Info>(info);
+            }
+        }
+
+        return matched;
+    }
+
+    Fields m_fields;
+};
+
+}   /* namespace Neo6m */
+
+#endif /* NEO6M_CPP_HPP */
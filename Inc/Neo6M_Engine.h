@@ -0,0 +1,122 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Engine.h
+  * @author  Huy Nguyen
+  * @brief   Multi-receiver fan-in engine with per-core parser shards for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_ENGINE_H
+#define NEO6M_ENGINE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+
+#include "Neo6M_GPSNeo6M.h"
+#include "Neo6M_Stream.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define ENGINE_MAX_SHARDS                   16U     /* Worker threads */
+#define ENGINE_MAX_RECEIVERS                64U     /* Receiver streams */
+#define ENGINE_QUEUE_LENGTH                 256U    /* Decoded fixes waiting for the consumer */
+#define ENGINE_BATCH_LENGTH                 32U     /* Fixes a shard collects before taking the queue lock */
+#define ENGINE_READ_CHUNK                   512U    /* Bytes read from a receiver at once */
+
+/**
+ * @brief Data structure that contains one decoded sentence and the receiver it came from
+*/
+typedef struct
+{
+    GPS_Sentence_t  sentence;       /* Decoded sentence */
+    Stream_Stamp_t  stamp;          /* Receive times of its first and last byte, NEO6M_Stream_NowNs clock */
+    uint16_t        receiverId;     /* Id returned by NEO6M_Engine_AddReceiver */
+} Engine_Fix_t;
+
+struct Engine_Shard;
+
+/**
+ * @brief Data structure that contains one receiver stream
+*/
+typedef struct
+{
+    Stream_Ctx_t            stream;     /* Framer */
+    struct Engine_Shard*    pShard;     /* Shard reading this receiver */
+    int                     fd;         /* Readable descriptor (serial port, pty, pipe) */
+    uint16_t                id;         /* Receiver id */
+    uint8_t                 open;       /* Descriptor has not reached end of stream */
+} Engine_Receiver_t;
+
+/**
+ * @brief Data structure that contains one worker shard. Only its own thread touches
+ *        the parser context, so the shards parse in parallel.
+*/
+typedef struct Engine_Shard
+{
+    NEO6M_Ctx_t             parser;                             /* Parser context of this shard */
+    Engine_Fix_t            batch[ENGINE_BATCH_LENGTH];         /* Fixes not yet in the queue */
+    Engine_Receiver_t*      receivers[ENGINE_MAX_RECEIVERS];    /* Receivers pinned to this shard */
+    struct Engine*          pEngine;                            /* Owner */
+    pthread_t               thread;                             /* Worker thread */
+    int                     wakeFd[2];                          /* Pipe used to wake the worker on stop */
+    uint32_t                sentences;                          /* Sentences decoded */
+    uint32_t                failures;                           /* Lines that did not decode */
+    uint16_t                batchCount;                         /* Fixes in batch */
+    uint16_t                count;                              /* Receivers pinned to this shard */
+    uint16_t                index;                              /* Shard index */
+} Engine_Shard_t;
+
+/**
+ * @brief Data structure that contains the engine
+*/
+typedef struct Engine
+{
+    Engine_Receiver_t       receivers[ENGINE_MAX_RECEIVERS];    /* Receiver streams */
+    Engine_Shard_t          shards[ENGINE_MAX_SHARDS];          /* Worker shards */
+    Engine_Fix_t            queue[ENGINE_QUEUE_LENGTH];         /* Output queue */
+    pthread_mutex_t         lock;                               /* Protects queue, queue counters and openReceivers */
+    pthread_cond_t          notEmpty;                           /* Signalled when fixes are queued or a receiver ends */
+    pthread_cond_t          notFull;                            /* Signalled when the consumer frees queue space */
+    uint32_t                queueHead;                          /* Oldest fix */
+    uint32_t                queueCount;                         /* Fixes in queue */
+    uint16_t                receiverCount;                      /* Receivers added */
+    uint16_t                openReceivers;                      /* Receivers not at end of stream */
+    uint16_t                shardCount;                         /* Shards in use */
+    uint8_t                 running;                            /* Workers started */
+    uint8_t                 stop;                               /* Workers must exit */
+} Engine_t;
+
+extern CheckStatus_t NEO6M_Engine_Init(Engine_t *pEngine, const uint16_t shardCount);
+extern CheckStatus_t NEO6M_Engine_AddReceiver(Engine_t *pEngine, const int fd, uint16_t *pId);
+extern CheckStatus_t NEO6M_Engine_Start(Engine_t *pEngine);
+extern CheckStatus_t NEO6M_Engine_Pop(Engine_t *pEngine, Engine_Fix_t *pFix, const uint32_t timeoutMs);
+extern void NEO6M_Engine_Stop(Engine_t *pEngine);
+
+#endif /* NEO6M_ENGINE_H */
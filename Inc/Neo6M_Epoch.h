@@ -0,0 +1,87 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Epoch.h
+  * @author  Huy Nguyen
+  * @brief   Epoch aggregator merging the sentences of one fix for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_EPOCH_H
+#define NEO6M_EPOCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define EPOCH_HAS_RMC                       0x01U   /* RMC merged */
+#define EPOCH_HAS_VTG                       0x02U   /* VTG merged */
+#define EPOCH_HAS_GGA                       0x04U   /* GGA merged */
+#define EPOCH_HAS_GSA                       0x08U   /* GSA merged */
+#define EPOCH_HAS_ALL                       (EPOCH_HAS_RMC | EPOCH_HAS_VTG | EPOCH_HAS_GGA | EPOCH_HAS_GSA)
+
+/**
+ * @brief Data structure that contains every sentence of one navigation epoch
+*/
+typedef struct
+{
+    GPRMC_Info_t rmc;           /* Valid when EPOCH_HAS_RMC is set */
+    GPVTG_Info_t vtg;           /* Valid when EPOCH_HAS_VTG is set */
+    GPGGA_Info_t gga;           /* Valid when EPOCH_HAS_GGA is set */
+    GPGSA_Info_t gsa;           /* Valid when EPOCH_HAS_GSA is set */
+    Time_Info_t time;           /* UTC time of the epoch */
+    uint8_t present;            /* EPOCH_HAS_* bits */
+    uint8_t hasTime;            /* time is valid */
+} Epoch_Fix_t;
+
+/**
+ * @brief Callback invoked once per epoch with the merged record
+*/
+typedef void (*Epoch_PublishFn_t)(void *pUser, Epoch_Fix_t const* pFix);
+
+/**
+ * @brief Data structure that contains the aggregator context
+*/
+typedef struct
+{
+    NEO6M_Ctx_t         parser;         /* Parser context of NEO6M_Epoch_OnLine */
+    Epoch_Fix_t         fix;            /* Epoch being collected */
+    Epoch_PublishFn_t   publishFn;      /* Publish callback */
+    void*               pUser;          /* User data for publishFn */
+    uint32_t            published;      /* Records published */
+    uint8_t             expected;       /* EPOCH_HAS_* bits that complete an epoch */
+    uint8_t             open;           /* An epoch is being collected */
+} Epoch_Ctx_t;
+
+extern void NEO6M_Epoch_Init(Epoch_Ctx_t *pCtx, const uint8_t expected, Epoch_PublishFn_t publishFn, void *pUser);
+extern void NEO6M_Epoch_OnSentence(Epoch_Ctx_t *pCtx, GPS_Sentence_t const* pSentence);
+extern CheckStatus_t NEO6M_Epoch_OnLine(Epoch_Ctx_t *pCtx, char const* const rawMessage);
+extern void NEO6M_Epoch_Flush(Epoch_Ctx_t *pCtx);
+
+#endif /* NEO6M_EPOCH_H */
@@ -0,0 +1,67 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_FixStore.h
+  * @author  Huy Nguyen
+  * @brief   Seqlock-protected latest-fix store for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_FIXSTORE_H
+#define NEO6M_FIXSTORE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define FIXSTORE_CACHE_LINE_SIZE            64U     /* Alignment that keeps the store off its neighbours' lines */
+#define FIXSTORE_READ_ATTEMPTS              4U      /* Snapshots a reader tries before it reports a torn read */
+#define FIXSTORE_WORDS                      ((sizeof(GPRMC_Info_t) + 3U) / 4U)
+
+/**
+ * @brief Data structure that contains the latest fix of one writer (the parser thread)
+ *        for any number of readers. The sequence is odd while a fix is being written; a
+ *        reader that sees it odd, or changed after its copy, knows the copy is torn.
+ *        Readers never write the store, so they do not contend with each other.
+*/
+typedef struct
+{
+    uint32_t        seq __attribute__((aligned(FIXSTORE_CACHE_LINE_SIZE)));    /* Twice the fixes published, +1 while writing */
+    union
+    {
+        GPRMC_Info_t    fix;                                                    /* Latest fix */
+        uint32_t        word[FIXSTORE_WORDS];                                   /* Same bytes, copied one word at a time */
+    } data;
+} FixStore_t;
+
+extern void NEO6M_FixStore_Init(FixStore_t *pStore);
+extern void NEO6M_FixStore_Publish(FixStore_t *pStore, GPRMC_Info_t const* pFix);
+extern CheckStatus_t NEO6M_FixStore_Read(FixStore_t const* pStore, GPRMC_Info_t *pFix, uint32_t *pVersion);
+
+#endif /* NEO6M_FIXSTORE_H */
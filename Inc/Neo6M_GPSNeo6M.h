@@ -41,7 +41,56 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "Neo6M_Config.h"
+#include "Neo6M_Stats.h"
+
 /* Exported defines ----------------------------------------------------------*/
+#define GPGSA_MAX_SV                        12U     /* Satellites listed in a GSA sentence */
+#define GPS_MAX_LINE_LENGTH                 100U    /* Longest line a parse reads */
+#define GPS_LAZY_LINE_LENGTH                GPS_MAX_LINE_LENGTH     /* Longest line a lazy sentence holds */
+#define GPS_LAZY_MAX_FIELDS                 32U     /* Fields a lazy sentence indexes */
+#define GPS_INPLACE_MAX_FIELDS              18U     /* Fields an in-place parse indexes, enough for GSA */
+#define NEO6M_CACHE_ENTRIES                 5U      /* Cached conversions per context */
+#define NEO6M_CACHE_KEY_LENGTH              16U     /* Longest cached field text, pole included */
+#define NEO6M_POOL_NODES                    (GPS_MAX_LINE_LENGTH + 1U)  /* Fields of the longest line */
+#define NEO6M_POOL_BYTES                    (GPS_MAX_LINE_LENGTH + 1U)  /* Field text plus one NUL per field */
+
+/* Field selection of NEO6M_GPSNeo6_ParseSentenceFields. The fields that decide whether a
+   sentence is valid (RMC status, VTG mode, GGA quality, GSA mode and fix type) are always
+   decoded; fields left out read as 0 */
+#define NEO6M_FIELD_TIME                    0x0001U /* UTC time of RMC and GGA */
+#define NEO6M_FIELD_DATE                    0x0002U /* Date of RMC */
+#define NEO6M_FIELD_LAT                     0x0004U /* Latitude of RMC and GGA */
+#define NEO6M_FIELD_LNG                     0x0008U /* Longitude of RMC and GGA */
+#define NEO6M_FIELD_COURSE                  0x0010U /* Course over ground of VTG */
+#define NEO6M_FIELD_SPEED                   0x0020U /* Speeds of VTG */
+#define NEO6M_FIELD_ALT                     0x0040U /* Altitude of GGA */
+#define NEO6M_FIELD_DOP                     0x0080U /* hdop of GGA, pdop, hdop and vdop of GSA */
+#define NEO6M_FIELD_SATS                    0x0100U /* numSats of GGA, satellite list of GSA */
+#define NEO6M_FIELD_POSITION                (NEO6M_FIELD_LAT | NEO6M_FIELD_LNG)
+#define NEO6M_FIELD_ALL                     0x01FFU
+
+/* Presence mask of the decoded structs: bit n is set if field n of the line was not
+   empty, so an empty field and a field holding 0 can be told apart. Fields past 31 and
+   the "*hh" checksum are not tracked. A field and its pole count as one position */
+#define NEO6M_PRESENT(n)                    (1UL << (n))
+#define GPRMC_PRESENT_TIME                  NEO6M_PRESENT(1U)
+#define GPRMC_PRESENT_LAT                   (NEO6M_PRESENT(3U) | NEO6M_PRESENT(4U))
+#define GPRMC_PRESENT_LNG                   (NEO6M_PRESENT(5U) | NEO6M_PRESENT(6U))
+#define GPRMC_PRESENT_DATE                  NEO6M_PRESENT(9U)
+#define GPVTG_PRESENT_COGT                  NEO6M_PRESENT(1U)
+#define GPVTG_PRESENT_SKNOTS                NEO6M_PRESENT(5U)
+#define GPVTG_PRESENT_SKPH                  NEO6M_PRESENT(7U)
+#define GPGGA_PRESENT_TIME                  NEO6M_PRESENT(1U)
+#define GPGGA_PRESENT_LAT                   (NEO6M_PRESENT(2U) | NEO6M_PRESENT(3U))
+#define GPGGA_PRESENT_LNG                   (NEO6M_PRESENT(4U) | NEO6M_PRESENT(5U))
+#define GPGGA_PRESENT_NUMSATS               NEO6M_PRESENT(7U)
+#define GPGGA_PRESENT_HDOP                  NEO6M_PRESENT(8U)
+#define GPGGA_PRESENT_ALT                   NEO6M_PRESENT(9U)
+#define GPGSA_PRESENT_SV(i)                 NEO6M_PRESENT(3U + (i))
+#define GPGSA_PRESENT_PDOP                  NEO6M_PRESENT(15U)
+#define GPGSA_PRESENT_HDOP                  NEO6M_PRESENT(16U)
+#define GPGSA_PRESENT_VDOP                  NEO6M_PRESENT(17U)
 
 /**
  * @brief Enumeration structure that contains the two results of a command
@@ -61,6 +110,44 @@ typedef enum __attribute__((packed))
     PARSE_SUCC                  /* Success status */
 } ParseStatus_t;
 
+/**
+ * @brief Enumeration structure that contains why a parse failed. The index of the field
+ *        behind NEO6M_ERR_FIELD is reported apart, see NEO6M_GPSNeo6_ParseSentenceErr.
+*/
+typedef enum __attribute__((packed))
+{
+    NEO6M_ERR_NONE,             /* Supported sentence decoded */
+    NEO6M_ERR_BAD_START,        /* Line does not start with '$' */
+    NEO6M_ERR_TRUNCATED,        /* No '\r' within the line limit, or a byte no line can hold */
+    NEO6M_ERR_CHECKSUM,         /* Checksum missing, malformed or wrong */
+    NEO6M_ERR_UNKNOWN_TYPE,     /* Sentence type not supported or not enabled */
+    NEO6M_ERR_NO_FIX,           /* Supported sentence without a valid fix */
+    NEO6M_ERR_FIELD,            /* Field out of range */
+    NEO6M_ERR_NO_MEMORY         /* Fields could not be stored */
+} NEO6M_Error_t;
+
+/**
+ * @brief Enumeration structure that contains the supported sentence types
+*/
+typedef enum __attribute__((packed))
+{
+    SENTENCE_UNKNOWN,           /* Not a supported sentence */
+    SENTENCE_GPRMC,             /* Recommended Minimum */
+    SENTENCE_GPVTG,             /* Course over ground and Ground speed */
+    SENTENCE_GPGGA,             /* Fix data */
+    SENTENCE_GPGSA              /* DOP and active satellites */
+} SentenceType_t;
+
+/**
+ * @brief Callback that writes bytes to the receiver (usually the UART TX path)
+*/
+typedef void (*NEO6M_WriteFn_t)(void *pUser, uint8_t const* data, uint16_t len);
+
+/**
+ * @brief Callback that returns a free running millisecond tick
+*/
+typedef uint32_t (*NEO6M_TickFn_t)(void *pUser);
+
 /**
  * @brief Data structure that contains node information
 */
@@ -100,6 +187,63 @@ typedef struct
     char pole;                  /* Pole */
 } Coord_Info_t;
 
+/**
+ * @brief Data structure that contains the text and the result of one cached conversion
+*/
+typedef struct
+{
+    char          key[NEO6M_CACHE_KEY_LENGTH];  /* Field text, then the pole character */
+    uint8_t       keyLen;                       /* Bytes in key, 0 if nothing is cached */
+    union
+    {
+        Date_Info_t  date;                      /* Date slots */
+        Coord_Info_t coord;                     /* Latitude and longitude slots */
+    } value;
+} NEO6M_CacheEntry_t;
+
+/**
+ * @brief Data structure that contains the last converted date and coordinates of each
+ *        sentence type, so an unchanged field is not converted again
+*/
+typedef struct
+{
+    NEO6M_CacheEntry_t entry[NEO6M_CACHE_ENTRIES];  /* RMC date, lat, lng, GGA lat, lng */
+    uint32_t      hits;         /* Conversions skipped */
+    uint32_t      misses;       /* Conversions done */
+} NEO6M_Cache_t;
+
+/**
+ * @brief Data structure that contains the static storage of the list of one line. Every
+ *        line fits, so an allocation never fails; the whole pool is released at once.
+*/
+typedef struct
+{
+    Node_t        node[NEO6M_POOL_NODES];   /* Node records */
+    char          data[NEO6M_POOL_BYTES];   /* Field buffers */
+    uint8_t       nodeUsed;                 /* Node records handed out */
+    uint8_t       dataUsed;                 /* Field buffer bytes handed out */
+} NEO6M_Pool_t;
+
+/**
+ * @brief Data structure that contains the state of one parser. Sentences can be parsed
+ *        concurrently as long as every thread uses its own context.
+*/
+typedef struct
+{
+    Node_t*       pHead;        /* Head of linked list */
+    uint8_t       fieldNum;     /* Current number of data field */
+    uint32_t      present;      /* NEO6M_PRESENT bits of the fields read so far */
+#if (NEO6M_CFG_FIELD_CACHE != 0)
+    NEO6M_Cache_t cache;        /* Previous conversions of this context */
+#endif
+#if (NEO6M_CFG_STATIC_POOL != 0)
+    NEO6M_Pool_t  pool;         /* Storage of the list instead of the heap */
+#endif
+#if (NEO6M_STATS_ENABLE != 0)
+    NEO6M_Stats_t stats;        /* Decode counters of this context */
+#endif
+} NEO6M_Ctx_t;
+
 /**
  * @brief Data structure that contains all of the information about VTG (Course over ground and Ground speed) data 
 */
@@ -108,6 +252,7 @@ typedef struct
     uint32_t cogt;              /* Course over ground (true) */
     uint32_t sknots;            /* Speed over ground (knots) */
     uint32_t skph;              /* Speed over ground (kilometers/hour) */
+    uint32_t present;           /* NEO6M_PRESENT bits of the non-empty fields */
 } GPVTG_Info_t;
 
 /**
@@ -119,8 +264,94 @@ typedef struct
     Date_Info_t date;           /* Date in day, month, year format, */
     Coord_Info_t lat;           /* Latitude */
     Coord_Info_t lng;           /* Longitude */
+    uint32_t present;           /* NEO6M_PRESENT bits of the non-empty fields */
 } GPRMC_Info_t;
 
+/**
+ * @brief Data structure that contains all of the information about GGA (Fix data) data
+*/
+typedef struct
+{
+    Time_Info_t time;           /* UTC time */
+    Coord_Info_t lat;           /* Latitude */
+    Coord_Info_t lng;           /* Longitude */
+    uint32_t hdop;              /* Horizontal dilution of precision */
+    int32_t alt;                /* Altitude above mean sea level */
+    uint8_t quality;            /* Fix quality, 1 = GPS fix, 2 = DGPS fix */
+    uint8_t numSats;            /* Number of satellites used */
+    uint32_t present;           /* NEO6M_PRESENT bits of the non-empty fields */
+} GPGGA_Info_t;
+
+/**
+ * @brief Data structure that contains all of the information about GSA (DOP and active satellites) data
+*/
+typedef struct
+{
+    uint32_t pdop;              /* Position dilution of precision */
+    uint32_t hdop;              /* Horizontal dilution of precision */
+    uint32_t vdop;              /* Vertical dilution of precision */
+    uint8_t sv[GPGSA_MAX_SV];   /* Satellites used, 0 for unused slots */
+    uint8_t fixType;            /* 2 = 2D fix, 3 = 3D fix */
+    char mode;                  /* 'A' automatic, 'M' manual */
+    uint32_t present;           /* NEO6M_PRESENT bits of the non-empty fields */
+} GPGSA_Info_t;
+
+/**
+ * @brief Data structure that contains a decoded sentence of any supported type
+*/
+typedef struct
+{
+    SentenceType_t type;        /* Sentence type */
+    union
+    {
+        GPRMC_Info_t rmc;       /* Valid when type is SENTENCE_GPRMC */
+        GPVTG_Info_t vtg;       /* Valid when type is SENTENCE_GPVTG */
+        GPGGA_Info_t gga;       /* Valid when type is SENTENCE_GPGGA */
+        GPGSA_Info_t gsa;       /* Valid when type is SENTENCE_GPGSA */
+    } info;
+} GPS_Sentence_t;
+
+/**
+ * @brief Data structure that contains a sentence tokenized now and converted on access.
+ *        It owns a copy of the line, so the caller's buffer may be reused right away.
+*/
+typedef struct
+{
+    GPS_Sentence_t  sentence;                           /* Type, validity fields and the fields converted so far */
+    uint16_t        converted;                          /* NEO6M_FIELD_* bits already in sentence */
+    uint8_t         valid;                              /* Supported type with a valid fix */
+    uint8_t         fieldNum;                           /* Fields in line */
+    uint8_t         field[GPS_LAZY_MAX_FIELDS];         /* Offset of each field in line */
+    char            line[GPS_LAZY_LINE_LENGTH + 1U];    /* Copy of the line, ',' and '\r' replaced by NUL */
+} GPS_Lazy_t;
+
+/**
+ * @brief Data structure that contains the state of an in-place parse: a pointer to the
+ *        caller's line and one byte per field
+*/
+typedef struct
+{
+    char*           line;                               /* Caller's line, delimiters replaced by NUL */
+    uint8_t         fieldNum;                           /* Fields indexed */
+    uint8_t         field[GPS_INPLACE_MAX_FIELDS];      /* Offset of each field in line */
+} GPS_InPlace_t;
+
 extern CheckStatus_t NEO6M_GPSNeo6_Api(char const* const rawMessage, void *pGPS_Neo6M);
+extern CheckStatus_t NEO6M_GPSNeo6_ParseSentence(char const* const rawMessage, GPS_Sentence_t *pSentence);
+extern void NEO6M_GPSNeo6_InitCtx(NEO6M_Ctx_t *pCtx);
+extern CheckStatus_t NEO6M_GPSNeo6_ParseSentenceCtx(NEO6M_Ctx_t *pCtx, char const* const rawMessage, GPS_Sentence_t *pSentence);
+extern CheckStatus_t NEO6M_GPSNeo6_ParseSentenceLen(NEO6M_Ctx_t *pCtx, char const* const rawMessage, const uint32_t len, GPS_Sentence_t *pSentence);
+extern NEO6M_Error_t NEO6M_GPSNeo6_ParseSentenceErr(NEO6M_Ctx_t *pCtx, char const* const rawMessage, GPS_Sentence_t *pSentence, uint8_t *pField);
+extern CheckStatus_t NEO6M_GPSNeo6_ParseSentenceFields(NEO6M_Ctx_t *pCtx, char const* const rawMessage, GPS_Sentence_t *pSentence, const uint16_t fields);
+extern CheckStatus_t NEO6M_GPSNeo6_VerifyChecksum(char const* const rawMessage);
+extern CheckStatus_t NEO6M_GPSNeo6_VerifyChecksumCtx(NEO6M_Ctx_t *pCtx, char const* const rawMessage);
+extern NEO6M_Stats_t* NEO6M_GPSNeo6_GetStats(NEO6M_Ctx_t *pCtx);
+extern CheckStatus_t NEO6M_GPSNeo6_LazyParse(GPS_Lazy_t *pLazy, char const* const rawMessage);
+extern GPS_Sentence_t const* NEO6M_GPSNeo6_LazyGet(GPS_Lazy_t *pLazy, const uint16_t fields);
+extern CheckStatus_t NEO6M_GPSNeo6_LazyGetTime(GPS_Lazy_t *pLazy, Time_Info_t *pTime);
+extern CheckStatus_t NEO6M_GPSNeo6_LazyGetDate(GPS_Lazy_t *pLazy, Date_Info_t *pDate);
+extern CheckStatus_t NEO6M_GPSNeo6_LazyGetPosition(GPS_Lazy_t *pLazy, Coord_Info_t *pLat, Coord_Info_t *pLng);
+extern CheckStatus_t NEO6M_GPSNeo6_ParseInPlace(GPS_InPlace_t *pTok, char *line, GPS_Sentence_t *pSentence, const uint16_t fields);
+extern char const* NEO6M_GPSNeo6_InPlaceField(GPS_InPlace_t const* pTok, const uint8_t fieldIndex);
 
 #endif /* NEO6M_GPSNEO6M_H */
@@ -0,0 +1,75 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_LogParse.h
+  * @author  Huy Nguyen
+  * @brief   Parallel chunked parser for recorded NMEA logs for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_LOGPARSE_H
+#define NEO6M_LOGPARSE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define LOGPARSE_MAX_THREADS                64U             /* Worker threads */
+#define LOGPARSE_DEFAULT_CHUNK              (1UL << 20)     /* Chunk size used when 0 is given */
+#define LOGPARSE_MAX_LINE_LENGTH            100U            /* Longer lines are skipped */
+
+/**
+ * @brief Data structure that contains one decoded sentence of a log
+*/
+typedef struct
+{
+    uint64_t        offset;     /* Offset of the '$' in the log */
+    GPS_Sentence_t  sentence;   /* Decoded sentence */
+} LogParse_Record_t;
+
+/**
+ * @brief Data structure that contains the result of parsing a log. Records are in log order.
+*/
+typedef struct
+{
+    LogParse_Record_t*  records;    /* Decoded sentences, release with NEO6M_LogParse_Free */
+    uint64_t            count;      /* Records */
+    uint64_t            lines;      /* Lines starting with '$' */
+    uint64_t            failures;   /* Lines that did not decode (unsupported, no fix, malformed) */
+    uint64_t            skipped;    /* Lines longer than LOGPARSE_MAX_LINE_LENGTH */
+} LogParse_Result_t;
+
+extern CheckStatus_t NEO6M_LogParse_Buffer(char const* data, const uint64_t size, LogParse_Result_t *pResult);
+extern CheckStatus_t NEO6M_LogParse_BufferParallel(char const* data, const uint64_t size, const uint16_t threads,
+                                                   const uint64_t chunkSize, LogParse_Result_t *pResult);
+extern CheckStatus_t NEO6M_LogParse_File(char const* const path, const uint16_t threads, LogParse_Result_t *pResult);
+extern void NEO6M_LogParse_Free(LogParse_Result_t *pResult);
+
+#endif /* NEO6M_LOGPARSE_H */
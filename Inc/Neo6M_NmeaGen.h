@@ -0,0 +1,107 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_NmeaGen.h
+  * @author  Huy Nguyen
+  * @brief   Deterministic synthetic NMEA stream generator for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_NMEAGEN_H
+#define NEO6M_NMEAGEN_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define NMEAGEN_RMC                         0x01U   /* Emit RMC */
+#define NMEAGEN_VTG                         0x02U   /* Emit VTG */
+#define NMEAGEN_GGA                         0x04U   /* Emit GGA */
+#define NMEAGEN_GSA                         0x08U   /* Emit GSA */
+#define NMEAGEN_GSV                         0x10U   /* Emit GSV (not decoded, present in real streams) */
+#define NMEAGEN_ALL                         (NMEAGEN_RMC | NMEAGEN_VTG | NMEAGEN_GGA | NMEAGEN_GSA | NMEAGEN_GSV)
+
+#define NMEAGEN_MAX_SENTENCE_LENGTH         82U     /* NMEA 0183 limit, including "\r\n" */
+#define NMEAGEN_MAX_EPOCH_LENGTH            (8U * NMEAGEN_MAX_SENTENCE_LENGTH) /* RMC, VTG, GGA, GSA, 3 GSV */
+#define NMEAGEN_MAX_SATS                    12U     /* Satellites in view */
+#define NMEAGEN_MAX_SPEED_MMPS              500000U /* Fastest mean or actual ground speed, 500 m/s */
+
+/**
+ * @brief Data structure that contains the generator settings
+*/
+typedef struct
+{
+    uint64_t    seed;               /* Same seed, same configuration: same bytes */
+    int32_t     startLatE7;         /* Start latitude, 1e-7 degrees */
+    int32_t     startLngE7;         /* Start longitude, 1e-7 degrees */
+    uint32_t    startTimeMs;        /* Start UTC time of day, milliseconds */
+    uint32_t    speedMmps;          /* Mean ground speed, millimetres per second, at most NMEAGEN_MAX_SPEED_MMPS */
+    uint16_t    epochMs;            /* Time between epochs, e.g. 1000 for 1 Hz */
+    uint16_t    corruptPermille;    /* Sentences with one byte changed (checksum then fails) */
+    uint16_t    truncatePermille;   /* Sentences cut short, without "\r\n" */
+    uint8_t     sentenceMask;       /* NMEAGEN_* bits */
+    uint8_t     day;                /* Start date: day */
+    uint8_t     month;              /* Start date: month */
+    uint8_t     year;               /* Start date: two digit year */
+} NmeaGen_Config_t;
+
+/**
+ * @brief Data structure that contains the generator state
+*/
+typedef struct
+{
+    NmeaGen_Config_t    config;                     /* Settings */
+    uint64_t            rng;                        /* PRNG state */
+    double              lat;                        /* Degrees */
+    double              lng;                        /* Degrees */
+    double              heading;                    /* Degrees from true north */
+    double              speed;                      /* Metres per second */
+    double              alt;                        /* Metres */
+    uint32_t            timeMs;                     /* UTC time of day */
+    uint32_t            sentences;                  /* Sentences written */
+    uint32_t            corrupted;                  /* Sentences corrupted */
+    uint32_t            truncated;                  /* Sentences truncated */
+    uint8_t             sv[NMEAGEN_MAX_SATS];       /* PRN of the satellites in view */
+    uint8_t             elevation[NMEAGEN_MAX_SATS];/* Elevation, degrees */
+    uint16_t            azimuth[NMEAGEN_MAX_SATS];  /* Azimuth, degrees */
+    uint8_t             snr[NMEAGEN_MAX_SATS];      /* Signal to noise ratio, dBHz */
+    uint8_t             inView;                     /* Entries used in sv */
+    uint8_t             used;                       /* First entries of sv used in the fix */
+    uint8_t             day;                        /* Current date: day */
+    uint8_t             month;                      /* Current date: month */
+    uint8_t             year;                       /* Current date: two digit year */
+} NmeaGen_Ctx_t;
+
+extern void NEO6M_NmeaGen_DefaultConfig(NmeaGen_Config_t *pConfig);
+extern void NEO6M_NmeaGen_Init(NmeaGen_Ctx_t *pCtx, NmeaGen_Config_t const* pConfig);
+extern uint32_t NEO6M_NmeaGen_NextEpoch(NmeaGen_Ctx_t *pCtx, char *outBuf, const uint32_t outSize);
+extern uint8_t NEO6M_NmeaGen_Finish(char *sentence, const uint8_t bodyLen);
+
+#endif /* NEO6M_NMEAGEN_H */
@@ -0,0 +1,88 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Poll.h
+  * @author  Huy Nguyen
+  * @brief   On-demand GPQ/UBX polling mode for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_POLL_H
+#define NEO6M_POLL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+#include "Neo6M_Stream.h"
+#include "Neo6M_UBXConfig.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define POLL_GPQ_MAX_LENGTH                 16U     /* "$EIGPQ,xxx*hh\r\n" and NUL */
+#define UBX_ID_CFG_MSG                      0x01U   /* CFG-MSG message */
+#define UBX_CLASS_NMEA                      0xF0U   /* Standard NMEA messages class */
+
+/**
+ * @brief Enumeration structure that contains the states of a poll request
+*/
+typedef enum __attribute__((packed))
+{
+    POLL_IDLE,                  /* No request */
+    POLL_PENDING,               /* Request sent, waiting for the reply */
+    POLL_DONE,                  /* Reply received */
+    POLL_TIMEOUT                /* No reply in time */
+} PollStatus_t;
+
+/**
+ * @brief Data structure that contains the polling context
+*/
+typedef struct
+{
+    char                line[STREAM_MAX_LINE_LENGTH + 1U];  /* Requested NMEA sentence */
+    UBX_Frame_t         frame;                              /* Requested UBX message */
+    NEO6M_WriteFn_t     writeFn;                            /* Transmit callback */
+    NEO6M_TickFn_t      tickFn;                             /* Millisecond tick callback */
+    void*               pUser;                              /* User data for callbacks */
+    uint32_t            startTick;                          /* Tick when the request was sent */
+    uint32_t            timeoutMs;                          /* Reply timeout */
+    char                sentence[4];                        /* Requested NMEA sentence id */
+    uint8_t             ubxCls;                             /* Requested UBX class */
+    uint8_t             ubxId;                              /* Requested UBX id */
+    uint8_t             isUbx;                              /* Request is a UBX poll */
+    PollStatus_t        status;                             /* Request state */
+} Poll_Ctx_t;
+
+extern uint8_t NEO6M_Poll_BuildGPQ(char const* const sentence, char *outBuf, const uint8_t outSize);
+extern CheckStatus_t NEO6M_Poll_QueueDisablePeriodic(UBXCfg_Session_t *pSession);
+extern void NEO6M_Poll_Init(Poll_Ctx_t *pCtx, NEO6M_WriteFn_t writeFn, NEO6M_TickFn_t tickFn, void *pUser);
+extern CheckStatus_t NEO6M_Poll_RequestNmea(Poll_Ctx_t *pCtx, char const* const sentence, const uint32_t timeoutMs);
+extern CheckStatus_t NEO6M_Poll_RequestUbx(Poll_Ctx_t *pCtx, const uint8_t cls, const uint8_t id, const uint32_t timeoutMs);
+extern void NEO6M_Poll_OnLine(Poll_Ctx_t *pCtx, char const* line, const uint8_t len);
+extern void NEO6M_Poll_OnFrame(Poll_Ctx_t *pCtx, UBX_Frame_t const* pFrame);
+extern PollStatus_t NEO6M_Poll_Check(Poll_Ctx_t *pCtx);
+
+#endif /* NEO6M_POLL_H */
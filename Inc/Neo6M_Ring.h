@@ -0,0 +1,75 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Ring.h
+  * @author  Huy Nguyen
+  * @brief   Lock-free single-producer/single-consumer byte ring for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_RING_H
+#define NEO6M_RING_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+#include "Neo6M_Stream.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define RING_CACHE_LINE_SIZE                64U     /* Padding unit that keeps producer and consumer apart */
+
+/**
+ * @brief Data structure that contains the ring. The producer (UART ISR or reader thread)
+ *        only writes the producer line, the consumer (parser thread) only writes the
+ *        consumer line, so the two sides never share a written cache line.
+*/
+typedef struct
+{
+    /* Read-only after NEO6M_Ring_Init */
+    uint8_t*    buffer __attribute__((aligned(RING_CACHE_LINE_SIZE)));  /* Storage, size is a power of two */
+    uint32_t    mask;                                                   /* Size - 1 */
+
+    /* Producer line */
+    uint32_t    head __attribute__((aligned(RING_CACHE_LINE_SIZE)));    /* Free running write index */
+    uint32_t    cachedTail;                                             /* Producer copy of tail */
+    uint32_t    overrunBytes;                                           /* Bytes dropped because the ring was full */
+    uint32_t    overrunEvents;                                          /* Pushes that dropped bytes */
+
+    /* Consumer line */
+    uint32_t    tail __attribute__((aligned(RING_CACHE_LINE_SIZE)));    /* Free running read index */
+    uint32_t    cachedHead;                                             /* Consumer copy of head */
+} Ring_t;
+
+extern CheckStatus_t NEO6M_Ring_Init(Ring_t *pRing, uint8_t *buffer, const uint32_t size);
+extern uint32_t NEO6M_Ring_Push(Ring_t *pRing, uint8_t const* data, const uint32_t len);
+extern CheckStatus_t NEO6M_Ring_PushByte(Ring_t *pRing, const uint8_t byte);
+extern uint32_t NEO6M_Ring_Pop(Ring_t *pRing, uint8_t *outBuf, const uint32_t outSize);
+extern uint32_t NEO6M_Ring_Drain(Ring_t *pRing, Stream_Ctx_t *pStream);
+extern uint32_t NEO6M_Ring_GetOverrunBytes(Ring_t const* pRing);
+
+#endif /* NEO6M_RING_H */
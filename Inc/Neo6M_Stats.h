@@ -0,0 +1,146 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Stats.h
+  * @author  Huy Nguyen
+  * @brief   Optional per-sentence-type counters and cycle histograms for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_STATS_H
+#define NEO6M_STATS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "Neo6M_Config.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define NEO6M_STATS_TYPES                   5U      /* One slot per SentenceType_t */
+#define NEO6M_STATS_BUCKETS                 24U     /* Bucket n counts decodes of [2^n, 2^(n+1)) cycles */
+
+/*
+ * Cycle counter used for the histograms. Override it on targets without one of the
+ * defaults, e.g. with DWT->CYCCNT on a Cortex-M3/M4.
+ */
+#if (NEO6M_STATS_ENABLE != 0) && !defined(NEO6M_STATS_CYCLES)
+#if defined(__x86_64__) || defined(__i386__)
+#define NEO6M_STATS_CYCLES()                __builtin_ia32_rdtsc()
+#elif defined(__aarch64__)
+#define NEO6M_STATS_CYCLES()                NEO6M_Stats_ReadCntvct()
+#else
+#error "Define NEO6M_STATS_CYCLES() to read a free running cycle counter"
+#endif
+#endif
+
+/**
+ * @brief Data structure that contains the counters of one sentence type
+*/
+typedef struct
+{
+    uint32_t ok;                                /* Decoded */
+    uint32_t fail;                              /* Header matched but the sentence was rejected */
+    uint32_t cycles[NEO6M_STATS_BUCKETS];       /* Decode time histogram, log2 buckets */
+} NEO6M_StatsType_t;
+
+/**
+ * @brief Data structure that contains the counters of one parser context. Slot
+ *        SENTENCE_UNKNOWN counts lines that failed tokenizing or matched no header.
+*/
+typedef struct
+{
+    NEO6M_StatsType_t   type[NEO6M_STATS_TYPES];    /* Indexed by SentenceType_t */
+    uint32_t            checksumFail;               /* Lines rejected by the checksum */
+} NEO6M_Stats_t;
+
+#if (NEO6M_STATS_ENABLE != 0)
+
+#if defined(__aarch64__) && !defined(__x86_64__)
+/**
+  * @brief      This function reads the ARMv8 virtual counter.
+  * @retval     Counter ticks
+  */
+static inline uint64_t NEO6M_Stats_ReadCntvct(void)
+{
+    uint64_t ticks;
+
+    __asm__ volatile ("mrs %0, cntvct_el0" : "=r" (ticks));
+
+    return ticks;
+}
+#endif
+
+/**
+  * @brief      This function records one decode. Inline so the enabled cost stays at a
+  *             couple of increments.
+  * @param[in]  pStats              Pointer to counters
+  * @param[in]  type                SentenceType_t of the line
+  * @param[in]  ok                  Non-zero if the line was decoded
+  * @param[in]  cycles              Decode time in cycles
+  * @retval     None
+  */
+static inline void NEO6M_Stats_Record(NEO6M_Stats_t *pStats, const uint8_t type, const uint8_t ok, const uint64_t cycles)
+{
+    NEO6M_StatsType_t *pType = &pStats->type[type];
+    uint32_t bucket          = (cycles > 1U) ? (63U - (uint32_t)__builtin_clzll(cycles)) : 0U;
+
+    if (bucket >= NEO6M_STATS_BUCKETS)
+    {
+        bucket = NEO6M_STATS_BUCKETS - 1U;
+    }
+
+    if (ok != 0U)
+    {
+        pType->ok++;
+    }
+    else
+    {
+        pType->fail++;
+    }
+
+    pType->cycles[bucket]++;
+}
+
+#define NEO6M_STATS_BEGIN(start)                        const uint64_t start = NEO6M_STATS_CYCLES()
+#define NEO6M_STATS_END(pStats, start, type, ok)        NEO6M_Stats_Record((pStats), (uint8_t)(type), (uint8_t)(ok), NEO6M_STATS_CYCLES() - (start))
+#define NEO6M_STATS_CHECKSUM_FAIL(pStats)               ((pStats)->checksumFail++)
+
+#else
+
+#define NEO6M_STATS_BEGIN(start)
+#define NEO6M_STATS_END(pStats, start, type, ok)        ((void)(type))
+#define NEO6M_STATS_CHECKSUM_FAIL(pStats)               ((void)0)
+
+#endif
+
+extern void NEO6M_Stats_Reset(NEO6M_Stats_t *pStats);
+extern uint64_t NEO6M_Stats_Percentile(NEO6M_StatsType_t const* pType, const uint16_t permille);
+
+#endif /* NEO6M_STATS_H */
@@ -0,0 +1,124 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Stream.h
+  * @author  Huy Nguyen
+  * @brief   Streaming NMEA/UBX framer for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_STREAM_H
+#define NEO6M_STREAM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+#include "Neo6M_UBX.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define STREAM_MAX_LINE_LENGTH              100U    /* Max NMEA line length, including "\r\n" */
+
+/**
+ * @brief Callback invoked for every complete NMEA line. The line starts with '$',
+ *        ends with "\r\n" and is NUL terminated, so it can be passed to NEO6M_GPSNeo6_Api.
+*/
+typedef void (*Stream_NmeaFn_t)(void *pUser, char const* line, uint8_t len);
+
+/**
+ * @brief Callback invoked for every UBX frame with a valid checksum
+*/
+typedef void (*Stream_UbxFn_t)(void *pUser, UBX_Frame_t const* pFrame);
+
+/**
+ * @brief Enumeration structure that contains the states of the framer
+*/
+typedef enum __attribute__((packed))
+{
+    STREAM_HUNT,                /* Looking for '$' or UBX sync */
+    STREAM_NMEA,                /* Collecting NMEA line */
+    STREAM_UBX_SYNC2,           /* Waiting for second sync char */
+    STREAM_UBX_CLASS,           /* Waiting for class */
+    STREAM_UBX_ID,              /* Waiting for id */
+    STREAM_UBX_LEN1,            /* Waiting for length low byte */
+    STREAM_UBX_LEN2,            /* Waiting for length high byte */
+    STREAM_UBX_PAYLOAD,         /* Collecting payload */
+    STREAM_UBX_CKA,             /* Waiting for CK_A */
+    STREAM_UBX_CKB              /* Waiting for CK_B */
+} StreamState_t;
+
+/**
+ * @brief Data structure that contains the receive times of the first and last byte of a
+ *        message, in nanoseconds of the clock the bytes were fed with
+*/
+typedef struct
+{
+    uint64_t firstNs;           /* '$' or first UBX sync char */
+    uint64_t lastNs;            /* '\n' or CK_B */
+} Stream_Stamp_t;
+
+/**
+ * @brief Data structure that contains the framer counters
+*/
+typedef struct
+{
+    uint32_t nmeaLines;         /* Complete NMEA lines delivered */
+    uint32_t ubxFrames;         /* Valid UBX frames delivered */
+    uint32_t ubxChecksumErrors; /* UBX frames dropped on checksum */
+    uint32_t overflows;         /* Lines or frames too long for the buffers */
+    uint32_t rejectedLines;     /* Lines dropped on a byte no NMEA line can hold */
+    uint32_t skippedBytes;      /* Bytes passed over while looking for a message start */
+} Stream_Stats_t;
+
+/**
+ * @brief Data structure that contains the framer context
+*/
+typedef struct
+{
+    StreamState_t   state;                              /* Current state */
+    uint8_t         lineLen;                            /* Bytes in line buffer */
+    uint16_t        payloadIndex;                       /* Bytes in frame payload */
+    uint8_t         ckA;                                /* Running CK_A */
+    uint8_t         ckB;                                /* Running CK_B */
+    uint8_t         ckValid;                            /* Received CK_A matched */
+    char            line[STREAM_MAX_LINE_LENGTH + 1U];  /* NMEA line buffer */
+    UBX_Frame_t     frame;                              /* UBX frame buffer */
+    Stream_NmeaFn_t nmeaFn;                             /* NMEA line callback */
+    Stream_UbxFn_t  ubxFn;                              /* UBX frame callback */
+    void*           pUser;                              /* User data for callbacks */
+    Stream_Stats_t  stats;                              /* Counters */
+    Stream_Stamp_t  stamp;                              /* Times of the message being collected, complete in the callbacks */
+    uint64_t        rxNs;                               /* Receive time of the bytes being fed */
+} Stream_Ctx_t;
+
+extern void NEO6M_Stream_Init(Stream_Ctx_t *pCtx, Stream_NmeaFn_t nmeaFn, Stream_UbxFn_t ubxFn, void *pUser);
+extern void NEO6M_Stream_Feed(Stream_Ctx_t *pCtx, uint8_t const* data, const uint32_t len);
+extern void NEO6M_Stream_FeedAt(Stream_Ctx_t *pCtx, uint8_t const* data, const uint32_t len, const uint64_t rxNs);
+extern uint64_t NEO6M_Stream_NowNs(void);
+extern uint32_t NEO6M_Stream_Resync(uint8_t const* data, const uint32_t len);
+
+#endif /* NEO6M_STREAM_H */
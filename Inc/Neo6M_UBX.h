@@ -0,0 +1,72 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_UBX.h
+  * @author  Huy Nguyen
+  * @brief   UBX binary protocol frame encoder for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_UBX_H
+#define NEO6M_UBX_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define UBX_SYNC_CHAR_1                     0xB5U   /* First sync character */
+#define UBX_SYNC_CHAR_2                     0x62U   /* Second sync character */
+#define UBX_HEADER_LENGTH                   6U      /* Sync chars, class, id and length */
+#define UBX_CHECKSUM_LENGTH                 2U      /* CK_A and CK_B */
+#define UBX_FRAME_OVERHEAD                  (UBX_HEADER_LENGTH + UBX_CHECKSUM_LENGTH)
+#define UBX_MAX_PAYLOAD_LENGTH              128U    /* Largest payload kept by the library */
+
+#define UBX_CLASS_ACK                       0x05U   /* ACK class */
+#define UBX_CLASS_CFG                       0x06U   /* CFG class */
+#define UBX_CLASS_AID                       0x0BU   /* AID class */
+#define UBX_ID_ACK_NAK                      0x00U   /* ACK-NAK message */
+#define UBX_ID_ACK_ACK                      0x01U   /* ACK-ACK message */
+
+/**
+ * @brief Data structure that contains a decoded UBX frame
+*/
+typedef struct
+{
+    uint8_t  cls;                                   /* Message class */
+    uint8_t  id;                                    /* Message id */
+    uint16_t len;                                   /* Payload length */
+    uint8_t  payload[UBX_MAX_PAYLOAD_LENGTH];       /* Payload */
+} UBX_Frame_t;
+
+extern void NEO6M_UBX_Checksum(uint8_t const* const data, const uint16_t len, uint8_t *pCkA, uint8_t *pCkB);
+extern uint16_t NEO6M_UBX_EncodeFrame(const uint8_t cls, const uint8_t id,
+                                      uint8_t const* const payload, const uint16_t len,
+                                      uint8_t *outBuf, const uint16_t outSize);
+
+#endif /* NEO6M_UBX_H */
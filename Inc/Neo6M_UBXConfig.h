@@ -0,0 +1,112 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_UBXConfig.h
+  * @author  Huy Nguyen
+  * @brief   Pipelined UBX configuration session for GPS Neo 6M header file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NEO6M_UBXCONFIG_H
+#define NEO6M_UBXCONFIG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_GPSNeo6M.h"
+#include "Neo6M_UBX.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define UBXCFG_MAX_COMMANDS                 16U     /* Max commands in one session */
+#define UBXCFG_MAX_FRAME_LENGTH             (64U + UBX_FRAME_OVERHEAD)  /* Max encoded command */
+
+/**
+ * @brief Enumeration structure that contains the states of a configuration command
+*/
+typedef enum __attribute__((packed))
+{
+    UBXCFG_CMD_QUEUED,          /* Added, not sent yet */
+    UBXCFG_CMD_SENT,            /* Sent, waiting for ACK/NAK */
+    UBXCFG_CMD_ACKED,           /* ACK-ACK received */
+    UBXCFG_CMD_NAKED,           /* ACK-NAK received, retry pending */
+    UBXCFG_CMD_TIMEOUT,         /* No reply in time, retry pending */
+    UBXCFG_CMD_FAILED           /* Out of attempts */
+} UBXCfg_CmdState_t;
+
+/**
+ * @brief Enumeration structure that contains the results of a configuration session
+*/
+typedef enum __attribute__((packed))
+{
+    UBXCFG_BUSY,                /* Replies still outstanding */
+    UBXCFG_DONE,                /* Every command acknowledged */
+    UBXCFG_DONE_WITH_FAILURES   /* Finished, at least one command failed */
+} UBXCfg_Status_t;
+
+/**
+ * @brief Data structure that contains one configuration command
+*/
+typedef struct
+{
+    uint8_t const*      payload;        /* Payload, owned by the caller */
+    uint32_t            sentTick;       /* Tick of the last transmission */
+    uint16_t            sendSeq;        /* Transmission order, used to match replies */
+    uint16_t            len;            /* Payload length */
+    uint8_t             cls;            /* Message class */
+    uint8_t             id;             /* Message id */
+    uint8_t             attempts;       /* Number of transmissions */
+    UBXCfg_CmdState_t   state;          /* Command state */
+} UBXCfg_Cmd_t;
+
+/**
+ * @brief Data structure that contains a configuration session
+*/
+typedef struct
+{
+    UBXCfg_Cmd_t        cmds[UBXCFG_MAX_COMMANDS];  /* Commands */
+    NEO6M_WriteFn_t     writeFn;                    /* Transmit callback */
+    NEO6M_TickFn_t      tickFn;                     /* Millisecond tick callback */
+    void*               pUser;                      /* User data for callbacks */
+    uint32_t            timeoutMs;                  /* Reply timeout per attempt */
+    uint32_t            startTick;                  /* Tick when the session started */
+    uint32_t            endTick;                    /* Tick when the session finished */
+    uint16_t            nextSeq;                    /* Next transmission order */
+    uint8_t             count;                      /* Number of commands */
+    uint8_t             maxAttempts;                /* Max transmissions per command */
+    UBXCfg_Status_t     status;                     /* Session result */
+} UBXCfg_Session_t;
+
+extern void NEO6M_UBXCfg_Init(UBXCfg_Session_t *pSession, NEO6M_WriteFn_t writeFn, NEO6M_TickFn_t tickFn,
+                              void *pUser, const uint32_t timeoutMs, const uint8_t maxAttempts);
+extern CheckStatus_t NEO6M_UBXCfg_Add(UBXCfg_Session_t *pSession, const uint8_t cls, const uint8_t id,
+                                      uint8_t const* const payload, const uint16_t len);
+extern void NEO6M_UBXCfg_Start(UBXCfg_Session_t *pSession);
+extern void NEO6M_UBXCfg_OnFrame(UBXCfg_Session_t *pSession, UBX_Frame_t const* pFrame);
+extern UBXCfg_Status_t NEO6M_UBXCfg_Poll(UBXCfg_Session_t *pSession);
+extern uint32_t NEO6M_UBXCfg_GetElapsedMs(UBXCfg_Session_t const* pSession);
+
+#endif /* NEO6M_UBXCONFIG_H */
@@ -0,0 +1,516 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_AidCache.c
+  * @author  Huy Nguyen
+  * @brief   Warm-start cache of UBX AID messages for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "Neo6M_AidCache.h"
+
+/* Private define ------------------------------------------------------------*/
+#define AIDCACHE_MAGIC                      "N6AC"  /* File magic */
+#define AIDCACHE_MAGIC_LENGTH               4U      /* File magic length */
+#define AIDCACHE_VERSION                    2U      /* File format version, 2 adds the capture time */
+#define AIDCACHE_HEADER_LENGTH              18U     /* Magic, version, flags, two masks and capture time */
+#define AIDCACHE_FLAG_INI                   0x01U   /* AID-INI present */
+
+/* AID-INI payload offsets and flags */
+#define AIDCACHE_INI_WN                     18U     /* GPS week number, U2 */
+#define AIDCACHE_INI_TOW                    20U     /* GPS time of week in ms, U4 */
+#define AIDCACHE_INI_TOW_NS                 24U     /* Fractional part of the time of week, I4 */
+#define AIDCACHE_INI_TACC_MS                28U     /* Time accuracy in ms, U4 */
+#define AIDCACHE_INI_TACC_NS                32U     /* Time accuracy in ns, U4 */
+#define AIDCACHE_INI_FLAGS                  44U     /* Flags, U4 */
+#define AIDCACHE_INI_FLAG_POS               0x0001UL    /* Position valid */
+#define AIDCACHE_INI_FLAG_TIME              0x0002UL    /* Time valid */
+#define AIDCACHE_INI_FLAG_CLOCKD            0x0004UL    /* Clock drift valid */
+#define AIDCACHE_INI_FLAG_TP                0x0008UL    /* Time given at a time pulse */
+#define AIDCACHE_INI_FLAG_CLOCKF            0x0010UL    /* Clock frequency valid */
+#define AIDCACHE_INI_FLAG_PREVTM            0x0080UL    /* Time pulse preceding the message */
+#define AIDCACHE_INI_FLAG_UTC               0x0400UL    /* Time is UTC, not GPS */
+
+#define AIDCACHE_GPS_EPOCH_UNIX             315964800UL /* 1980-01-06 00:00:00 UTC */
+#define AIDCACHE_GPS_LEAP_SECONDS           18U         /* GPS - UTC since 2017 */
+#define AIDCACHE_SECONDS_PER_WEEK           604800UL
+#define AIDCACHE_HOST_TIME_ACC_MS           2000U       /* Accuracy claimed for the caller's clock */
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function reads a little-endian 32-bit value.
+  * @param[in]  data                Pointer to 4 bytes
+  * @retval     Unsigned integer
+  */
+static uint32_t NEO6M_AidCache_ReadU32(uint8_t const* const data)
+{
+    return ((uint32_t)data[0])
+           | ((uint32_t)data[1] << 8)
+           | ((uint32_t)data[2] << 16)
+           | ((uint32_t)data[3] << 24);
+}
+
+/**
+  * @brief      This function writes a little-endian 32-bit value.
+  * @param[out] data                Pointer to 4 bytes
+  * @param[in]  value               Value to write
+  * @retval     None
+  */
+static void NEO6M_AidCache_WriteU32(uint8_t *data, const uint32_t value)
+{
+    data[0] = (uint8_t)(value & 0xFFU);
+    data[1] = (uint8_t)((value >> 8) & 0xFFU);
+    data[2] = (uint8_t)((value >> 16) & 0xFFU);
+    data[3] = (uint8_t)((value >> 24) & 0xFFU);
+}
+
+/**
+  * @brief      This function builds the AID-INI to replay: the clock drift of the capture is
+  *             dropped, the time is replaced by the caller's and the position is only kept
+  *             while it is as fresh as an ephemeris.
+  * @param[in]  pCache              Pointer to cache
+  * @param[in]  nowS                Current Unix time, 0 if unknown
+  * @param[in]  fresh               1 if the capture is known to be younger than AIDCACHE_EPH_MAX_AGE_S
+  * @param[out] ini                 Pointer to AIDCACHE_INI_LENGTH bytes
+  * @retval     NEO6M_OK if the payload still carries a valid time or position, NEO6M_NOK if not
+  */
+static CheckStatus_t NEO6M_AidCache_RefreshIni(AidCache_t const* pCache, const uint32_t nowS, const uint8_t fresh, uint8_t *ini)
+{
+    uint32_t flags;
+    uint32_t gpsS;
+
+    (void) memcpy(ini, pCache->ini, AIDCACHE_INI_LENGTH);
+
+    flags  = NEO6M_AidCache_ReadU32(&ini[AIDCACHE_INI_FLAGS]);
+    flags &= ~(AIDCACHE_INI_FLAG_TIME | AIDCACHE_INI_FLAG_CLOCKD | AIDCACHE_INI_FLAG_TP
+               | AIDCACHE_INI_FLAG_CLOCKF | AIDCACHE_INI_FLAG_PREVTM | AIDCACHE_INI_FLAG_UTC);
+
+    if (fresh == 0U)
+    {
+        flags &= ~AIDCACHE_INI_FLAG_POS;
+    }
+
+    if (nowS > AIDCACHE_GPS_EPOCH_UNIX)
+    {
+        gpsS = (nowS - AIDCACHE_GPS_EPOCH_UNIX) + AIDCACHE_GPS_LEAP_SECONDS;
+
+        ini[AIDCACHE_INI_WN]        = (uint8_t)((gpsS / AIDCACHE_SECONDS_PER_WEEK) & 0xFFU);
+        ini[AIDCACHE_INI_WN + 1U]   = (uint8_t)(((gpsS / AIDCACHE_SECONDS_PER_WEEK) >> 8) & 0xFFU);
+        NEO6M_AidCache_WriteU32(&ini[AIDCACHE_INI_TOW], (gpsS % AIDCACHE_SECONDS_PER_WEEK) * 1000UL);
+        NEO6M_AidCache_WriteU32(&ini[AIDCACHE_INI_TOW_NS], 0U);
+        NEO6M_AidCache_WriteU32(&ini[AIDCACHE_INI_TACC_MS], AIDCACHE_HOST_TIME_ACC_MS);
+        NEO6M_AidCache_WriteU32(&ini[AIDCACHE_INI_TACC_NS], 0U);
+        flags |= AIDCACHE_INI_FLAG_TIME;
+    }
+
+    NEO6M_AidCache_WriteU32(&ini[AIDCACHE_INI_FLAGS], flags);
+
+    return ((flags & (AIDCACHE_INI_FLAG_POS | AIDCACHE_INI_FLAG_TIME)) != 0U) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      This function counts the bits set in a mask.
+  * @param[in]  mask                Mask
+  * @retval     Number of bits set
+  */
+static uint8_t NEO6M_AidCache_CountBits(uint32_t mask)
+{
+    uint8_t count = 0U;
+
+    while (mask != 0U)
+    {
+        mask &= (mask - 1U);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+  * @brief      This function encodes one AID frame and writes it to the receiver.
+  * @param[in]  id                  Message id
+  * @param[in]  payload             Pointer to payload
+  * @param[in]  len                 Payload length
+  * @param[in]  writeFn             Transmit callback
+  * @param[in]  pUser               User data passed to writeFn
+  * @retval     None
+  */
+static void NEO6M_AidCache_Send(const uint8_t id, uint8_t const* const payload, const uint16_t len,
+                                NEO6M_WriteFn_t writeFn, void *pUser)
+{
+    uint8_t  frame[AIDCACHE_EPH_LENGTH + UBX_FRAME_OVERHEAD];
+    uint16_t frameLen;
+
+    frameLen = NEO6M_UBX_EncodeFrame(UBX_CLASS_AID, id, payload, len, frame, sizeof(frame));
+
+    writeFn(pUser, frame, frameLen);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function empties a cache.
+  * @param[out] pCache              Pointer to cache
+  * @retval     None
+  */
+void NEO6M_AidCache_Init(AidCache_t *pCache)
+{
+    (void) memset(pCache, 0, sizeof(AidCache_t));
+}
+
+/**
+  * @brief      This function polls AID-INI, AID-ALM and AID-EPH for every SV.
+  *             Feed the replies to NEO6M_AidCache_OnFrame.
+  * @param[in]  writeFn             Transmit callback
+  * @param[in]  pUser               User data passed to writeFn
+  * @retval     None
+  */
+void NEO6M_AidCache_RequestAll(NEO6M_WriteFn_t writeFn, void *pUser)
+{
+    NEO6M_AidCache_Send(UBX_ID_AID_INI, NULL, 0U, writeFn, pUser);
+    NEO6M_AidCache_Send(UBX_ID_AID_ALM, NULL, 0U, writeFn, pUser);
+    NEO6M_AidCache_Send(UBX_ID_AID_EPH, NULL, 0U, writeFn, pUser);
+}
+
+/**
+  * @brief      This function captures an AID frame delivered by the streaming parser.
+  * @param[in]  pCache              Pointer to cache
+  * @param[in]  pFrame              Pointer to frame
+  * @retval     NEO6M_OK if the frame was stored, NEO6M_NOK if it carried no assistance data
+  */
+CheckStatus_t NEO6M_AidCache_OnFrame(AidCache_t *pCache, UBX_Frame_t const* pFrame)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    uint32_t svid;
+
+    if (pFrame->cls == UBX_CLASS_AID)
+    {
+        if ((pFrame->id == UBX_ID_AID_INI) && (pFrame->len == AIDCACHE_INI_LENGTH))
+        {
+            (void) memcpy(pCache->ini, pFrame->payload, AIDCACHE_INI_LENGTH);
+            pCache->hasIni = 1U;
+
+            status = NEO6M_OK;
+        }
+        else if (((pFrame->id == UBX_ID_AID_ALM) && (pFrame->len == AIDCACHE_ALM_LENGTH))
+                 || ((pFrame->id == UBX_ID_AID_EPH) && (pFrame->len == AIDCACHE_EPH_LENGTH)))
+        {
+            svid = NEO6M_AidCache_ReadU32(pFrame->payload);
+
+            if ((svid >= 1U) && (svid <= AIDCACHE_MAX_SV))
+            {
+                if (pFrame->id == UBX_ID_AID_ALM)
+                {
+                    (void) memcpy(pCache->alm[svid - 1U], pFrame->payload, AIDCACHE_ALM_LENGTH);
+                    pCache->almMask |= (1UL << (svid - 1U));
+                }
+                else
+                {
+                    (void) memcpy(pCache->eph[svid - 1U], pFrame->payload, AIDCACHE_EPH_LENGTH);
+                    pCache->ephMask |= (1UL << (svid - 1U));
+                }
+
+                status = NEO6M_OK;
+            }
+        }
+        else
+        {
+            /* Poll request echo or "no data" reply. Do nothing */
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function records when the cache was captured. Call it once the replies
+  *             to NEO6M_AidCache_RequestAll are in; a cache without it is treated as stale.
+  * @param[in]  pCache              Pointer to cache
+  * @param[in]  nowS                Current Unix time
+  * @retval     None
+  */
+void NEO6M_AidCache_Stamp(AidCache_t *pCache, const uint32_t nowS)
+{
+    pCache->captureS = nowS;
+}
+
+/**
+  * @brief      This function sends the cached assistance data to the receiver: position and
+  *             time first, then almanacs, then ephemerides. AID-INI carries the caller's time
+  *             instead of the capture time; its position and the ephemerides are only sent
+  *             while the capture is younger than AIDCACHE_EPH_MAX_AGE_S. A cache of unknown
+  *             age (no capture time, or nowS 0) is treated as stale.
+  * @param[in]  pCache              Pointer to cache
+  * @param[in]  nowS                Current Unix time, 0 if unknown
+  * @param[in]  writeFn             Transmit callback
+  * @param[in]  pUser               User data passed to writeFn
+  * @retval     Number of frames sent
+  */
+uint16_t NEO6M_AidCache_Replay(AidCache_t const* pCache, const uint32_t nowS, NEO6M_WriteFn_t writeFn, void *pUser)
+{
+    uint8_t  ini[AIDCACHE_INI_LENGTH];
+    uint16_t frames = 0U;
+    uint8_t  fresh  = 0U;
+    uint8_t  sv;
+
+    if ((pCache->captureS != 0U) && (nowS >= pCache->captureS)
+        && ((nowS - pCache->captureS) <= AIDCACHE_EPH_MAX_AGE_S))
+    {
+        fresh = 1U;
+    }
+
+    if ((pCache->hasIni != 0U) && (NEO6M_AidCache_RefreshIni(pCache, nowS, fresh, ini) == NEO6M_OK))
+    {
+        NEO6M_AidCache_Send(UBX_ID_AID_INI, ini, AIDCACHE_INI_LENGTH, writeFn, pUser);
+        frames++;
+    }
+
+    for (sv = 0U; sv < AIDCACHE_MAX_SV; sv++)
+    {
+        if ((pCache->almMask & (1UL << sv)) != 0U)
+        {
+            NEO6M_AidCache_Send(UBX_ID_AID_ALM, pCache->alm[sv], AIDCACHE_ALM_LENGTH, writeFn, pUser);
+            frames++;
+        }
+    }
+
+    for (sv = 0U; (fresh != 0U) && (sv < AIDCACHE_MAX_SV); sv++)
+    {
+        if ((pCache->ephMask & (1UL << sv)) != 0U)
+        {
+            NEO6M_AidCache_Send(UBX_ID_AID_EPH, pCache->eph[sv], AIDCACHE_EPH_LENGTH, writeFn, pUser);
+            frames++;
+        }
+    }
+
+    return frames;
+}
+
+/**
+  * @brief      This function packs the cache into a compact image: a header with presence
+  *             masks and the capture time, the present payloads without per-record framing, and a checksum.
+  * @param[in]  pCache              Pointer to cache
+  * @param[out] outBuf              Pointer to output buffer
+  * @param[in]  outSize             Size of output buffer
+  * @retval     Number of bytes written, 0 if the buffer is too small
+  */
+uint32_t NEO6M_AidCache_Serialize(AidCache_t const* pCache, uint8_t *outBuf, const uint32_t outSize)
+{
+    uint32_t len;
+    uint32_t pos = AIDCACHE_HEADER_LENGTH;
+    uint8_t  sv;
+
+    len = AIDCACHE_HEADER_LENGTH
+          + ((pCache->hasIni != 0U) ? AIDCACHE_INI_LENGTH : 0U)
+          + ((uint32_t)NEO6M_AidCache_CountBits(pCache->almMask) * AIDCACHE_ALM_LENGTH)
+          + ((uint32_t)NEO6M_AidCache_CountBits(pCache->ephMask) * AIDCACHE_EPH_LENGTH)
+          + UBX_CHECKSUM_LENGTH;
+
+    if (len > outSize)
+    {
+        len = 0U;
+    }
+    else
+    {
+        (void) memcpy(outBuf, AIDCACHE_MAGIC, AIDCACHE_MAGIC_LENGTH);
+        outBuf[4] = AIDCACHE_VERSION;
+        outBuf[5] = (pCache->hasIni != 0U) ? AIDCACHE_FLAG_INI : 0U;
+        NEO6M_AidCache_WriteU32(&outBuf[6], pCache->almMask);
+        NEO6M_AidCache_WriteU32(&outBuf[10], pCache->ephMask);
+        NEO6M_AidCache_WriteU32(&outBuf[14], pCache->captureS);
+
+        if (pCache->hasIni != 0U)
+        {
+            (void) memcpy(&outBuf[pos], pCache->ini, AIDCACHE_INI_LENGTH);
+            pos += AIDCACHE_INI_LENGTH;
+        }
+
+        for (sv = 0U; sv < AIDCACHE_MAX_SV; sv++)
+        {
+            if ((pCache->almMask & (1UL << sv)) != 0U)
+            {
+                (void) memcpy(&outBuf[pos], pCache->alm[sv], AIDCACHE_ALM_LENGTH);
+                pos += AIDCACHE_ALM_LENGTH;
+            }
+        }
+
+        for (sv = 0U; sv < AIDCACHE_MAX_SV; sv++)
+        {
+            if ((pCache->ephMask & (1UL << sv)) != 0U)
+            {
+                (void) memcpy(&outBuf[pos], pCache->eph[sv], AIDCACHE_EPH_LENGTH);
+                pos += AIDCACHE_EPH_LENGTH;
+            }
+        }
+
+        /* Same Fletcher checksum as UBX frames, over everything before it */
+        NEO6M_UBX_Checksum(outBuf, (uint16_t)pos, &outBuf[pos], &outBuf[pos + 1U]);
+    }
+
+    return len;
+}
+
+/**
+  * @brief      This function restores a cache from an image made by NEO6M_AidCache_Serialize.
+  * @param[out] pCache              Pointer to cache, left empty on failure
+  * @param[in]  data                Pointer to image
+  * @param[in]  len                 Image length
+  * @retval     NEO6M_OK if the image is valid, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_AidCache_Deserialize(AidCache_t *pCache, uint8_t const* data, const uint32_t len)
+{
+    uint32_t expected;
+    uint32_t almMask;
+    uint32_t ephMask;
+    uint32_t pos = AIDCACHE_HEADER_LENGTH;
+    uint8_t  ckA;
+    uint8_t  ckB;
+    uint8_t  sv;
+
+    CheckStatus_t status = NEO6M_NOK;
+
+    NEO6M_AidCache_Init(pCache);
+
+    if ((len >= (AIDCACHE_HEADER_LENGTH + UBX_CHECKSUM_LENGTH))
+        && (len <= AIDCACHE_MAX_SERIALIZED_LENGTH)
+        && (memcmp(data, AIDCACHE_MAGIC, AIDCACHE_MAGIC_LENGTH) == 0)
+        && (data[4] == AIDCACHE_VERSION)
+    )
+    {
+        almMask = NEO6M_AidCache_ReadU32(&data[6]);
+        ephMask = NEO6M_AidCache_ReadU32(&data[10]);
+
+        expected = AIDCACHE_HEADER_LENGTH
+                   + (((data[5] & AIDCACHE_FLAG_INI) != 0U) ? AIDCACHE_INI_LENGTH : 0U)
+                   + ((uint32_t)NEO6M_AidCache_CountBits(almMask) * AIDCACHE_ALM_LENGTH)
+                   + ((uint32_t)NEO6M_AidCache_CountBits(ephMask) * AIDCACHE_EPH_LENGTH)
+                   + UBX_CHECKSUM_LENGTH;
+
+        NEO6M_UBX_Checksum(data, (uint16_t)(len - UBX_CHECKSUM_LENGTH), &ckA, &ckB);
+
+        if ((expected == len) && (ckA == data[len - 2U]) && (ckB == data[len - 1U]))
+        {
+            pCache->hasIni  = ((data[5] & AIDCACHE_FLAG_INI) != 0U) ? 1U : 0U;
+            pCache->almMask = almMask;
+            pCache->ephMask = ephMask;
+            pCache->captureS = NEO6M_AidCache_ReadU32(&data[14]);
+
+            if (pCache->hasIni != 0U)
+            {
+                (void) memcpy(pCache->ini, &data[pos], AIDCACHE_INI_LENGTH);
+                pos += AIDCACHE_INI_LENGTH;
+            }
+
+            for (sv = 0U; sv < AIDCACHE_MAX_SV; sv++)
+            {
+                if ((almMask & (1UL << sv)) != 0U)
+                {
+                    (void) memcpy(pCache->alm[sv], &data[pos], AIDCACHE_ALM_LENGTH);
+                    pos += AIDCACHE_ALM_LENGTH;
+                }
+            }
+
+            for (sv = 0U; sv < AIDCACHE_MAX_SV; sv++)
+            {
+                if ((ephMask & (1UL << sv)) != 0U)
+                {
+                    (void) memcpy(pCache->eph[sv], &data[pos], AIDCACHE_EPH_LENGTH);
+                    pos += AIDCACHE_EPH_LENGTH;
+                }
+            }
+
+            status = NEO6M_OK;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function writes the cache image to a file.
+  * @param[in]  pCache              Pointer to cache
+  * @param[in]  path                File path
+  * @retval     NEO6M_OK if written, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_AidCache_Save(AidCache_t const* pCache, char const* const path)
+{
+    uint8_t image[AIDCACHE_MAX_SERIALIZED_LENGTH];
+    CheckStatus_t status = NEO6M_NOK;
+    uint32_t len;
+    FILE *pFile;
+
+    len     = NEO6M_AidCache_Serialize(pCache, image, sizeof(image));
+    pFile   = fopen(path, "wb");
+
+    if (pFile != NULL)
+    {
+        if (fwrite(image, 1U, len, pFile) == len)
+        {
+            status = NEO6M_OK;
+        }
+
+        if (fclose(pFile) != 0)
+        {
+            status = NEO6M_NOK;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function reads a cache image from a file.
+  * @param[out] pCache              Pointer to cache, left empty on failure
+  * @param[in]  path                File path
+  * @retval     NEO6M_OK if a valid image was read, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_AidCache_Load(AidCache_t *pCache, char const* const path)
+{
+    uint8_t image[AIDCACHE_MAX_SERIALIZED_LENGTH + 1U];
+    CheckStatus_t status = NEO6M_NOK;
+    size_t len;
+    FILE *pFile;
+
+    NEO6M_AidCache_Init(pCache);
+
+    pFile = fopen(path, "rb");
+
+    if (pFile != NULL)
+    {
+        len = fread(image, 1U, sizeof(image), pFile);
+        (void) fclose(pFile);
+
+        status = NEO6M_AidCache_Deserialize(pCache, image, (uint32_t)len);
+    }
+
+    return status;
+}
@@ -0,0 +1,253 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_BaudDetect.c
+  * @author  Huy Nguyen
+  * @brief   Baud rate and protocol auto-detection for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_BaudDetect.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BAUDDETECT_HIT_WEIGHT               100     /* Score per valid message */
+#define BAUDDETECT_SYNC_WEIGHT              10      /* Score per UBX sync pair */
+#define BAUDDETECT_MISS_WEIGHT              25      /* Penalty per NMEA line with bad checksum */
+#define BAUDDETECT_ERROR_WEIGHT             1000    /* Penalty for a framing error on every byte */
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function recomputes the score of a candidate from its evidence.
+  * @param[in]  pScore              Pointer to candidate evidence
+  * @retval     None
+  */
+static void NEO6M_BaudDetect_UpdateScore(BaudDetect_Score_t *pScore)
+{
+    int32_t errorPenalty = 0;
+
+    if (pScore->bytes > 0U)
+    {
+        errorPenalty = (int32_t)(((uint64_t)pScore->framingErrors * BAUDDETECT_ERROR_WEIGHT) / pScore->bytes);
+    }
+
+    pScore->score = (BAUDDETECT_HIT_WEIGHT * ((int32_t)pScore->nmeaHits + (int32_t)pScore->ubxHits))
+                    + (BAUDDETECT_SYNC_WEIGHT * (int32_t)pScore->ubxSyncs)
+                    - (BAUDDETECT_MISS_WEIGHT * (int32_t)pScore->nmeaMisses)
+                    - errorPenalty;
+
+    pScore->protocols = (uint8_t)(((pScore->nmeaHits > 0U) ? BAUDDETECT_PROTO_NMEA : 0U)
+                                  | ((pScore->ubxHits > 0U) ? BAUDDETECT_PROTO_UBX : 0U));
+}
+
+/**
+  * @brief      This function tells whether a candidate has enough evidence to lock.
+  * @param[in]  pScore              Pointer to candidate evidence
+  * @retval     NEO6M_OK if locked, NEO6M_NOK if not
+  */
+static CheckStatus_t NEO6M_BaudDetect_IsLocked(BaudDetect_Score_t const* pScore)
+{
+    return ((((uint32_t)pScore->nmeaHits + pScore->ubxHits) >= BAUDDETECT_LOCK_HITS)
+            && (((uint64_t)pScore->framingErrors * 100U) <= ((uint64_t)pScore->bytes * BAUDDETECT_MAX_ERROR_PERCENT)))
+           ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      Framer callback: counts NMEA lines with valid and invalid checksums.
+  * @param[in]  pUser               Pointer to detector context
+  * @param[in]  line                Pointer to NMEA line
+  * @param[in]  len                 Line length
+  * @retval     None
+  */
+static void NEO6M_BaudDetect_OnLine(void *pUser, char const* line, uint8_t len)
+{
+    BaudDetect_Ctx_t *pCtx = (BaudDetect_Ctx_t *)pUser;
+
+    (void) len;
+
+    if (NEO6M_GPSNeo6_VerifyChecksum(line) == NEO6M_OK)
+    {
+        pCtx->scores[pCtx->current].nmeaHits++;
+    }
+    else
+    {
+        pCtx->scores[pCtx->current].nmeaMisses++;
+    }
+}
+
+/**
+  * @brief      Framer callback: counts UBX frames with a valid checksum.
+  * @param[in]  pUser               Pointer to detector context
+  * @param[in]  pFrame              Pointer to frame
+  * @retval     None
+  */
+static void NEO6M_BaudDetect_OnFrame(void *pUser, UBX_Frame_t const* pFrame)
+{
+    BaudDetect_Ctx_t *pCtx = (BaudDetect_Ctx_t *)pUser;
+
+    (void) pFrame;
+
+    pCtx->scores[pCtx->current].ubxHits++;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function initializes a detector with the candidate baud rates.
+  * @param[out] pCtx                Pointer to detector context
+  * @param[in]  bauds               Pointer to candidate baud rates
+  * @param[in]  count               Number of candidates, at most BAUDDETECT_MAX_CANDIDATES
+  * @retval     None
+  */
+void NEO6M_BaudDetect_Init(BaudDetect_Ctx_t *pCtx, uint32_t const* bauds, const uint8_t count)
+{
+    uint8_t index;
+
+    (void) memset(pCtx, 0, sizeof(BaudDetect_Ctx_t));
+
+    pCtx->count = (count > BAUDDETECT_MAX_CANDIDATES) ? BAUDDETECT_MAX_CANDIDATES : count;
+
+    for (index = 0U; index < pCtx->count; index++)
+    {
+        pCtx->scores[index].baud = bauds[index];
+    }
+
+    NEO6M_Stream_Init(&pCtx->stream, NEO6M_BaudDetect_OnLine, NEO6M_BaudDetect_OnFrame, pCtx);
+}
+
+/**
+  * @brief      This function scores bytes captured with the UART set to one candidate rate.
+  *             Windows of the same candidate may be fed in several calls.
+  * @param[in]  pCtx                Pointer to detector context
+  * @param[in]  candidate           Index of the candidate the bytes were captured at
+  * @param[in]  data                Pointer to captured bytes
+  * @param[in]  len                 Number of captured bytes
+  * @param[in]  framingErrors       Framing errors the UART reported while capturing
+  * @retval     NEO6M_OK once this candidate has locked, NEO6M_NOK if not (yet)
+  */
+CheckStatus_t NEO6M_BaudDetect_Feed(BaudDetect_Ctx_t *pCtx, const uint8_t candidate,
+                                    uint8_t const* data, const uint32_t len, const uint32_t framingErrors)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    BaudDetect_Score_t *pScore;
+    uint32_t index;
+
+    if (candidate < pCtx->count)
+    {
+        if (candidate != pCtx->current)
+        {
+            /* Bytes of another rate cannot continue a partial message */
+            pCtx->current = candidate;
+            NEO6M_Stream_Init(&pCtx->stream, NEO6M_BaudDetect_OnLine, NEO6M_BaudDetect_OnFrame, pCtx);
+        }
+
+        pScore = &pCtx->scores[candidate];
+
+        for (index = 1U; index < len; index++)
+        {
+            if ((data[index - 1U] == UBX_SYNC_CHAR_1) && (data[index] == UBX_SYNC_CHAR_2))
+            {
+                pScore->ubxSyncs++;
+            }
+        }
+
+        NEO6M_Stream_Feed(&pCtx->stream, data, len);
+
+        pScore->bytes           += len;
+        pScore->framingErrors   += framingErrors;
+        NEO6M_BaudDetect_UpdateScore(pScore);
+
+        if (NEO6M_BaudDetect_IsLocked(pScore) == NEO6M_OK)
+        {
+            pCtx->locked = (uint8_t)(candidate + 1U);
+            status = NEO6M_OK;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function returns the locked candidate, or the best scoring one that
+  *             produced at least one valid message.
+  * @param[in]  pCtx                Pointer to detector context
+  * @param[out] pBaud               Pointer to detected baud rate
+  * @param[out] pProtocols          Pointer to BAUDDETECT_PROTO_* bits seen at that rate
+  * @retval     NEO6M_OK if a rate was found, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_BaudDetect_GetBest(BaudDetect_Ctx_t const* pCtx, uint32_t *pBaud, uint8_t *pProtocols)
+{
+    BaudDetect_Score_t const* pBest = NULL;
+    uint8_t index;
+
+    if (pCtx->locked != 0U)
+    {
+        pBest = &pCtx->scores[pCtx->locked - 1U];
+    }
+    else
+    {
+        for (index = 0U; index < pCtx->count; index++)
+        {
+            if ((pCtx->scores[index].protocols != BAUDDETECT_PROTO_NONE)
+                && ((pBest == NULL) || (pCtx->scores[index].score > pBest->score))
+            )
+            {
+                pBest = &pCtx->scores[index];
+            }
+        }
+    }
+
+    if (pBest != NULL)
+    {
+        *pBaud      = pBest->baud;
+        *pProtocols = pBest->protocols;
+    }
+
+    return (pBest != NULL) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      This function scores a single recorded window of bytes.
+  * @param[in]  data                Pointer to captured bytes
+  * @param[in]  len                 Number of captured bytes
+  * @param[in]  framingErrors       Framing errors reported while capturing
+  * @param[out] pScore              Pointer to evidence and score
+  * @retval     None
+  */
+void NEO6M_BaudDetect_Score(uint8_t const* data, const uint32_t len, const uint32_t framingErrors,
+                            BaudDetect_Score_t *pScore)
+{
+    BaudDetect_Ctx_t ctx;
+    uint32_t baud = 0U;
+
+    NEO6M_BaudDetect_Init(&ctx, &baud, 1U);
+    (void) NEO6M_BaudDetect_Feed(&ctx, 0U, data, len, framingErrors);
+
+    *pScore = ctx.scores[0];
+}
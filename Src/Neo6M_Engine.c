@@ -0,0 +1,452 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Engine.c
+  * @author  Huy Nguyen
+  * @brief   Multi-receiver fan-in engine with per-core parser shards for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE                         /* pthread_setaffinity_np, CPU_SET */
+#include <errno.h>
+#include <poll.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Neo6M_Engine.h"
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function moves the batch of a shard into the output queue under one lock.
+  *             When the queue is full the shard waits for the consumer, so bytes stay in the
+  *             kernel buffers instead of being dropped.
+  * @param[in]  pShard              Pointer to shard
+  * @retval     None
+  */
+static void NEO6M_Engine_FlushBatch(Engine_Shard_t *pShard)
+{
+    Engine_t *pEngine = pShard->pEngine;
+    uint16_t index;
+
+    if (pShard->batchCount > 0U)
+    {
+        (void) pthread_mutex_lock(&pEngine->lock);
+
+        for (index = 0U; index < pShard->batchCount; index++)
+        {
+            while ((pEngine->queueCount == ENGINE_QUEUE_LENGTH)
+                   && (__atomic_load_n(&pEngine->stop, __ATOMIC_ACQUIRE) == 0U))
+            {
+                (void) pthread_cond_wait(&pEngine->notFull, &pEngine->lock);
+            }
+
+            if (pEngine->queueCount == ENGINE_QUEUE_LENGTH)
+            {
+                /* Stopping, nobody will read the rest */
+                break;
+            }
+
+            pEngine->queue[(pEngine->queueHead + pEngine->queueCount) % ENGINE_QUEUE_LENGTH] = pShard->batch[index];
+            pEngine->queueCount++;
+        }
+
+        (void) pthread_cond_broadcast(&pEngine->notEmpty);
+        (void) pthread_mutex_unlock(&pEngine->lock);
+
+        pShard->batchCount = 0U;
+    }
+}
+
+/**
+  * @brief      Stream callback: decodes a line with the parser context of the receiver's shard.
+  * @param[in]  pUser               Pointer to receiver
+  * @param[in]  line                Pointer to NMEA line
+  * @param[in]  len                 Line length
+  * @retval     None
+  */
+static void NEO6M_Engine_OnLine(void *pUser, char const* line, uint8_t len)
+{
+    Engine_Receiver_t *pReceiver = (Engine_Receiver_t*)pUser;
+    Engine_Shard_t    *pShard    = pReceiver->pShard;
+    Engine_Fix_t      *pFix      = &pShard->batch[pShard->batchCount];
+
+    if (NEO6M_GPSNeo6_ParseSentenceLen(&pShard->parser, line, len, &pFix->sentence) == NEO6M_OK)
+    {
+        pFix->stamp      = pReceiver->stream.stamp;
+        pFix->receiverId = pReceiver->id;
+        pShard->batchCount++;
+        pShard->sentences++;
+
+        if (pShard->batchCount == ENGINE_BATCH_LENGTH)
+        {
+            NEO6M_Engine_FlushBatch(pShard);
+        }
+    }
+    else
+    {
+        pShard->failures++;
+    }
+}
+
+/**
+  * @brief      This function marks a receiver as ended and wakes the consumer.
+  * @param[in]  pShard              Pointer to shard
+  * @param[in]  pReceiver           Pointer to receiver
+  * @retval     None
+  */
+static void NEO6M_Engine_CloseReceiver(Engine_Shard_t *pShard, Engine_Receiver_t *pReceiver)
+{
+    Engine_t *pEngine = pShard->pEngine;
+
+    /* Fixes decoded so far must be queued before the consumer can see the end of stream */
+    NEO6M_Engine_FlushBatch(pShard);
+
+    pReceiver->open = 0U;
+
+    (void) pthread_mutex_lock(&pEngine->lock);
+    pEngine->openReceivers--;
+    (void) pthread_cond_broadcast(&pEngine->notEmpty);
+    (void) pthread_mutex_unlock(&pEngine->lock);
+}
+
+/**
+  * @brief      Worker thread of a shard: waits on its receivers and parses what they send.
+  *             The thread ends when all its receivers reached end of stream or on stop.
+  * @param[in]  pArg                Pointer to shard
+  * @retval     NULL
+  */
+static void* NEO6M_Engine_Worker(void *pArg)
+{
+    Engine_Shard_t    *pShard  = (Engine_Shard_t*)pArg;
+    Engine_t          *pEngine = pShard->pEngine;
+    struct pollfd      fds[ENGINE_MAX_RECEIVERS + 1U];
+    Engine_Receiver_t *polled[ENGINE_MAX_RECEIVERS + 1U];
+    uint8_t            chunk[ENGINE_READ_CHUNK];
+    nfds_t             fdCount;
+    nfds_t             fdIndex;
+    ssize_t            got;
+    uint16_t           index;
+
+    fds[0].fd       = pShard->wakeFd[0];
+    fds[0].events   = POLLIN;
+    polled[0]       = NULL;
+
+    while (__atomic_load_n(&pEngine->stop, __ATOMIC_ACQUIRE) == 0U)
+    {
+        fdCount = 1U;
+
+        for (index = 0U; index < pShard->count; index++)
+        {
+            if (pShard->receivers[index]->open != 0U)
+            {
+                fds[fdCount].fd     = pShard->receivers[index]->fd;
+                fds[fdCount].events = POLLIN;
+                polled[fdCount]     = pShard->receivers[index];
+                fdCount++;
+            }
+        }
+
+        if (fdCount == 1U)
+        {
+            /* Every receiver of this shard ended */
+            break;
+        }
+
+        if (poll(fds, fdCount, -1) > 0)
+        {
+            for (fdIndex = 1U; fdIndex < fdCount; fdIndex++)
+            {
+                if (fds[fdIndex].revents != 0)
+                {
+                    got = read(fds[fdIndex].fd, chunk, sizeof(chunk));
+
+                    if (got > 0)
+                    {
+                        NEO6M_Stream_Feed(&polled[fdIndex]->stream, chunk, (uint32_t)got);
+                    }
+                    else if ((got == 0) || ((errno != EAGAIN) && (errno != EINTR)))
+                    {
+                        /* End of stream; a pty whose master closed reports EIO */
+                        NEO6M_Engine_CloseReceiver(pShard, polled[fdIndex]);
+                    }
+                    else
+                    {
+                        /* Do nothing */
+                    }
+                }
+            }
+
+            NEO6M_Engine_FlushBatch(pShard);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+  * @brief      This function stops the running workers and joins them. The wake pipes are
+  *             emptied again, so the engine can be started anew.
+  * @param[in]  pEngine             Pointer to engine
+  * @retval     None
+  */
+static void NEO6M_Engine_Join(Engine_t *pEngine)
+{
+    uint8_t  wake = 0U;
+    uint16_t index;
+
+    (void) pthread_mutex_lock(&pEngine->lock);
+    __atomic_store_n(&pEngine->stop, 1U, __ATOMIC_RELEASE);
+    (void) pthread_cond_broadcast(&pEngine->notFull);
+    (void) pthread_mutex_unlock(&pEngine->lock);
+
+    for (index = 0U; index < pEngine->running; index++)
+    {
+        (void) write(pEngine->shards[index].wakeFd[1], &wake, 1U);
+        (void) pthread_join(pEngine->shards[index].thread, NULL);
+
+        /* Workers leave on the stop flag without reading the wake byte */
+        (void) read(pEngine->shards[index].wakeFd[0], &wake, 1U);
+    }
+
+    pEngine->running = 0U;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function initializes an engine. NEO6M_Engine_Stop must be called once
+  *             to release it, even if it was never started or this function failed.
+  * @param[out] pEngine             Pointer to engine
+  * @param[in]  shardCount          Worker threads, usually the number of cores
+  * @retval     NEO6M_OK if initialized, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_Engine_Init(Engine_t *pEngine, const uint16_t shardCount)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    pthread_condattr_t attr;
+    uint16_t index;
+
+    (void) memset(pEngine, 0, sizeof(Engine_t));
+
+    /* NEO6M_Engine_Pop waits against the monotonic clock, immune to wall clock steps */
+    (void) pthread_condattr_init(&attr);
+    (void) pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    (void) pthread_mutex_init(&pEngine->lock, NULL);
+    (void) pthread_cond_init(&pEngine->notEmpty, &attr);
+    (void) pthread_cond_init(&pEngine->notFull, &attr);
+    (void) pthread_condattr_destroy(&attr);
+
+    if ((shardCount > 0U) && (shardCount <= ENGINE_MAX_SHARDS))
+    {
+        status = NEO6M_OK;
+
+        for (index = 0U; index < shardCount; index++)
+        {
+            NEO6M_GPSNeo6_InitCtx(&pEngine->shards[index].parser);
+            pEngine->shards[index].pEngine  = pEngine;
+            pEngine->shards[index].index    = index;
+
+            if (pipe(pEngine->shards[index].wakeFd) != 0)
+            {
+                status = NEO6M_NOK;
+                break;
+            }
+
+            pEngine->shardCount++;
+        }
+
+        if (status != NEO6M_OK)
+        {
+            /* Leave no shard behind: the engine is released as one that has none */
+            for (index = 0U; index < pEngine->shardCount; index++)
+            {
+                (void) close(pEngine->shards[index].wakeFd[0]);
+                (void) close(pEngine->shards[index].wakeFd[1]);
+            }
+
+            pEngine->shardCount = 0U;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function adds a receiver stream before the engine starts. Receiver n is
+  *             pinned to shard n % shardCount, so its sentences keep their order.
+  * @param[in]  pEngine             Pointer to engine
+  * @param[in]  fd                  Readable descriptor, still owned by the caller
+  * @param[out] pId                 Receiver id reported in Engine_Fix_t
+  * @retval     NEO6M_OK if added, NEO6M_NOK if the engine is full, running or has no shard
+  */
+CheckStatus_t NEO6M_Engine_AddReceiver(Engine_t *pEngine, const int fd, uint16_t *pId)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    Engine_Receiver_t *pReceiver;
+    Engine_Shard_t    *pShard;
+
+    if ((pEngine->running == 0U) && (pEngine->shardCount > 0U) && (pEngine->receiverCount < ENGINE_MAX_RECEIVERS))
+    {
+        pReceiver           = &pEngine->receivers[pEngine->receiverCount];
+        pShard              = &pEngine->shards[pEngine->receiverCount % pEngine->shardCount];
+
+        pReceiver->pShard   = pShard;
+        pReceiver->fd       = fd;
+        pReceiver->id       = pEngine->receiverCount;
+        pReceiver->open     = 1U;
+        NEO6M_Stream_Init(&pReceiver->stream, NEO6M_Engine_OnLine, NULL, pReceiver);
+
+        pShard->receivers[pShard->count++] = pReceiver;
+
+        *pId = pReceiver->id;
+        pEngine->receiverCount++;
+        pEngine->openReceivers++;
+
+        status = NEO6M_OK;
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function starts one worker per shard, pinning shard n to core
+  *             n % (online cores). If a worker cannot be created, those already started
+  *             are stopped again and the engine can be started later.
+  * @param[in]  pEngine             Pointer to engine
+  * @retval     NEO6M_OK if started, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_Engine_Start(Engine_t *pEngine)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    long      cores = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t set;
+    uint16_t  index;
+
+    if ((pEngine->running == 0U) && (pEngine->shardCount > 0U))
+    {
+        status = NEO6M_OK;
+
+        for (index = 0U; index < pEngine->shardCount; index++)
+        {
+            if (pthread_create(&pEngine->shards[index].thread, NULL, NEO6M_Engine_Worker, &pEngine->shards[index]) != 0)
+            {
+                /* All shards or none: the receivers of a missing shard would never be read */
+                NEO6M_Engine_Join(pEngine);
+                __atomic_store_n(&pEngine->stop, 0U, __ATOMIC_RELEASE);
+
+                status = NEO6M_NOK;
+                break;
+            }
+
+            if (cores > 0)
+            {
+                CPU_ZERO(&set);
+                CPU_SET((int)(index % (uint16_t)cores), &set);
+                (void) pthread_setaffinity_np(pEngine->shards[index].thread, sizeof(set), &set);
+            }
+
+            pEngine->running++;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function takes the oldest decoded fix from the output queue.
+  * @param[in]  pEngine             Pointer to engine
+  * @param[out] pFix                Pointer to fix
+  * @param[in]  timeoutMs           Longest wait for a fix
+  * @retval     NEO6M_OK if a fix was taken, NEO6M_NOK on timeout or when every receiver
+  *             ended and the queue is empty
+  */
+CheckStatus_t NEO6M_Engine_Pop(Engine_t *pEngine, Engine_Fix_t *pFix, const uint32_t timeoutMs)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    struct timespec deadline;
+    int rc = 0;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec  += (time_t)(timeoutMs / 1000U);
+    deadline.tv_nsec += (long)(timeoutMs % 1000U) * 1000000L;
+
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    (void) pthread_mutex_lock(&pEngine->lock);
+
+    while ((pEngine->queueCount == 0U) && (pEngine->openReceivers > 0U) && (rc == 0))
+    {
+        rc = pthread_cond_timedwait(&pEngine->notEmpty, &pEngine->lock, &deadline);
+    }
+
+    if (pEngine->queueCount > 0U)
+    {
+        *pFix = pEngine->queue[pEngine->queueHead];
+        pEngine->queueHead = (pEngine->queueHead + 1U) % ENGINE_QUEUE_LENGTH;
+        pEngine->queueCount--;
+        (void) pthread_cond_signal(&pEngine->notFull);
+
+        status = NEO6M_OK;
+    }
+
+    (void) pthread_mutex_unlock(&pEngine->lock);
+
+    return status;
+}
+
+/**
+  * @brief      This function stops the workers and releases the engine. Receiver
+  *             descriptors are not closed.
+  * @param[in]  pEngine             Pointer to engine
+  * @retval     None
+  */
+void NEO6M_Engine_Stop(Engine_t *pEngine)
+{
+    uint16_t index;
+
+    NEO6M_Engine_Join(pEngine);
+
+    for (index = 0U; index < pEngine->shardCount; index++)
+    {
+        (void) close(pEngine->shards[index].wakeFd[0]);
+        (void) close(pEngine->shards[index].wakeFd[1]);
+    }
+
+    (void) pthread_cond_destroy(&pEngine->notFull);
+    (void) pthread_cond_destroy(&pEngine->notEmpty);
+    (void) pthread_mutex_destroy(&pEngine->lock);
+}
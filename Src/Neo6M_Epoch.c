@@ -0,0 +1,212 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Epoch.c
+  * @author  Huy Nguyen
+  * @brief   Epoch aggregator merging the sentences of one fix for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_Epoch.h"
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function publishes the epoch being collected, if any, and closes it.
+  * @param[in]  pCtx                Pointer to aggregator context
+  * @retval     None
+  */
+static void NEO6M_Epoch_Publish(Epoch_Ctx_t *pCtx)
+{
+    if ((pCtx->open != 0U) && (pCtx->fix.present != 0U))
+    {
+        pCtx->published++;
+
+        if (pCtx->publishFn != NULL)
+        {
+            pCtx->publishFn(pCtx->pUser, &pCtx->fix);
+        }
+    }
+
+    (void) memset(&pCtx->fix, 0, sizeof(Epoch_Fix_t));
+    pCtx->open = 0U;
+}
+
+/**
+  * @brief      This function tells whether two times are the same second.
+  * @param[in]  pA                  Pointer to first time
+  * @param[in]  pB                  Pointer to second time
+  * @retval     NEO6M_OK if equal, NEO6M_NOK if not
+  */
+static CheckStatus_t NEO6M_Epoch_SameTime(Time_Info_t const* pA, Time_Info_t const* pB)
+{
+    return ((pA->hr == pB->hr) && (pA->min == pB->min) && (pA->sec == pB->sec)) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function initializes an aggregator.
+  * @param[out] pCtx                Pointer to aggregator context
+  * @param[in]  expected            EPOCH_HAS_* bits the receiver outputs every epoch
+  * @param[in]  publishFn           Publish callback
+  * @param[in]  pUser               User data passed to publishFn
+  * @retval     None
+  */
+void NEO6M_Epoch_Init(Epoch_Ctx_t *pCtx, const uint8_t expected, Epoch_PublishFn_t publishFn, void *pUser)
+{
+    (void) memset(pCtx, 0, sizeof(Epoch_Ctx_t));
+    NEO6M_GPSNeo6_InitCtx(&pCtx->parser);
+
+    pCtx->expected  = expected;
+    pCtx->publishFn = publishFn;
+    pCtx->pUser     = pUser;
+}
+
+/**
+  * @brief      This function merges a decoded sentence into the current epoch.
+  *             An epoch ends as soon as every expected sentence has been merged. It also
+  *             ends, possibly incomplete, when RMC or GGA carries another UTC time or when
+  *             a sentence type repeats.
+  * @param[in]  pCtx                Pointer to aggregator context
+  * @param[in]  pSentence           Pointer to a successfully decoded sentence
+  * @retval     None
+  */
+void NEO6M_Epoch_OnSentence(Epoch_Ctx_t *pCtx, GPS_Sentence_t const* pSentence)
+{
+    Time_Info_t const* pTime = NULL;
+    uint8_t bit;
+
+    switch (pSentence->type)
+    {
+        case SENTENCE_GPRMC:
+            bit     = EPOCH_HAS_RMC;
+            pTime   = &pSentence->info.rmc.time;
+            break;
+
+        case SENTENCE_GPVTG:
+            bit     = EPOCH_HAS_VTG;
+            break;
+
+        case SENTENCE_GPGGA:
+            bit     = EPOCH_HAS_GGA;
+            pTime   = &pSentence->info.gga.time;
+            break;
+
+        case SENTENCE_GPGSA:
+            bit     = EPOCH_HAS_GSA;
+            break;
+
+        default:
+            bit     = 0U;
+            break;
+    }
+
+    if (bit != 0U)
+    {
+        if ((pCtx->open != 0U)
+            && (((pCtx->fix.present & bit) != 0U)
+                || ((pTime != NULL) && (pCtx->fix.hasTime != 0U)
+                    && (NEO6M_Epoch_SameTime(pTime, &pCtx->fix.time) != NEO6M_OK)))
+        )
+        {
+            /* Sentence belongs to the next epoch */
+            NEO6M_Epoch_Publish(pCtx);
+        }
+
+        pCtx->open = 1U;
+
+        if ((pTime != NULL) && (pCtx->fix.hasTime == 0U))
+        {
+            pCtx->fix.time      = *pTime;
+            pCtx->fix.hasTime   = 1U;
+        }
+
+        switch (pSentence->type)
+        {
+            case SENTENCE_GPRMC:
+                pCtx->fix.rmc = pSentence->info.rmc;
+                break;
+
+            case SENTENCE_GPVTG:
+                pCtx->fix.vtg = pSentence->info.vtg;
+                break;
+
+            case SENTENCE_GPGGA:
+                pCtx->fix.gga = pSentence->info.gga;
+                break;
+
+            default:
+                pCtx->fix.gsa = pSentence->info.gsa;
+                break;
+        }
+
+        pCtx->fix.present |= bit;
+
+        if ((pCtx->fix.present & pCtx->expected) == pCtx->expected)
+        {
+            NEO6M_Epoch_Publish(pCtx);
+        }
+    }
+}
+
+/**
+  * @brief      This function decodes a raw sentence and merges it into the current epoch.
+  *             Unsupported sentences and sentences without a valid fix are ignored. The
+  *             aggregator decodes with its own parser context, so aggregators on separate
+  *             threads do not share state.
+  * @param[in]  pCtx                Pointer to aggregator context
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @retval     NEO6M_OK if the sentence was merged, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_Epoch_OnLine(Epoch_Ctx_t *pCtx, char const* const rawMessage)
+{
+    GPS_Sentence_t sentence;
+    CheckStatus_t status;
+
+    status = NEO6M_GPSNeo6_ParseSentenceCtx(&pCtx->parser, rawMessage, &sentence);
+
+    if (status == NEO6M_OK)
+    {
+        NEO6M_Epoch_OnSentence(pCtx, &sentence);
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function publishes the epoch being collected even if it is incomplete,
+  *             e.g. when the stream stops.
+  * @param[in]  pCtx                Pointer to aggregator context
+  * @retval     None
+  */
+void NEO6M_Epoch_Flush(Epoch_Ctx_t *pCtx)
+{
+    NEO6M_Epoch_Publish(pCtx);
+}
@@ -0,0 +1,135 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_FixStore.c
+  * @author  Huy Nguyen
+  * @brief   Seqlock-protected latest-fix store for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_FixStore.h"
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function initializes an empty store.
+  * @param[out] pStore              Pointer to store
+  * @retval     None
+  */
+void NEO6M_FixStore_Init(FixStore_t *pStore)
+{
+    (void) memset(pStore, 0, sizeof(FixStore_t));
+}
+
+/**
+  * @brief      Writer side: replaces the latest fix. Only one thread may publish to a
+  *             store; the writer never waits for the readers.
+  * @param[in]  pStore              Pointer to store
+  * @param[in]  pFix                Pointer to fix
+  * @retval     None
+  */
+void NEO6M_FixStore_Publish(FixStore_t *pStore, GPRMC_Info_t const* pFix)
+{
+    uint32_t seq = __atomic_load_n(&pStore->seq, __ATOMIC_RELAXED);
+    uint32_t word[FIXSTORE_WORDS] = {0U};
+    uint32_t index;
+
+    (void) memcpy(word, pFix, sizeof(GPRMC_Info_t));
+
+    /* Odd: readers that start now, or finish after this point, retry */
+    __atomic_store_n(&pStore->seq, seq + 1U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for (index = 0U; index < FIXSTORE_WORDS; index++)
+    {
+        __atomic_store_n(&pStore->data.word[index], word[index], __ATOMIC_RELAXED);
+    }
+
+    /* Even again: the new fix is complete */
+    __atomic_store_n(&pStore->seq, seq + 2U, __ATOMIC_RELEASE);
+}
+
+/**
+  * @brief      Reader side: copies the latest fix. A copy that overlapped a publish is
+  *             detected and retried, at most FIXSTORE_READ_ATTEMPTS times, so a reader
+  *             finishes in bounded time even under a writer that never pauses.
+  * @param[in]  pStore              Pointer to store
+  * @param[out] pFix                Pointer to fix
+  * @param[out] pVersion            Pointer to number of fixes published up to the copied one, may be NULL
+  * @retval     NEO6M_OK if a complete fix was copied, NEO6M_NOK if none was published
+  *             yet or every attempt was torn
+  */
+CheckStatus_t NEO6M_FixStore_Read(FixStore_t const* pStore, GPRMC_Info_t *pFix, uint32_t *pVersion)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    uint32_t word[FIXSTORE_WORDS];
+    uint32_t attempt;
+    uint32_t before;
+    uint32_t index;
+
+    for (attempt = 0U; attempt < FIXSTORE_READ_ATTEMPTS; attempt++)
+    {
+        before = __atomic_load_n(&pStore->seq, __ATOMIC_ACQUIRE);
+
+        if (before == 0U)
+        {
+            /* Nothing published */
+            break;
+        }
+
+        if ((before & 1U) != 0U)
+        {
+            /* Publish in progress */
+            continue;
+        }
+
+        for (index = 0U; index < FIXSTORE_WORDS; index++)
+        {
+            word[index] = __atomic_load_n(&pStore->data.word[index], __ATOMIC_RELAXED);
+        }
+
+        /* The copy above must complete before the sequence is read again */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&pStore->seq, __ATOMIC_RELAXED) == before)
+        {
+            (void) memcpy(pFix, word, sizeof(GPRMC_Info_t));
+
+            if (pVersion != NULL)
+            {
+                *pVersion = before / 2U;
+            }
+
+            status = NEO6M_OK;
+            break;
+        }
+    }
+
+    return status;
+}
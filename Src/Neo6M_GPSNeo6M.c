@@ -36,55 +36,161 @@
 #include "Neo6M_GPSNeo6M.h"
 
 /* Private define ------------------------------------------------------------*/
-#define MAX_RAW_STRING_LENGTH               100U    /* Max raw string length */
+#define MAX_RAW_STRING_LENGTH               GPS_MAX_LINE_LENGTH     /* Max raw string length */
+#define NEO6M_LEN_UNBOUNDED                 0xFFFFFFFFUL    /* Length of a '\r' terminated string */
+
+/* Helpers needed by the decoders enabled in Neo6M_Config.h */
+#define NEO6M_NEED_UINT32                   ((NEO6M_CFG_ENABLE_GPVTG != 0) || (NEO6M_CFG_ENABLE_GPGGA != 0) || (NEO6M_CFG_ENABLE_GPGSA != 0))
+#define NEO6M_NEED_INT32                    (NEO6M_CFG_ENABLE_GPGGA != 0)
+#define NEO6M_NEED_TIME                     ((NEO6M_CFG_ENABLE_GPRMC != 0) || (NEO6M_CFG_ENABLE_GPGGA != 0))
+#define NEO6M_NEED_DATE                     (NEO6M_CFG_ENABLE_GPRMC != 0)
+#define NEO6M_NEED_COORD                    ((NEO6M_CFG_ENABLE_GPRMC != 0) || (NEO6M_CFG_ENABLE_GPGGA != 0))
+#define NEO6M_NEED_DECODE                   ((NEO6M_CFG_ENABLE_GPRMC != 0) || NEO6M_NEED_UINT32)
+#define NEO6M_NEED_CACHE                    ((NEO6M_CFG_FIELD_CACHE != 0) && NEO6M_NEED_COORD)
+
+/* Slots of NEO6M_Cache_t */
+#define NEO6M_CACHE_RMC_DATE                0U
+#define NEO6M_CACHE_RMC_LAT                 1U
+#define NEO6M_CACHE_RMC_LNG                 2U
+#define NEO6M_CACHE_GGA_LAT                 3U
+#define NEO6M_CACHE_GGA_LNG                 4U
+
+/* Whether field number n of a line is copied, given the mask of NEO6M_KeptFields */
+#define NEO6M_KEEP_FIELD(keep, n)           ((uint8_t)(((n) >= 32U) || ((((keep) >> (n)) & 1UL) != 0UL)))
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+ * @brief Data structure that tells the decoders where the fields of a line are
+*/
+typedef struct
+{
+    NEO6M_Ctx_t*        pCtx;       /* List and cache of an eager parse, NULL for a field table */
+    char const*         line;       /* Line of a field table, its delimiters replaced by NUL */
+    uint8_t const*      field;      /* Offset of each field in line */
+    uint8_t             fieldNum;   /* Fields in the table */
+    uint32_t            present;    /* NEO6M_PRESENT bits of the table */
+} NEO6M_Source_t;
 
 /* Private variables ---------------------------------------------------------*/
-static Node_t *g_pHead          = NULL;         /* Head of linked list */
-static uint8_t g_fieldNum;                      /* Current number of data field */
+static NEO6M_Ctx_t g_defaultCtx     = {NULL, 0U, 0U};   /* Context of the functions that take no context */
+static char        g_emptyField[2]  = "";           /* Returned for fields missing from or skipped in the message */
+
+#if NEO6M_NEED_COORD
+/* Static storage, so the padding bytes copied along with it are zero */
+static const Coord_Info_t g_invalidCoord = {255U, 255U, 'I'};
+#endif
 
 /* Private functions ---------------------------------------------------------*/
 
+/**
+  * @brief      This function allocates a node record.
+  * @param[in]  pCtx                Pointer to parser context
+  * @retval     Pointer to node, NULL if out of memory
+  */
+static Node_t* NEO6M_AllocNode(NEO6M_Ctx_t *pCtx)
+{
+#if (NEO6M_CFG_STATIC_POOL != 0)
+    Node_t *dataNode = NULL;
+
+    if (pCtx->pool.nodeUsed < NEO6M_POOL_NODES)
+    {
+        dataNode = &pCtx->pool.node[pCtx->pool.nodeUsed];
+        pCtx->pool.nodeUsed++;
+    }
+
+    return dataNode;
+#else
+    (void) pCtx;
+
+    return (Node_t *) malloc(sizeof(Node_t));
+#endif
+}
+
+/**
+  * @brief      This function allocates a zeroed field buffer.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  size                Bytes, NUL included
+  * @retval     Pointer to buffer, NULL if out of memory
+  */
+static char* NEO6M_AllocData(NEO6M_Ctx_t *pCtx, const uint32_t size)
+{
+#if (NEO6M_CFG_STATIC_POOL != 0)
+    char *data = NULL;
+
+    if (size <= (uint32_t)(NEO6M_POOL_BYTES - pCtx->pool.dataUsed))
+    {
+        data = &pCtx->pool.data[pCtx->pool.dataUsed];
+        pCtx->pool.dataUsed = (uint8_t)(pCtx->pool.dataUsed + size);
+        (void) memset(data, 0, size);
+    }
+
+    return data;
+#else
+    (void) pCtx;
+
+    return (char *) calloc(sizeof(char), size);
+#endif
+}
+
 /**
   * @brief      This function inserts a string into a node.
+  * @param[in]  pCtx                Pointer to parser context
   * @param[in]  str                 Pointer to string
   * @param[in]  dataLen             Length of string
+  * @param[in]  keep                0 to skip the copy, the node then reads as an empty field
   * @retval     NEO6M_OK if ok, NEO6M_NOK if not
   */
-static CheckStatus_t NEO6M_InsertToNode(char const* const str, const uint8_t dataLen)
+static CheckStatus_t NEO6M_InsertToNode(NEO6M_Ctx_t *pCtx, char const* const str, const uint8_t dataLen, const uint8_t keep)
 {
     Node_t *dataNode;
     CheckStatus_t status    = NEO6M_NOK;
 
     /* Allocate memory for a dataNode */
-    dataNode = (Node_t *) malloc(sizeof(Node_t));
+    dataNode = NEO6M_AllocNode(pCtx);
 
     /* Check if dataNode is allocated success or not */
     if (dataNode != NULL)
     {
-        /* Allocate memory for buffer */
-        dataNode->data  = (char *) calloc(sizeof(char), dataLen + 1U);
+        if (keep != 0U)
+        {
+            /* Allocate memory for buffer */
+            dataNode->data  = NEO6M_AllocData(pCtx, dataLen + 1U);
 
-        /* Check if data is allocated success or not */
-        if (dataNode->data != NULL)
+            /* Check if data is allocated success or not */
+            if (dataNode->data != NULL)
+            {
+                /* Copy data from str to buffer */
+                (void) strncpy(dataNode->data, str, dataLen);
+            }
+        }
+        else
         {
-            /* Copy data from str to buffer */
-            (void) strncpy(dataNode->data, str, dataLen);
+            /* Field not requested. Keep its place in the list only */
+            dataNode->data  = g_emptyField;
+        }
 
+        if (dataNode->data != NULL)
+        {
             /* Point new node to old node */
-            dataNode->next = g_pHead;
+            dataNode->next = pCtx->pHead;
 
             /* Point head to new node */
-            g_pHead = dataNode;
+            pCtx->pHead = dataNode;
 
             /* Increase data field index */
-            g_fieldNum++;
+            pCtx->fieldNum++;
 
             /* Update status to OK */
             status  = NEO6M_OK;
         }
         else
         {
-            /* Do nothing */
+#if (NEO6M_CFG_STATIC_POOL != 0)
+            /* Released with the rest of the pool */
+#else
+            free(dataNode);
+#endif
         }
     }
     else
@@ -95,45 +201,68 @@ static CheckStatus_t NEO6M_InsertToNode(char const* const str, const uint8_t dat
     return status;
 }
 
+#if NEO6M_NEED_DECODE
 /**
   * @brief      This function gets data of node from list by index.
+  * @param[in]  pCtx                Pointer to parser context
   * @param[in]  nodeIndex           Index of node
-  * @retval     Pointer to data node
+  * @retval     Pointer to data node, or to an empty string if the message has fewer fields
   */
-static char* NEO6M_GetDataByIndex(const uint8_t nodeIndex)
+static char* NEO6M_GetDataByIndex(NEO6M_Ctx_t const* pCtx, const uint8_t nodeIndex)
 {
-    Node_t *dataNode        = g_pHead;
+    Node_t *dataNode        = pCtx->pHead;
+    char   *data            = g_emptyField;
     uint8_t index;
 
-    for (index = 0; index < (g_fieldNum - 1U - nodeIndex); index++)
+    if (nodeIndex < pCtx->fieldNum)
     {
-        dataNode = dataNode->next;
+        for (index = 0; index < (pCtx->fieldNum - 1U - nodeIndex); index++)
+        {
+            dataNode = dataNode->next;
+        }
+
+        data = dataNode->data;
     }
 
-    return dataNode->data;
+    return data;
 }
+#endif
 
 /**
   * @brief      This function frees node in list.
+  * @param[in]  pCtx                Pointer to parser context
   * @retval     None
   */
-static void NEO6M_FreeList(void)
+static void NEO6M_FreeList(NEO6M_Ctx_t *pCtx)
 {
+#if (NEO6M_CFG_STATIC_POOL != 0)
+    /* Release the whole pool at once */
+    pCtx->pHead         = NULL;
+    pCtx->pool.nodeUsed = 0U;
+    pCtx->pool.dataUsed = 0U;
+#else
     Node_t *pCurNode;
 
-    while (g_pHead != NULL)
+    while (pCtx->pHead != NULL)
     {
-        pCurNode = g_pHead;
+        pCurNode = pCtx->pHead;
+
+        pCtx->pHead    = pCtx->pHead->next;
 
-        g_pHead    = g_pHead->next;
+        if (pCurNode->data != g_emptyField)
+        {
+            free(pCurNode->data);
+        }
 
-        free(pCurNode->data);
         free(pCurNode);
     }
+#endif
 
-    g_fieldNum = 0U;
+    pCtx->fieldNum = 0U;
+    pCtx->present  = 0U;
 }
 
+#if NEO6M_NEED_UINT32
 /**
   * @brief      This function converts a number as a string to a number.
   * @param[in]  str                 Pointer to string
@@ -152,6 +281,12 @@ static uint32_t NEO6M_ConvertStr2Uint32(char const* const str)
             continue;
         }
 
+        if (str[index] == '*')
+        {
+            /* Checksum of the last field. Stop here */
+            break;
+        }
+
         if ((str[index] < '0') || (str[index] > '9'))
         {
             /* Not a number. Set number to 0 and break the loop */
@@ -165,7 +300,32 @@ static uint32_t NEO6M_ConvertStr2Uint32(char const* const str)
 
     return number;
 }
+#endif
+
+#if NEO6M_NEED_INT32
+/**
+  * @brief      This function converts a signed number as a string to a number.
+  * @param[in]  str                 Pointer to string
+  * @retval     Signed integer
+  */
+static int32_t NEO6M_ConvertStr2Int32(char const* const str)
+{
+    int32_t number;
+
+    if (str[0] == '-')
+    {
+        number = -(int32_t)NEO6M_ConvertStr2Uint32(&str[1]);
+    }
+    else
+    {
+        number = (int32_t)NEO6M_ConvertStr2Uint32(str);
+    }
+
+    return number;
+}
+#endif
 
+#if NEO6M_NEED_TIME
 /**
   * @brief      This function converts a time as a string to time format.
   * @param[in]  str                 Pointer to string
@@ -204,7 +364,9 @@ static Time_Info_t NEO6M_ConvertStr2TimeFormat(char const* const str)
 
     return curr_time;
 }
+#endif
 
+#if NEO6M_NEED_DATE
 /**
   * @brief      This function converts a date as a string to date format.
   * @param[in]  str                 Pointer to string
@@ -243,7 +405,9 @@ static Date_Info_t NEO6M_ConvertStr2DateFormat(char const* const str)
 
     return date;
 }
+#endif
 
+#if NEO6M_NEED_COORD
 /**
   * @brief      This function converts a date as a string to coordinate format.
   * @param[in]  str                 Pointer to string
@@ -252,18 +416,22 @@ static Date_Info_t NEO6M_ConvertStr2DateFormat(char const* const str)
   */
 static Coord_Info_t NEO6M_ConvertStr2Coord(char const* const str, char const* const pole)
 {
-    Coord_Info_t coord = (Coord_Info_t){0, 0, 'I'};
+    Coord_Info_t coord;
     uint32_t fracDegs  = 0;
     uint8_t  str2uint8;
     uint8_t  index;
 
+    /* Clear the padding too, so equal coordinates compare equal byte for byte */
+    (void) memset(&coord, 0, sizeof(Coord_Info_t));
+    coord.pole = 'I';
+
     if ((pole[0] != 'N')
         && (pole[0] != 'E')
         && (pole[0] != 'W')
         && (pole[0] != 'S')
     )
     {
-        coord = (Coord_Info_t){255, 255, 'I'};
+        coord = g_invalidCoord;
     }
     else 
     {
@@ -281,7 +449,7 @@ static Coord_Info_t NEO6M_ConvertStr2Coord(char const* const str, char const* co
             )
             {
                 /* Invalid data. Break the loop */
-                coord = (Coord_Info_t){255, 255, 'I'};
+                coord = g_invalidCoord;
                 break;
             }
 
@@ -323,7 +491,9 @@ static Coord_Info_t NEO6M_ConvertStr2Coord(char const* const str, char const* co
 
     return coord;
 }
+#endif
 
+#if NEO6M_NEED_DECODE
 /**
   * @brief      This function validates the header in the raw message, matching the expected header.
   * @param[in]  headerMsg           Pointer to header from buffer
@@ -332,28 +502,186 @@ static Coord_Info_t NEO6M_ConvertStr2Coord(char const* const str, char const* co
   */
 static CheckStatus_t NEO6M_CheckHeaderMsg(char const* const headerMsg, char const* const expectedHeader)
 {
-    return ((strcmp(expectedHeader, &headerMsg[1]) == 0) ? NEO6M_OK : NEO6M_NOK);
+    /* An empty header field has nothing after its terminator */
+    return (((headerMsg[0] != '\0') && (strcmp(expectedHeader, &headerMsg[1]) == 0)) ? NEO6M_OK : NEO6M_NOK);
+}
+#endif
+
+/**
+  * @brief      This function converts a hexadecimal digit.
+  * @param[in]  c                   Character
+  * @retval     Value from 0 to 15, 0xFF if c is not a hexadecimal digit
+  */
+static uint8_t NEO6M_HexDigit(const char c)
+{
+    uint8_t value = 0xFFU;
+
+    if ((c >= '0') && (c <= '9'))
+    {
+        value = (uint8_t)(c - '0');
+    }
+    else if ((c >= 'A') && (c <= 'F'))
+    {
+        value = (uint8_t)(c - 'A' + 10);
+    }
+    else if ((c >= 'a') && (c <= 'f'))
+    {
+        value = (uint8_t)(c - 'a' + 10);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return value;
+}
+
+/**
+  * @brief      This function returns the field indexes a sentence needs for a field selection.
+  * @param[in]  headerMsg           Pointer to header from buffer
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     Bit n set if field n must be copied; fields from index 32 on are always copied
+  */
+static uint32_t NEO6M_KeptFields(char const* const headerMsg, const uint16_t fields)
+{
+    uint32_t keep = 0x00000001UL;   /* Header */
+
+    if (fields == NEO6M_FIELD_ALL)
+    {
+        keep = 0xFFFFFFFFUL;
+    }
+#if (NEO6M_CFG_ENABLE_GPRMC != 0)
+    else if (NEO6M_CheckHeaderMsg(headerMsg, "GPRMC") == NEO6M_OK)
+    {
+        keep |= (1UL << 2);
+        keep |= ((fields & NEO6M_FIELD_TIME) != 0U) ? (1UL << 1) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_DATE) != 0U) ? (1UL << 9) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_LAT) != 0U) ? ((1UL << 3) | (1UL << 4)) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_LNG) != 0U) ? ((1UL << 5) | (1UL << 6)) : 0UL;
+    }
+#endif
+#if (NEO6M_CFG_ENABLE_GPVTG != 0)
+    else if (NEO6M_CheckHeaderMsg(headerMsg, "GPVTG") == NEO6M_OK)
+    {
+        keep |= (1UL << 9);
+        keep |= ((fields & NEO6M_FIELD_COURSE) != 0U) ? (1UL << 1) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_SPEED) != 0U) ? ((1UL << 5) | (1UL << 7)) : 0UL;
+    }
+#endif
+#if (NEO6M_CFG_ENABLE_GPGGA != 0)
+    else if (NEO6M_CheckHeaderMsg(headerMsg, "GPGGA") == NEO6M_OK)
+    {
+        keep |= (1UL << 6);
+        keep |= ((fields & NEO6M_FIELD_TIME) != 0U) ? (1UL << 1) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_LAT) != 0U) ? ((1UL << 2) | (1UL << 3)) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_LNG) != 0U) ? ((1UL << 4) | (1UL << 5)) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_SATS) != 0U) ? (1UL << 7) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_DOP) != 0U) ? (1UL << 8) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_ALT) != 0U) ? (1UL << 9) : 0UL;
+    }
+#endif
+#if (NEO6M_CFG_ENABLE_GPGSA != 0)
+    else if (NEO6M_CheckHeaderMsg(headerMsg, "GPGSA") == NEO6M_OK)
+    {
+        keep |= (1UL << 1) | (1UL << 2);
+        keep |= ((fields & NEO6M_FIELD_SATS) != 0U) ? (0x00000FFFUL << 3) : 0UL;
+        keep |= ((fields & NEO6M_FIELD_DOP) != 0U) ? (0x00000007UL << 15) : 0UL;
+    }
+#endif
+    else
+    {
+        /* Nothing of an unsupported sentence is decoded */
+    }
+
+    return keep;
 }
 
 /**
-  * @brief      This function parses raw message, then put it into buffer.
+  * @brief      This function checks the "*hh" checksum ending a line at the '\r'.
   * @param[in]  rawMessage          Pointer to string read by UART
-  * @retval     PARSE_SUCC if the parsing process goes ok, PARSE_FAIL if it doesn't
+  * @param[in]  star                Index of the first '*', 0 if there is none
+  * @param[in]  end                 Index of the '\r'
+  * @param[in]  checksum            XOR of the characters between '$' and '*'
+  * @retval     NEO6M_ERR_NONE if it matches, NEO6M_ERR_CHECKSUM if it is missing, malformed or wrong
+  */
+static NEO6M_Error_t NEO6M_CheckTail(char const* const rawMessage, const uint8_t star, const uint8_t end, const uint8_t checksum)
+{
+    NEO6M_Error_t error = NEO6M_ERR_CHECKSUM;
+    uint8_t high;
+    uint8_t low;
+
+    if ((star != 0U) && (end == (star + 3U)))
+    {
+        high    = NEO6M_HexDigit(rawMessage[star + 1U]);
+        low     = NEO6M_HexDigit(rawMessage[star + 2U]);
+
+        if ((high <= 0x0FU) && (low <= 0x0FU) && (((high << 4) | low) == checksum))
+        {
+            error = NEO6M_ERR_NONE;
+        }
+    }
+
+    return error;
+}
+
+/**
+  * @brief      This function parses raw message, then put it into buffer. At most
+  *             min(len, MAX_RAW_STRING_LENGTH) bytes are read. The checksum is accumulated
+  *             in the same pass, so the frame is checked without reading the line twice.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[in]  len                 Bytes in rawMessage, or NEO6M_LEN_UNBOUNDED for a string
+  *                                 that must hold '\r' within the line limit
+  * @param[in]  fields              NEO6M_FIELD_* bits; fields nobody asked for keep their
+  *                                 place in the list but are not copied
+  * @param[out] pFrame              Pointer to the first fault of the line, in the order
+  *                                 NEO6M_ERR_BAD_START, NEO6M_ERR_TRUNCATED, NEO6M_ERR_CHECKSUM,
+  *                                 NEO6M_ERR_NO_MEMORY; NEO6M_ERR_NONE for a sound line. A line
+  *                                 ended by len, '\n' or '*' has no checksum checked and gets
+  *                                 NEO6M_ERR_CHECKSUM at best
+  * @retval     PARSE_SUCC if every field was stored, PARSE_FAIL if not
   */
-static ParseStatus_t NEO6M_ParseGPSMsg(char const* const rawMessage)
+static ParseStatus_t NEO6M_ParseGPSMsg(NEO6M_Ctx_t *pCtx, char const* const rawMessage, const uint32_t len, const uint16_t fields, NEO6M_Error_t *pFrame)
 {
     ParseStatus_t status    = PARSE_FAIL;
+    NEO6M_Error_t tail      = NEO6M_ERR_CHECKSUM;
 
     uint8_t index;
     uint8_t beginDataIndex  = 0U;
     uint8_t dataLength      = 0U;
-
-    for (index = 0U; index < MAX_RAW_STRING_LENGTH; index++)
+    uint8_t bounded         = (len != NEO6M_LEN_UNBOUNDED) ? 1U : 0U;
+    uint8_t limit           = (len < MAX_RAW_STRING_LENGTH) ? (uint8_t)len : MAX_RAW_STRING_LENGTH;
+    uint8_t stored          = 1U;               /* Cleared by the first field that cannot be stored */
+    uint8_t checksum        = 0U;
+    uint8_t star            = 0U;               /* Index of '*', 0 until seen */
+    uint32_t keep           = 0x00000001UL;     /* Header, the rest is known once it is read */
+
+    for (index = 0U; index < limit; index++)
     {
-        if (rawMessage[index] == '\r')
+        if ((rawMessage[index] == '\r')
+            || ((bounded != 0U) && ((rawMessage[index] == '\n') || (rawMessage[index] == '*'))))
         {
             /* Insert raw message block to buffer */
-            status = ((NEO6M_InsertToNode(&rawMessage[beginDataIndex], dataLength) == NEO6M_OK) ? PARSE_SUCC : PARSE_FAIL);
+            if (NEO6M_InsertToNode(pCtx, &rawMessage[beginDataIndex], dataLength,
+                                   NEO6M_KEEP_FIELD(keep, pCtx->fieldNum)) != NEO6M_OK)
+            {
+                stored = 0U;
+            }
+
+            if (rawMessage[index] == '\r')
+            {
+                tail = NEO6M_CheckTail(rawMessage, star, index, checksum);
+            }
+
+            status = PARSE_SUCC;
+
+            /* Break the loop */
+            break;
+        }
+        else if ((rawMessage[index] < ' ') || (rawMessage[index] > '~'))
+        {
+            /* String ended before '\r', or line noise. Do not scan the rest */
+            status = PARSE_FAIL;
 
             /* Break the loop */
             break;
@@ -361,7 +689,22 @@ static ParseStatus_t NEO6M_ParseGPSMsg(char const* const rawMessage)
         else if (rawMessage[index] == ',')
         {
             /* Insert raw message block to buffer */
-            status = ((NEO6M_InsertToNode(&rawMessage[beginDataIndex], dataLength) == NEO6M_OK) ? PARSE_SUCC : PARSE_FAIL);
+            if (NEO6M_InsertToNode(pCtx, &rawMessage[beginDataIndex], dataLength,
+                                   NEO6M_KEEP_FIELD(keep, pCtx->fieldNum)) != NEO6M_OK)
+            {
+                stored = 0U;
+            }
+
+            if (star == 0U)
+            {
+                checksum ^= (uint8_t)',';
+            }
+
+            if (pCtx->fieldNum == 1U)
+            {
+                /* Header read, select the fields of its sentence type */
+                keep = NEO6M_KeptFields(pCtx->pHead->data, fields);
+            }
 
             /* Reset data length to 0 */
             dataLength = 0U;
@@ -371,91 +714,1221 @@ static ParseStatus_t NEO6M_ParseGPSMsg(char const* const rawMessage)
         }
         else
         {
+            /* The first character of a field marks it present, unless the checksum follows */
+            if ((dataLength == 0U) && (rawMessage[index] != '*') && (pCtx->fieldNum < 32U))
+            {
+                pCtx->present |= NEO6M_PRESENT(pCtx->fieldNum);
+            }
+
+            /* Everything between '$' and the first '*' is covered by the checksum */
+            if ((star == 0U) && (index != 0U))
+            {
+                if (rawMessage[index] == '*')
+                {
+                    star = index;
+                }
+                else
+                {
+                    checksum ^= (uint8_t)rawMessage[index];
+                }
+            }
+
             /* Increase data length */
             dataLength++;
         }
     }
 
+    if (index == limit)
+    {
+        if ((bounded != 0U) && (len <= MAX_RAW_STRING_LENGTH))
+        {
+            /* The end of the buffer ends the last field */
+            if (NEO6M_InsertToNode(pCtx, &rawMessage[beginDataIndex], dataLength,
+                                   NEO6M_KEEP_FIELD(keep, pCtx->fieldNum)) != NEO6M_OK)
+            {
+                stored = 0U;
+            }
+
+            status = PARSE_SUCC;
+        }
+        else
+        {
+            /* No terminator within the line limit */
+            status = PARSE_FAIL;
+        }
+    }
+
+    if (limit == 0U)
+    {
+        /* Nothing may be read, not even the start character */
+        *pFrame = NEO6M_ERR_TRUNCATED;
+    }
+    else if (rawMessage[0] != '$')
+    {
+        *pFrame = NEO6M_ERR_BAD_START;
+    }
+    else if (status == PARSE_FAIL)
+    {
+        *pFrame = NEO6M_ERR_TRUNCATED;
+    }
+    else if (tail != NEO6M_ERR_NONE)
+    {
+        *pFrame = tail;
+    }
+    else if (stored == 0U)
+    {
+        *pFrame = NEO6M_ERR_NO_MEMORY;
+    }
+    else
+    {
+        *pFrame = NEO6M_ERR_NONE;
+    }
+
+    if (stored == 0U)
+    {
+        status = PARSE_FAIL;
+    }
+
     return status;
 }
 
+#if NEO6M_NEED_DECODE
 /**
-  * @brief      Function that makes the parsing of the GPVTG string.
-  * @param[out] pGPVTG_Info         Pointer to GPVTG_Info_t struct
-  * @retval     PARSE_SUCC if the parsing process goes ok, PARSE_FAIL if it doesn't
+  * @brief      This function gets a field of the line a decoder works on.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[in]  fieldIndex          Index of field
+  * @retval     Pointer to field, or to an empty string if the message has fewer fields
   */
-static ParseStatus_t NEO6M_ParseGPVTG(GPVTG_Info_t* pGPVTG_Info)
+static char const* NEO6M_GetField(NEO6M_Source_t const* pSrc, const uint8_t fieldIndex)
 {
-    ParseStatus_t status    = PARSE_FAIL;
+    char const* data        = g_emptyField;
 
-    (void) memset(pGPVTG_Info, 0, sizeof(GPVTG_Info_t));
-
-    if (NEO6M_GetDataByIndex(9)[0] == 'A')
+    if (pSrc->pCtx != NULL)
     {
-        pGPVTG_Info->cogt   = NEO6M_ConvertStr2Uint32(NEO6M_GetDataByIndex(1));
-        pGPVTG_Info->sknots = NEO6M_ConvertStr2Uint32(NEO6M_GetDataByIndex(5));
-        pGPVTG_Info->skph   = NEO6M_ConvertStr2Uint32(NEO6M_GetDataByIndex(7));
-
-        status = PARSE_SUCC;
+        data = NEO6M_GetDataByIndex(pSrc->pCtx, fieldIndex);
+    }
+    else if (fieldIndex < pSrc->fieldNum)
+    {
+        data = &pSrc->line[pSrc->field[fieldIndex]];
+    }
+    else
+    {
+        /* Do nothing */
     }
 
-    return status;
+    return data;
 }
 
 /**
-  * @brief      Function that makes the parsing of the GPRMC string.
-  * @param[out] pGPRMC_Info         Pointer to GPRMC_Info_t struct
-  * @retval     PARSE_SUCC if the parsing process goes ok, PARSE_FAIL if it doesn't
+  * @brief      This function gets the presence mask of the line a decoder works on.
+  * @param[in]  pSrc                Pointer to field source
+  * @retval     NEO6M_PRESENT bits
   */
-static ParseStatus_t NEO6M_ParseGPRMC(GPRMC_Info_t* pGPRMC_Info)
+static uint32_t NEO6M_GetPresent(NEO6M_Source_t const* pSrc)
 {
-    ParseStatus_t status    = PARSE_FAIL;
+    return (pSrc->pCtx != NULL) ? pSrc->pCtx->present : pSrc->present;
+}
+#endif
 
-    (void)memset(pGPRMC_Info, 0, sizeof(GPRMC_Info_t));
+#if NEO6M_NEED_CACHE
+/**
+  * @brief      This function compares the text of a field with the one converted last in a
+  *             cache slot. On a miss the slot takes the new text and the caller stores the
+  *             value it converts; text too long for the slot is never cached.
+  * @param[in]  pCache              Pointer to cache
+  * @param[in]  slot                NEO6M_CACHE_* slot
+  * @param[in]  str                 Pointer to field
+  * @param[in]  pole                Pole character, '\0' for a field without one
+  * @retval     1 if the cached value can be reused, 0 if not
+  */
+static uint8_t NEO6M_CacheLookup(NEO6M_Cache_t *pCache, const uint8_t slot, char const* const str, const char pole)
+{
+    NEO6M_CacheEntry_t *pEntry  = &pCache->entry[slot];
+    size_t              len     = strlen(str);
+    uint8_t             hit     = 0U;
 
-    if (NEO6M_GetDataByIndex(2)[0] == 'A')
+    if ((pEntry->keyLen == (len + 1U))
+        && (memcmp(pEntry->key, str, len) == 0)
+        && (pEntry->key[len] == pole))
     {
-        pGPRMC_Info->time   = NEO6M_ConvertStr2TimeFormat(NEO6M_GetDataByIndex(1));
-        pGPRMC_Info->date   = NEO6M_ConvertStr2DateFormat(NEO6M_GetDataByIndex(9));
-        pGPRMC_Info->lat    = NEO6M_ConvertStr2Coord(NEO6M_GetDataByIndex(3), NEO6M_GetDataByIndex(4));
-        pGPRMC_Info->lng    = NEO6M_ConvertStr2Coord(NEO6M_GetDataByIndex(5), NEO6M_GetDataByIndex(6));
+        pCache->hits++;
+        hit = 1U;
+    }
+    else
+    {
+        pCache->misses++;
 
-        status = PARSE_SUCC;
+        if (len < NEO6M_CACHE_KEY_LENGTH)
+        {
+            (void) memcpy(pEntry->key, str, len);
+            pEntry->key[len]    = pole;
+            pEntry->keyLen      = (uint8_t)(len + 1U);
+        }
+        else
+        {
+            pEntry->keyLen      = 0U;
+        }
     }
 
-    return status;
+    return hit;
 }
+#endif
 
-/* Exported functions --------------------------------------------------------*/
-
+#if NEO6M_NEED_COORD
 /**
-  * @brief      GPS Neo 6M Api function.
-  * @param[in]  rawMessage          Pointer to string read by UART
-  * @param[out] pGPS_Neo6M          Pointer to void struct
-  * @retval     NEO6M_OK if OK, NEO6M_NOK if not
+  * @brief      This function converts a coordinate and its pole field, reusing the value of
+  *             the previous sentence when an eager parse sees the same text again.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[in]  slot                NEO6M_CACHE_* slot
+  * @param[in]  fieldIndex          Index of the coordinate field, the pole follows it
+  * @retval     Coordinate
   */
-CheckStatus_t NEO6M_GPSNeo6_Api(char const* const rawMessage, void *pGPS_Neo6M)
+static Coord_Info_t NEO6M_ConvertCoordField(NEO6M_Source_t const* pSrc, const uint8_t slot, const uint8_t fieldIndex)
 {
-    CheckStatus_t status = NEO6M_NOK;
+    char const* str     = NEO6M_GetField(pSrc, fieldIndex);
+    char const* pole    = NEO6M_GetField(pSrc, fieldIndex + 1U);
+    Coord_Info_t coord;
 
-    if (NEO6M_ParseGPSMsg(rawMessage) != PARSE_FAIL)
+#if NEO6M_NEED_CACHE
+    if (pSrc->pCtx != NULL)
     {
-        if (NEO6M_CheckHeaderMsg(NEO6M_GetDataByIndex(0), "GPVTG") == NEO6M_OK)
+        if (NEO6M_CacheLookup(&pSrc->pCtx->cache, slot, str, pole[0]) != 0U)
+        {
+            coord = pSrc->pCtx->cache.entry[slot].value.coord;
+        }
+        else
         {
-            status = ((NEO6M_ParseGPVTG((GPVTG_Info_t*)pGPS_Neo6M) == PARSE_SUCC) ? NEO6M_OK : NEO6M_NOK);
+            coord = NEO6M_ConvertStr2Coord(str, pole);
+            pSrc->pCtx->cache.entry[slot].value.coord = coord;
         }
-        else if (NEO6M_CheckHeaderMsg(NEO6M_GetDataByIndex(0), "GPRMC") == NEO6M_OK)
+    }
+    else
+#else
+    (void) slot;
+#endif
+    {
+        coord = NEO6M_ConvertStr2Coord(str, pole);
+    }
+
+    return coord;
+}
+#endif
+
+#if NEO6M_NEED_DATE
+/**
+  * @brief      This function converts a date field, reusing the value of the previous
+  *             sentence when an eager parse sees the same text again.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[in]  slot                NEO6M_CACHE_* slot
+  * @param[in]  fieldIndex          Index of the date field
+  * @retval     Date
+  */
+static Date_Info_t NEO6M_ConvertDateField(NEO6M_Source_t const* pSrc, const uint8_t slot, const uint8_t fieldIndex)
+{
+    char const* str     = NEO6M_GetField(pSrc, fieldIndex);
+    Date_Info_t date;
+
+#if NEO6M_NEED_CACHE
+    if (pSrc->pCtx != NULL)
+    {
+        if (NEO6M_CacheLookup(&pSrc->pCtx->cache, slot, str, '\0') != 0U)
         {
-            status = ((NEO6M_ParseGPRMC((GPRMC_Info_t*)pGPS_Neo6M) == PARSE_SUCC) ? NEO6M_OK : NEO6M_NOK);
+            date = pSrc->pCtx->cache.entry[slot].value.date;
         }
         else
         {
-            /* Do nothing */
+            date = NEO6M_ConvertStr2DateFormat(str);
+            pSrc->pCtx->cache.entry[slot].value.date = date;
         }
     }
+    else
+#else
+    (void) slot;
+#endif
+    {
+        date = NEO6M_ConvertStr2DateFormat(str);
+    }
 
-    /* Clean list */
-    NEO6M_FreeList();
+    return date;
+}
+#endif
 
-    return status;
+#if (NEO6M_CFG_ENABLE_GPVTG != 0)
+/**
+  * @brief      This function converts the selected fields of a valid GPVTG string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPVTG_Info         Pointer to GPVTG_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     None
+  */
+static void NEO6M_ConvertGPVTG(NEO6M_Source_t const* pSrc, GPVTG_Info_t* pGPVTG_Info, const uint16_t fields)
+{
+    if ((fields & NEO6M_FIELD_COURSE) != 0U)
+    {
+        pGPVTG_Info->cogt   = NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 1));
+    }
+
+    if ((fields & NEO6M_FIELD_SPEED) != 0U)
+    {
+        pGPVTG_Info->sknots = NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 5));
+        pGPVTG_Info->skph   = NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 7));
+    }
+}
+
+/**
+  * @brief      Function that makes the parsing of the GPVTG string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPVTG_Info         Pointer to GPVTG_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     PARSE_SUCC if the parsing process goes ok, PARSE_FAIL if it doesn't
+  */
+static ParseStatus_t NEO6M_ParseGPVTG(NEO6M_Source_t const* pSrc, GPVTG_Info_t* pGPVTG_Info, const uint16_t fields)
+{
+    ParseStatus_t status    = PARSE_FAIL;
+
+    (void) memset(pGPVTG_Info, 0, sizeof(GPVTG_Info_t));
+    pGPVTG_Info->present = NEO6M_GetPresent(pSrc);
+
+    if (NEO6M_GetField(pSrc, 9)[0] == 'A')
+    {
+        NEO6M_ConvertGPVTG(pSrc, pGPVTG_Info, fields);
+
+        status = PARSE_SUCC;
+    }
+
+    return status;
+}
+#endif
+
+#if (NEO6M_CFG_ENABLE_GPRMC != 0)
+/**
+  * @brief      This function converts the selected fields of a valid GPRMC string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPRMC_Info         Pointer to GPRMC_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     None
+  */
+static void NEO6M_ConvertGPRMC(NEO6M_Source_t const* pSrc, GPRMC_Info_t* pGPRMC_Info, const uint16_t fields)
+{
+    if ((fields & NEO6M_FIELD_TIME) != 0U)
+    {
+        pGPRMC_Info->time   = NEO6M_ConvertStr2TimeFormat(NEO6M_GetField(pSrc, 1));
+    }
+
+    if ((fields & NEO6M_FIELD_DATE) != 0U)
+    {
+        pGPRMC_Info->date   = NEO6M_ConvertDateField(pSrc, NEO6M_CACHE_RMC_DATE, 9);
+    }
+
+    if ((fields & NEO6M_FIELD_LAT) != 0U)
+    {
+        pGPRMC_Info->lat    = NEO6M_ConvertCoordField(pSrc, NEO6M_CACHE_RMC_LAT, 3);
+    }
+
+    if ((fields & NEO6M_FIELD_LNG) != 0U)
+    {
+        pGPRMC_Info->lng    = NEO6M_ConvertCoordField(pSrc, NEO6M_CACHE_RMC_LNG, 5);
+    }
+}
+
+/**
+  * @brief      Function that makes the parsing of the GPRMC string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPRMC_Info         Pointer to GPRMC_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     PARSE_SUCC if the parsing process goes ok, PARSE_FAIL if it doesn't
+  */
+static ParseStatus_t NEO6M_ParseGPRMC(NEO6M_Source_t const* pSrc, GPRMC_Info_t* pGPRMC_Info, const uint16_t fields)
+{
+    ParseStatus_t status    = PARSE_FAIL;
+
+    (void)memset(pGPRMC_Info, 0, sizeof(GPRMC_Info_t));
+    pGPRMC_Info->present = NEO6M_GetPresent(pSrc);
+
+    if (NEO6M_GetField(pSrc, 2)[0] == 'A')
+    {
+        NEO6M_ConvertGPRMC(pSrc, pGPRMC_Info, fields);
+
+        status = PARSE_SUCC;
+    }
+
+    return status;
+}
+#endif
+
+#if (NEO6M_CFG_ENABLE_GPGGA != 0)
+/**
+  * @brief      This function converts the selected fields of a valid GPGGA string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPGGA_Info         Pointer to GPGGA_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     None
+  */
+static void NEO6M_ConvertGPGGA(NEO6M_Source_t const* pSrc, GPGGA_Info_t* pGPGGA_Info, const uint16_t fields)
+{
+    if ((fields & NEO6M_FIELD_TIME) != 0U)
+    {
+        pGPGGA_Info->time       = NEO6M_ConvertStr2TimeFormat(NEO6M_GetField(pSrc, 1));
+    }
+
+    if ((fields & NEO6M_FIELD_LAT) != 0U)
+    {
+        pGPGGA_Info->lat        = NEO6M_ConvertCoordField(pSrc, NEO6M_CACHE_GGA_LAT, 2);
+    }
+
+    if ((fields & NEO6M_FIELD_LNG) != 0U)
+    {
+        pGPGGA_Info->lng        = NEO6M_ConvertCoordField(pSrc, NEO6M_CACHE_GGA_LNG, 4);
+    }
+
+    if ((fields & NEO6M_FIELD_SATS) != 0U)
+    {
+        pGPGGA_Info->numSats    = (uint8_t)NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 7));
+    }
+
+    if ((fields & NEO6M_FIELD_DOP) != 0U)
+    {
+        pGPGGA_Info->hdop       = NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 8));
+    }
+
+    if ((fields & NEO6M_FIELD_ALT) != 0U)
+    {
+        pGPGGA_Info->alt        = NEO6M_ConvertStr2Int32(NEO6M_GetField(pSrc, 9));
+    }
+}
+
+/**
+  * @brief      Function that makes the parsing of the GPGGA string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPGGA_Info         Pointer to GPGGA_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     PARSE_SUCC if the parsing process goes ok, PARSE_FAIL if it doesn't
+  */
+static ParseStatus_t NEO6M_ParseGPGGA(NEO6M_Source_t const* pSrc, GPGGA_Info_t* pGPGGA_Info, const uint16_t fields)
+{
+    ParseStatus_t status    = PARSE_FAIL;
+    char const* quality     = NEO6M_GetField(pSrc, 6);
+
+    (void) memset(pGPGGA_Info, 0, sizeof(GPGGA_Info_t));
+    pGPGGA_Info->present = NEO6M_GetPresent(pSrc);
+
+    if ((quality[0] > '0') && (quality[0] <= '9'))
+    {
+        pGPGGA_Info->quality    = (uint8_t)(quality[0] - '0');
+
+        NEO6M_ConvertGPGGA(pSrc, pGPGGA_Info, fields);
+
+        status = PARSE_SUCC;
+    }
+
+    return status;
+}
+#endif
+
+#if (NEO6M_CFG_ENABLE_GPGSA != 0)
+/**
+  * @brief      This function converts the selected fields of a valid GPGSA string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPGSA_Info         Pointer to GPGSA_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     None
+  */
+static void NEO6M_ConvertGPGSA(NEO6M_Source_t const* pSrc, GPGSA_Info_t* pGPGSA_Info, const uint16_t fields)
+{
+    uint8_t index;
+
+    if ((fields & NEO6M_FIELD_SATS) != 0U)
+    {
+        for (index = 0U; index < GPGSA_MAX_SV; index++)
+        {
+            pGPGSA_Info->sv[index] = (uint8_t)NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 3U + index));
+        }
+    }
+
+    if ((fields & NEO6M_FIELD_DOP) != 0U)
+    {
+        pGPGSA_Info->pdop       = NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 15));
+        pGPGSA_Info->hdop       = NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 16));
+        pGPGSA_Info->vdop       = NEO6M_ConvertStr2Uint32(NEO6M_GetField(pSrc, 17));
+    }
+}
+
+/**
+  * @brief      Function that makes the parsing of the GPGSA string.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pGPGSA_Info         Pointer to GPGSA_Info_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     PARSE_SUCC if the parsing process goes ok, PARSE_FAIL if it doesn't
+  */
+static ParseStatus_t NEO6M_ParseGPGSA(NEO6M_Source_t const* pSrc, GPGSA_Info_t* pGPGSA_Info, const uint16_t fields)
+{
+    ParseStatus_t status    = PARSE_FAIL;
+    char const* fixType     = NEO6M_GetField(pSrc, 2);
+
+    (void) memset(pGPGSA_Info, 0, sizeof(GPGSA_Info_t));
+    pGPGSA_Info->present = NEO6M_GetPresent(pSrc);
+
+    if ((fixType[0] == '2') || (fixType[0] == '3'))
+    {
+        pGPGSA_Info->mode       = NEO6M_GetField(pSrc, 1)[0];
+        pGPGSA_Info->fixType    = (uint8_t)(fixType[0] - '0');
+
+        NEO6M_ConvertGPGSA(pSrc, pGPGSA_Info, fields);
+
+        status = PARSE_SUCC;
+    }
+
+    return status;
+}
+#endif
+
+#if NEO6M_NEED_DECODE
+/**
+  * @brief      This function identifies the sentence type of a tokenized line and runs its decoder.
+  * @param[in]  pSrc                Pointer to field source
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits, 0 for the validity fields only
+  * @retval     PARSE_SUCC if a supported sentence is valid, PARSE_FAIL if not
+  */
+static ParseStatus_t NEO6M_Decode(NEO6M_Source_t const* pSrc, GPS_Sentence_t *pSentence, const uint16_t fields)
+{
+    ParseStatus_t parsed    = PARSE_FAIL;
+    char const*   header    = NEO6M_GetField(pSrc, 0);
+
+#if (NEO6M_CFG_ENABLE_GPRMC != 0)
+    if (NEO6M_CheckHeaderMsg(header, "GPRMC") == NEO6M_OK)
+    {
+        pSentence->type = SENTENCE_GPRMC;
+        parsed = NEO6M_ParseGPRMC(pSrc, &pSentence->info.rmc, fields);
+    }
+    else
+#endif
+#if (NEO6M_CFG_ENABLE_GPVTG != 0)
+    if (NEO6M_CheckHeaderMsg(header, "GPVTG") == NEO6M_OK)
+    {
+        pSentence->type = SENTENCE_GPVTG;
+        parsed = NEO6M_ParseGPVTG(pSrc, &pSentence->info.vtg, fields);
+    }
+    else
+#endif
+#if (NEO6M_CFG_ENABLE_GPGGA != 0)
+    if (NEO6M_CheckHeaderMsg(header, "GPGGA") == NEO6M_OK)
+    {
+        pSentence->type = SENTENCE_GPGGA;
+        parsed = NEO6M_ParseGPGGA(pSrc, &pSentence->info.gga, fields);
+    }
+    else
+#endif
+#if (NEO6M_CFG_ENABLE_GPGSA != 0)
+    if (NEO6M_CheckHeaderMsg(header, "GPGSA") == NEO6M_OK)
+    {
+        pSentence->type = SENTENCE_GPGSA;
+        parsed = NEO6M_ParseGPGSA(pSrc, &pSentence->info.gsa, fields);
+    }
+    else
+#endif
+    {
+        /* Do nothing */
+    }
+
+    return parsed;
+}
+#endif
+
+#if NEO6M_NEED_TIME
+/**
+  * @brief      This function checks a decoded time.
+  * @param[in]  pTime               Pointer to time
+  * @retval     1 if in range, 0 if not
+  */
+static uint8_t NEO6M_TimeInRange(Time_Info_t const* pTime)
+{
+    return ((pTime->hr <= 23U) && (pTime->min <= 59U) && (pTime->sec <= 60U)) ? 1U : 0U;
+}
+#endif
+
+#if NEO6M_NEED_DECODE
+/**
+  * @brief      This function finds the first field of a valid sentence whose decoded value is
+  *             out of range. Only the fields a fix must carry are checked.
+  * @param[in]  pSentence           Pointer to decoded sentence
+  * @param[out] pField              Pointer to index of the field, 0 if none is out of range
+  * @retval     NEO6M_ERR_NONE, or NEO6M_ERR_FIELD
+  */
+static NEO6M_Error_t NEO6M_CheckFields(GPS_Sentence_t const* pSentence, uint8_t *pField)
+{
+    NEO6M_Error_t error;
+    uint8_t field       = 0U;
+
+#if (NEO6M_CFG_ENABLE_GPRMC != 0)
+    if (pSentence->type == SENTENCE_GPRMC)
+    {
+        if (NEO6M_TimeInRange(&pSentence->info.rmc.time) == 0U)
+        {
+            field = 1U;
+        }
+        else if (pSentence->info.rmc.lat.pole == 'I')
+        {
+            field = 3U;
+        }
+        else if (pSentence->info.rmc.lng.pole == 'I')
+        {
+            field = 5U;
+        }
+        else if ((pSentence->info.rmc.date.day == 0U) || (pSentence->info.rmc.date.day > 31U)
+                 || (pSentence->info.rmc.date.month == 0U) || (pSentence->info.rmc.date.month > 12U))
+        {
+            field = 9U;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+#endif
+#if (NEO6M_CFG_ENABLE_GPGGA != 0)
+    if (pSentence->type == SENTENCE_GPGGA)
+    {
+        if (NEO6M_TimeInRange(&pSentence->info.gga.time) == 0U)
+        {
+            field = 1U;
+        }
+        else if (pSentence->info.gga.lat.pole == 'I')
+        {
+            field = 2U;
+        }
+        else if (pSentence->info.gga.lng.pole == 'I')
+        {
+            field = 4U;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+#endif
+#if ((NEO6M_CFG_ENABLE_GPRMC == 0) && (NEO6M_CFG_ENABLE_GPGGA == 0))
+    (void) pSentence;
+#endif
+
+    error   = (field != 0U) ? NEO6M_ERR_FIELD : NEO6M_ERR_NONE;
+    *pField = field;
+
+    return error;
+}
+#endif
+
+/**
+  * @brief      This function tokenizes and decodes one sentence.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[in]  len                 Bytes in rawMessage, or NEO6M_LEN_UNBOUNDED
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @param[out] pField              NULL for a lenient parse. Otherwise the parse is strict: a line
+  *                                 whose frame is not sound (see NEO6M_ParseGPSMsg) or whose
+  *                                 fields are out of range (see NEO6M_CheckFields) is rejected,
+  *                                 and the index of such a field is written here, 0 if none
+  * @retval     NEO6M_ERR_NONE if a supported sentence was decoded, the fault of the line if it
+  *             was not tokenized or, when strict, not sound, NEO6M_ERR_UNKNOWN_TYPE or
+  *             NEO6M_ERR_NO_FIX if not decoded, NEO6M_ERR_FIELD if strict and out of range
+  */
+static NEO6M_Error_t NEO6M_ParseSentence(NEO6M_Ctx_t *pCtx, char const* const rawMessage, const uint32_t len, GPS_Sentence_t *pSentence, const uint16_t fields, uint8_t *pField)
+{
+    NEO6M_Error_t error  = NEO6M_ERR_TRUNCATED;
+    NEO6M_Error_t frame;
+#if NEO6M_NEED_DECODE
+    NEO6M_Source_t src   = {pCtx, NULL, NULL, 0U, 0U};
+#endif
+    NEO6M_STATS_BEGIN(start);
+
+    pSentence->type = SENTENCE_UNKNOWN;
+
+    if ((NEO6M_ParseGPSMsg(pCtx, rawMessage, len, fields, &frame) == PARSE_FAIL)
+        || ((pField != NULL) && (frame != NEO6M_ERR_NONE)))
+    {
+        error = frame;
+    }
+    else
+    {
+#if NEO6M_NEED_DECODE
+        if (NEO6M_Decode(&src, pSentence, fields) == PARSE_SUCC)
+        {
+            /* Range checked before the stats, so a rejected line counts as failed */
+            error = (pField != NULL) ? NEO6M_CheckFields(pSentence, pField) : NEO6M_ERR_NONE;
+        }
+        else
+        {
+            error = (pSentence->type == SENTENCE_UNKNOWN) ? NEO6M_ERR_UNKNOWN_TYPE : NEO6M_ERR_NO_FIX;
+        }
+#else
+        (void) fields;
+        error = NEO6M_ERR_UNKNOWN_TYPE;
+#endif
+    }
+
+    /* Clean list */
+    NEO6M_FreeList(pCtx);
+
+    NEO6M_STATS_END(&pCtx->stats, start, pSentence->type, error == NEO6M_ERR_NONE);
+
+    return error;
+}
+
+/**
+  * @brief      This function indexes the fields of a line in a table of 1-byte offsets,
+  *             writing NUL over ',' and '\r'. It follows the rules of NEO6M_ParseGPSMsg
+  *             but allocates nothing. line may be rawMessage itself.
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[out] line                Pointer to line, GPS_LAZY_LINE_LENGTH bytes at least
+  * @param[out] field               Pointer to offset table
+  * @param[in]  maxFields           Entries in the table; later fields are not indexed
+  * @param[out] pFieldNum           Pointer to number of fields indexed
+  * @param[out] pPresent            Pointer to NEO6M_PRESENT bits of the line
+  * @retval     PARSE_SUCC if the line ends with '\r' within the limit, PARSE_FAIL if not
+  */
+static ParseStatus_t NEO6M_TokenizeTable(char const* const rawMessage, char *line, uint8_t *field, const uint8_t maxFields, uint8_t *pFieldNum, uint32_t *pPresent)
+{
+    ParseStatus_t status    = PARSE_FAIL;
+    uint8_t fieldNum        = 1U;
+    uint8_t current         = 0U;       /* Field of index, indexed or not */
+    uint8_t begin           = 0U;       /* Index of its first character */
+    uint32_t present        = 0U;
+    uint8_t index;
+
+    field[0] = 0U;
+
+    for (index = 0U; index < MAX_RAW_STRING_LENGTH; index++)
+    {
+        if (rawMessage[index] == '\r')
+        {
+            line[index] = '\0';
+            status = PARSE_SUCC;
+
+            /* Break the loop */
+            break;
+        }
+        else if ((rawMessage[index] < ' ') || (rawMessage[index] > '~'))
+        {
+            /* String ended before '\r', or line noise. Do not scan the rest */
+            break;
+        }
+        else if (rawMessage[index] == ',')
+        {
+            line[index] = '\0';
+            current++;
+            begin = index + 1U;
+
+            /* Fields past the table are never decoded */
+            if (fieldNum < maxFields)
+            {
+                field[fieldNum] = index + 1U;
+                fieldNum++;
+            }
+        }
+        else
+        {
+            line[index] = rawMessage[index];
+
+            if ((index == begin) && (rawMessage[index] != '*') && (current < 32U))
+            {
+                present |= NEO6M_PRESENT(current);
+            }
+        }
+    }
+
+    *pFieldNum  = fieldNum;
+    *pPresent   = present;
+
+    return status;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      GPS Neo 6M Api function.
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[out] pGPS_Neo6M          Pointer to void struct
+  * @retval     NEO6M_OK if OK, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_Api(char const* const rawMessage, void *pGPS_Neo6M)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    NEO6M_Ctx_t  *pCtx   = &g_defaultCtx;
+    SentenceType_t type  = SENTENCE_UNKNOWN;
+    NEO6M_Error_t frame;                        /* Not checked, as ever */
+#if ((NEO6M_CFG_ENABLE_GPRMC != 0) || (NEO6M_CFG_ENABLE_GPVTG != 0))
+    NEO6M_Source_t src   = {pCtx, NULL, NULL, 0U, 0U};
+#endif
+    NEO6M_STATS_BEGIN(start);
+
+    if (NEO6M_ParseGPSMsg(pCtx, rawMessage, NEO6M_LEN_UNBOUNDED, NEO6M_FIELD_ALL, &frame) != PARSE_FAIL)
+    {
+#if (NEO6M_CFG_ENABLE_GPVTG != 0)
+        if (NEO6M_CheckHeaderMsg(NEO6M_GetField(&src, 0), "GPVTG") == NEO6M_OK)
+        {
+            type   = SENTENCE_GPVTG;
+            status = ((NEO6M_ParseGPVTG(&src, (GPVTG_Info_t*)pGPS_Neo6M, NEO6M_FIELD_ALL) == PARSE_SUCC) ? NEO6M_OK : NEO6M_NOK);
+        }
+        else
+#endif
+#if (NEO6M_CFG_ENABLE_GPRMC != 0)
+        if (NEO6M_CheckHeaderMsg(NEO6M_GetField(&src, 0), "GPRMC") == NEO6M_OK)
+        {
+            type   = SENTENCE_GPRMC;
+            status = ((NEO6M_ParseGPRMC(&src, (GPRMC_Info_t*)pGPS_Neo6M, NEO6M_FIELD_ALL) == PARSE_SUCC) ? NEO6M_OK : NEO6M_NOK);
+        }
+        else
+#endif
+        {
+            /* Do nothing */
+        }
+    }
+
+    /* Clean list */
+    NEO6M_FreeList(pCtx);
+
+    NEO6M_STATS_END(&pCtx->stats, start, type, status == NEO6M_OK);
+
+    return status;
+}
+
+/**
+  * @brief      This function initializes a parser context. A context must not be used by two
+  *             threads at the same time; give each parsing thread its own.
+  * @param[out] pCtx                Pointer to parser context
+  * @retval     None
+  */
+void NEO6M_GPSNeo6_InitCtx(NEO6M_Ctx_t *pCtx)
+{
+    pCtx->pHead     = NULL;
+    pCtx->fieldNum  = 0U;
+    pCtx->present   = 0U;
+
+#if (NEO6M_CFG_FIELD_CACHE != 0)
+    (void) memset(&pCtx->cache, 0, sizeof(NEO6M_Cache_t));
+#endif
+
+#if (NEO6M_CFG_STATIC_POOL != 0)
+    pCtx->pool.nodeUsed = 0U;
+    pCtx->pool.dataUsed = 0U;
+#endif
+
+#if (NEO6M_STATS_ENABLE != 0)
+    NEO6M_Stats_Reset(&pCtx->stats);
+#endif
+}
+
+/**
+  * @brief      GPS Neo 6M typed parse function. Unlike NEO6M_GPSNeo6_Api the caller does not
+  *             need to know the sentence type in advance: it is reported in pSentence->type.
+  *             Uses the default context, so it must only be called from one thread.
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct
+  * @retval     NEO6M_OK if a supported sentence was decoded, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_ParseSentence(char const* const rawMessage, GPS_Sentence_t *pSentence)
+{
+    return NEO6M_GPSNeo6_ParseSentenceCtx(&g_defaultCtx, rawMessage, pSentence);
+}
+
+/**
+  * @brief      Re-entrant variant of NEO6M_GPSNeo6_ParseSentence working on a caller-owned context.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct
+  * @retval     NEO6M_OK if a supported sentence was decoded, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_ParseSentenceCtx(NEO6M_Ctx_t *pCtx, char const* const rawMessage, GPS_Sentence_t *pSentence)
+{
+    return NEO6M_GPSNeo6_ParseSentenceFields(pCtx, rawMessage, pSentence, NEO6M_FIELD_ALL);
+}
+
+/**
+  * @brief      Variant of NEO6M_GPSNeo6_ParseSentenceCtx that decodes only the selected
+  *             fields. The others are neither copied out of the line nor converted and
+  *             read as 0. Validity is judged exactly as with every field selected.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct
+  * @param[in]  fields              NEO6M_FIELD_* bits, e.g. NEO6M_FIELD_POSITION
+  * @retval     NEO6M_OK if a supported sentence was decoded, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_ParseSentenceFields(NEO6M_Ctx_t *pCtx, char const* const rawMessage, GPS_Sentence_t *pSentence, const uint16_t fields)
+{
+    return (NEO6M_ParseSentence(pCtx, rawMessage, NEO6M_LEN_UNBOUNDED, pSentence, fields, NULL) == NEO6M_ERR_NONE) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      Variant of NEO6M_GPSNeo6_ParseSentenceCtx that verifies the checksum and tells
+  *             why a line was rejected, so failures can be counted without a second parse.
+  *             The checksum is accumulated while the line is tokenized and the line is only
+  *             decoded if its frame is sound; a decoded sentence then costs a few range
+  *             compares more. Unlike the other entry points, the "*hh" checksum is required:
+  *             a line without it is rejected with NEO6M_ERR_CHECKSUM. Only the time and
+  *             position of RMC and GGA and the date of RMC are range checked; VTG and GSA
+  *             never return NEO6M_ERR_FIELD. A line rejected for a field counts as failed in
+  *             the decode statistics.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct
+  * @param[out] pField              Pointer to index of the field behind NEO6M_ERR_FIELD, 0 for
+  *                                 any other result; may be NULL
+  * @retval     NEO6M_ERR_NONE if a supported sentence was decoded, the reason if not
+  */
+NEO6M_Error_t NEO6M_GPSNeo6_ParseSentenceErr(NEO6M_Ctx_t *pCtx, char const* const rawMessage, GPS_Sentence_t *pSentence, uint8_t *pField)
+{
+    uint8_t field       = 0U;
+    NEO6M_Error_t error = NEO6M_ParseSentence(pCtx, rawMessage, NEO6M_LEN_UNBOUNDED, pSentence, NEO6M_FIELD_ALL, &field);
+
+    if (error == NEO6M_ERR_CHECKSUM)
+    {
+        NEO6M_STATS_CHECKSUM_FAIL(&pCtx->stats);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (pField != NULL)
+    {
+        *pField = field;
+    }
+
+    return error;
+}
+
+/**
+  * @brief      Variant of NEO6M_GPSNeo6_ParseSentenceCtx for a buffer of known length that
+  *             need not be terminated. The line ends at the first of len, '\r', '\n' or '*',
+  *             and at most min(len, 100) bytes are read, so the tokenizer runs a bounded
+  *             number of iterations whatever the buffer holds. Field copies still go through
+  *             malloc, whose time depends on the allocator.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  rawMessage          Pointer to line, starting with '$'
+  * @param[in]  len                 Bytes readable at rawMessage; more than 100 without a
+  *                                 terminator in the first 100 is an overlong line
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct
+  * @retval     NEO6M_OK if a supported sentence was decoded, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_ParseSentenceLen(NEO6M_Ctx_t *pCtx, char const* const rawMessage, const uint32_t len, GPS_Sentence_t *pSentence)
+{
+    return (NEO6M_ParseSentence(pCtx, rawMessage, len, pSentence, NEO6M_FIELD_ALL, NULL) == NEO6M_ERR_NONE) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      This function verifies the checksum of a NMEA sentence ("$...*hh").
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @retval     NEO6M_OK if the checksum matches, NEO6M_NOK if it doesn't or is missing
+  */
+CheckStatus_t NEO6M_GPSNeo6_VerifyChecksum(char const* const rawMessage)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    uint8_t checksum     = 0U;
+    uint8_t received     = 0U;
+    uint8_t nibble;
+    uint8_t digit;
+    uint8_t index;
+
+    if (rawMessage[0] == '$')
+    {
+        for (index = 1U; index < (MAX_RAW_STRING_LENGTH - 2U); index++)
+        {
+            if ((rawMessage[index] == '*') || (rawMessage[index] == '\0')
+                || (rawMessage[index] == '\r') || (rawMessage[index] == '\n'))
+            {
+                break;
+            }
+
+            checksum ^= (uint8_t)rawMessage[index];
+        }
+
+        if (rawMessage[index] == '*')
+        {
+            status = NEO6M_OK;
+
+            for (digit = 1U; digit <= 2U; digit++)
+            {
+                nibble = NEO6M_HexDigit(rawMessage[index + digit]);
+
+                if (nibble > 0x0FU)
+                {
+                    status = NEO6M_NOK;
+                    break;
+                }
+
+                received = (uint8_t)((received << 4) | nibble);
+            }
+
+            if (received != checksum)
+            {
+                status = NEO6M_NOK;
+            }
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      Variant of NEO6M_GPSNeo6_VerifyChecksum that counts rejected lines in the
+  *             statistics of a context.
+  * @param[in]  pCtx                Pointer to parser context
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @retval     NEO6M_OK if the checksum matches, NEO6M_NOK if it doesn't or is missing
+  */
+CheckStatus_t NEO6M_GPSNeo6_VerifyChecksumCtx(NEO6M_Ctx_t *pCtx, char const* const rawMessage)
+{
+    CheckStatus_t status = NEO6M_GPSNeo6_VerifyChecksum(rawMessage);
+
+    if (status != NEO6M_OK)
+    {
+        NEO6M_STATS_CHECKSUM_FAIL(&pCtx->stats);
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function returns the decode statistics of a context.
+  * @param[in]  pCtx                Pointer to parser context, NULL for the context of
+  *                                 NEO6M_GPSNeo6_Api and NEO6M_GPSNeo6_ParseSentence
+  * @retval     Pointer to counters, NULL if built without NEO6M_STATS_ENABLE
+  */
+NEO6M_Stats_t* NEO6M_GPSNeo6_GetStats(NEO6M_Ctx_t *pCtx)
+{
+    NEO6M_Stats_t *pStats = NULL;
+
+#if (NEO6M_STATS_ENABLE != 0)
+    pStats = (pCtx != NULL) ? &pCtx->stats : &g_defaultCtx.stats;
+#else
+    (void) pCtx;
+#endif
+
+    return pStats;
+}
+
+/**
+  * @brief      Lazy parse: copies and tokenizes the line and judges its validity now, and
+  *             converts nothing else until a field is asked for. A sentence that is dropped
+  *             after the type check costs one pass over the line and no heap.
+  * @param[out] pLazy               Pointer to lazy sentence
+  * @param[in]  rawMessage          Pointer to string read by UART
+  * @retval     NEO6M_OK if a supported sentence is valid, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_LazyParse(GPS_Lazy_t *pLazy, char const* const rawMessage)
+{
+    ParseStatus_t parsed = PARSE_FAIL;
+    uint32_t      present;
+#if NEO6M_NEED_DECODE
+    NEO6M_Source_t src;
+#endif
+
+    (void) memset(&pLazy->sentence, 0, sizeof(GPS_Sentence_t));
+    pLazy->converted = 0U;
+
+    if (NEO6M_TokenizeTable(rawMessage, pLazy->line, pLazy->field, GPS_LAZY_MAX_FIELDS, &pLazy->fieldNum, &present) == PARSE_SUCC)
+    {
+#if NEO6M_NEED_DECODE
+        /* Decode the fields that decide validity only */
+        src     = (NEO6M_Source_t){NULL, pLazy->line, pLazy->field, pLazy->fieldNum, present};
+        parsed  = NEO6M_Decode(&src, &pLazy->sentence, 0U);
+#endif
+    }
+
+    pLazy->valid = (parsed == PARSE_SUCC) ? 1U : 0U;
+
+    return (parsed == PARSE_SUCC) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      This function converts the selected fields of a lazy sentence that were not
+  *             converted before. Each field is converted at most once per line.
+  * @param[in]  pLazy               Pointer to lazy sentence
+  * @param[in]  fields              NEO6M_FIELD_* bits
+  * @retval     Pointer to the decoded sentence; fields never asked for read as 0
+  */
+GPS_Sentence_t const* NEO6M_GPSNeo6_LazyGet(GPS_Lazy_t *pLazy, const uint16_t fields)
+{
+    uint16_t pending     = (uint16_t)(fields & (uint16_t)~pLazy->converted);
+#if NEO6M_NEED_DECODE
+    NEO6M_Source_t src   = {NULL, pLazy->line, pLazy->field, pLazy->fieldNum, 0U};
+#endif
+
+    if ((pLazy->valid != 0U) && (pending != 0U))
+    {
+        switch (pLazy->sentence.type)
+        {
+#if (NEO6M_CFG_ENABLE_GPRMC != 0)
+            case SENTENCE_GPRMC:
+                NEO6M_ConvertGPRMC(&src, &pLazy->sentence.info.rmc, pending);
+                break;
+#endif
+#if (NEO6M_CFG_ENABLE_GPVTG != 0)
+            case SENTENCE_GPVTG:
+                NEO6M_ConvertGPVTG(&src, &pLazy->sentence.info.vtg, pending);
+                break;
+#endif
+#if (NEO6M_CFG_ENABLE_GPGGA != 0)
+            case SENTENCE_GPGGA:
+                NEO6M_ConvertGPGGA(&src, &pLazy->sentence.info.gga, pending);
+                break;
+#endif
+#if (NEO6M_CFG_ENABLE_GPGSA != 0)
+            case SENTENCE_GPGSA:
+                NEO6M_ConvertGPGSA(&src, &pLazy->sentence.info.gsa, pending);
+                break;
+#endif
+            default:
+                /* Do nothing */
+                break;
+        }
+
+        pLazy->converted |= pending;
+    }
+
+    return &pLazy->sentence;
+}
+
+/**
+  * @brief      This function returns the UTC time of a lazy RMC or GGA sentence.
+  * @param[in]  pLazy               Pointer to lazy sentence
+  * @param[out] pTime               Pointer to time
+  * @retval     NEO6M_OK if the sentence is valid and carries a time, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_LazyGetTime(GPS_Lazy_t *pLazy, Time_Info_t *pTime)
+{
+    CheckStatus_t status            = NEO6M_NOK;
+    GPS_Sentence_t const* pSentence = NEO6M_GPSNeo6_LazyGet(pLazy, NEO6M_FIELD_TIME);
+
+    if (pLazy->valid == 0U)
+    {
+        /* Do nothing */
+    }
+    else if (pSentence->type == SENTENCE_GPRMC)
+    {
+        *pTime = pSentence->info.rmc.time;
+        status = NEO6M_OK;
+    }
+    else if (pSentence->type == SENTENCE_GPGGA)
+    {
+        *pTime = pSentence->info.gga.time;
+        status = NEO6M_OK;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function returns the date of a lazy RMC sentence.
+  * @param[in]  pLazy               Pointer to lazy sentence
+  * @param[out] pDate               Pointer to date
+  * @retval     NEO6M_OK if the sentence is valid and carries a date, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_LazyGetDate(GPS_Lazy_t *pLazy, Date_Info_t *pDate)
+{
+    CheckStatus_t status            = NEO6M_NOK;
+    GPS_Sentence_t const* pSentence = NEO6M_GPSNeo6_LazyGet(pLazy, NEO6M_FIELD_DATE);
+
+    if ((pLazy->valid != 0U) && (pSentence->type == SENTENCE_GPRMC))
+    {
+        *pDate = pSentence->info.rmc.date;
+        status = NEO6M_OK;
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function returns the position of a lazy RMC or GGA sentence.
+  * @param[in]  pLazy               Pointer to lazy sentence
+  * @param[out] pLat                Pointer to latitude
+  * @param[out] pLng                Pointer to longitude
+  * @retval     NEO6M_OK if the sentence is valid and carries a position, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_LazyGetPosition(GPS_Lazy_t *pLazy, Coord_Info_t *pLat, Coord_Info_t *pLng)
+{
+    CheckStatus_t status            = NEO6M_NOK;
+    GPS_Sentence_t const* pSentence = NEO6M_GPSNeo6_LazyGet(pLazy, NEO6M_FIELD_POSITION);
+
+    if (pLazy->valid == 0U)
+    {
+        /* Do nothing */
+    }
+    else if (pSentence->type == SENTENCE_GPRMC)
+    {
+        *pLat  = pSentence->info.rmc.lat;
+        *pLng  = pSentence->info.rmc.lng;
+        status = NEO6M_OK;
+    }
+    else if (pSentence->type == SENTENCE_GPGGA)
+    {
+        *pLat  = pSentence->info.gga.lat;
+        *pLng  = pSentence->info.gga.lng;
+        status = NEO6M_OK;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return status;
+}
+
+/**
+  * @brief      In-place parse for targets short of RAM: the delimiters of the caller's line
+  *             are overwritten with NUL and only 1-byte offsets are kept, so nothing is
+  *             copied or allocated. The fields stay readable through
+  *             NEO6M_GPSNeo6_InPlaceField until the line buffer is reused.
+  * @param[out] pTok                Pointer to in-place tokenizer state
+  * @param[in]  line                Pointer to line read by UART, modified
+  * @param[out] pSentence           Pointer to GPS_Sentence_t struct, NULL to tokenize only
+  * @param[in]  fields              NEO6M_FIELD_* bits to decode into pSentence
+  * @retval     NEO6M_OK if a supported sentence is valid (or the line tokenized, when
+  *             pSentence is NULL), NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_GPSNeo6_ParseInPlace(GPS_InPlace_t *pTok, char *line, GPS_Sentence_t *pSentence, const uint16_t fields)
+{
+    ParseStatus_t parsed = PARSE_FAIL;
+    uint32_t      present;
+#if NEO6M_NEED_DECODE
+    NEO6M_Source_t src;
+#endif
+
+    pTok->line = line;
+
+    if (pSentence != NULL)
+    {
+        pSentence->type = SENTENCE_UNKNOWN;
+    }
+
+    parsed = NEO6M_TokenizeTable(line, line, pTok->field, GPS_INPLACE_MAX_FIELDS, &pTok->fieldNum, &present);
+
+    if ((parsed == PARSE_SUCC) && (pSentence != NULL))
+    {
+#if NEO6M_NEED_DECODE
+        src     = (NEO6M_Source_t){NULL, line, pTok->field, pTok->fieldNum, present};
+        parsed  = NEO6M_Decode(&src, pSentence, fields);
+#else
+        (void) fields;
+        parsed  = PARSE_FAIL;
+#endif
+    }
+
+    return (parsed == PARSE_SUCC) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      This function returns a field of a line tokenized in place.
+  * @param[in]  pTok                Pointer to in-place tokenizer state
+  * @param[in]  fieldIndex          Index of field, 0 is the header
+  * @retval     Pointer to field, or to an empty string if the line has fewer fields
+  */
+char const* NEO6M_GPSNeo6_InPlaceField(GPS_InPlace_t const* pTok, const uint8_t fieldIndex)
+{
+    return (fieldIndex < pTok->fieldNum) ? &pTok->line[pTok->field[fieldIndex]] : g_emptyField;
 }
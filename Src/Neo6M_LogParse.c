@@ -0,0 +1,523 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_LogParse.c
+  * @author  Huy Nguyen
+  * @brief   Parallel chunked parser for recorded NMEA logs for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Neo6M_LogParse.h"
+
+/* Private define ------------------------------------------------------------*/
+#define LOGPARSE_NO_CHUNK                   UINT32_MAX      /* Nothing left to take */
+#define LOGPARSE_INITIAL_RECORDS            64U             /* First allocation of a chunk */
+
+/**
+ * @brief Data structure that contains the lines of one chunk and what they decoded to
+*/
+typedef struct
+{
+    LogParse_Record_t*  records;    /* Decoded sentences */
+    uint64_t            count;      /* Records */
+    uint64_t            capacity;   /* Allocated records */
+    uint64_t            lines;      /* Lines starting with '$' */
+    uint64_t            failures;   /* Lines that did not decode */
+    uint64_t            skipped;    /* Lines too long */
+    uint64_t            begin;      /* First byte, a line start */
+    uint64_t            end;        /* One past the last byte, a line start or the log size */
+    uint8_t             noMemory;   /* A record could not be stored */
+} LogParse_Chunk_t;
+
+/**
+ * @brief Data structure that contains the chunks queued to one worker. The owner takes
+ *        from the front, idle workers steal from the back.
+*/
+typedef struct
+{
+    pthread_mutex_t     lock;       /* Protects begin and end */
+    uint32_t            begin;      /* Next chunk of the owner */
+    uint32_t            end;        /* One past the last queued chunk */
+} LogParse_Deque_t;
+
+/**
+ * @brief Data structure that contains a parallel run
+*/
+typedef struct
+{
+    char const*         data;                           /* Log */
+    uint64_t            size;                           /* Log size */
+    LogParse_Chunk_t*   chunks;                         /* Chunks in log order */
+    LogParse_Deque_t    deques[LOGPARSE_MAX_THREADS];   /* One per worker */
+    uint16_t            threads;                        /* Workers */
+} LogParse_Pool_t;
+
+/**
+ * @brief Data structure that contains the argument of one worker
+*/
+typedef struct
+{
+    LogParse_Pool_t*    pPool;      /* Run */
+    uint16_t            index;      /* Worker index, also its deque */
+} LogParse_Worker_t;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function returns the first line start at or after pos whose line
+  *             begins with '$'. Chunks only start there, so every line belongs to exactly
+  *             one chunk and is parsed as in the serial path.
+  * @param[in]  data                Pointer to log
+  * @param[in]  size                Log size
+  * @param[in]  pos                 Candidate position
+  * @retval     Aligned position, size if there is none
+  */
+static uint64_t NEO6M_LogParse_Align(char const* data, const uint64_t size, uint64_t pos)
+{
+    char const* pNewline;
+
+    if (pos > 0U)
+    {
+        while (pos < size)
+        {
+            /* Next line start at or after pos */
+            pNewline = (char const*) memchr(&data[pos - 1U], '\n', size - (pos - 1U));
+
+            if (pNewline == NULL)
+            {
+                pos = size;
+            }
+            else
+            {
+                pos = (uint64_t)(pNewline - data) + 1U;
+
+                if ((pos < size) && (data[pos] == '$'))
+                {
+                    break;
+                }
+
+                pos++;
+            }
+        }
+
+        if (pos > size)
+        {
+            pos = size;
+        }
+    }
+
+    return pos;
+}
+
+/**
+  * @brief      This function parses the lines of one chunk.
+  * @param[in]  pCtx                Pointer to parser context of the calling thread
+  * @param[in]  data                Pointer to log
+  * @param[in]  size                Log size
+  * @param[out] pChunk              Pointer to chunk, begin and end already set
+  * @retval     None
+  */
+static void NEO6M_LogParse_Chunk(NEO6M_Ctx_t *pCtx, char const* data, const uint64_t size, LogParse_Chunk_t *pChunk)
+{
+    char                line[LOGPARSE_MAX_LINE_LENGTH + 1U];
+    LogParse_Record_t*  pGrown;
+    LogParse_Record_t*  pRecord;
+    char const*         pNewline;
+    uint64_t            pos = pChunk->begin;
+    uint64_t            len;
+
+    while ((pos < pChunk->end) && (pChunk->noMemory == 0U))
+    {
+        pNewline    = (char const*) memchr(&data[pos], '\n', size - pos);
+        len         = (pNewline != NULL) ? ((uint64_t)(pNewline - &data[pos]) + 1U) : (size - pos);
+
+        if (data[pos] == '$')
+        {
+            pChunk->lines++;
+
+            if (len > LOGPARSE_MAX_LINE_LENGTH)
+            {
+                pChunk->skipped++;
+            }
+            else
+            {
+                if (pChunk->count == pChunk->capacity)
+                {
+                    pChunk->capacity = (pChunk->capacity == 0U) ? LOGPARSE_INITIAL_RECORDS : (pChunk->capacity * 2U);
+                    pGrown = (LogParse_Record_t*) realloc(pChunk->records, pChunk->capacity * sizeof(LogParse_Record_t));
+
+                    if (pGrown == NULL)
+                    {
+                        pChunk->noMemory = 1U;
+                        break;
+                    }
+
+                    pChunk->records = pGrown;
+                }
+
+                (void) memcpy(line, &data[pos], len);
+                line[len] = '\0';
+
+                pRecord = &pChunk->records[pChunk->count];
+                (void) memset(pRecord, 0, sizeof(LogParse_Record_t));
+                pRecord->offset = pos;
+
+                if (NEO6M_GPSNeo6_ParseSentenceCtx(pCtx, line, &pRecord->sentence) == NEO6M_OK)
+                {
+                    pChunk->count++;
+                }
+                else
+                {
+                    pChunk->failures++;
+                }
+            }
+        }
+
+        pos += len;
+    }
+}
+
+/**
+  * @brief      This function concatenates the chunks, in log order, into the result.
+  * @param[in]  pChunks             Pointer to chunks
+  * @param[in]  chunkCount          Number of chunks
+  * @param[out] pResult             Pointer to result
+  * @retval     NEO6M_OK if merged, NEO6M_NOK if memory ran out
+  */
+static CheckStatus_t NEO6M_LogParse_Merge(LogParse_Chunk_t *pChunks, const uint32_t chunkCount, LogParse_Result_t *pResult)
+{
+    CheckStatus_t status = NEO6M_OK;
+    uint64_t total = 0U;
+    uint32_t index;
+
+    (void) memset(pResult, 0, sizeof(LogParse_Result_t));
+
+    for (index = 0U; index < chunkCount; index++)
+    {
+        total += pChunks[index].count;
+
+        if (pChunks[index].noMemory != 0U)
+        {
+            status = NEO6M_NOK;
+        }
+    }
+
+    if ((status == NEO6M_OK) && (total > 0U))
+    {
+        pResult->records = (LogParse_Record_t*) malloc(total * sizeof(LogParse_Record_t));
+
+        if (pResult->records == NULL)
+        {
+            status = NEO6M_NOK;
+        }
+    }
+
+    for (index = 0U; index < chunkCount; index++)
+    {
+        if ((status == NEO6M_OK) && (pChunks[index].count > 0U))
+        {
+            (void) memcpy(&pResult->records[pResult->count], pChunks[index].records,
+                          pChunks[index].count * sizeof(LogParse_Record_t));
+        }
+
+        pResult->count      += pChunks[index].count;
+        pResult->lines      += pChunks[index].lines;
+        pResult->failures   += pChunks[index].failures;
+        pResult->skipped    += pChunks[index].skipped;
+
+        free(pChunks[index].records);
+        pChunks[index].records = NULL;
+    }
+
+    if (status != NEO6M_OK)
+    {
+        NEO6M_LogParse_Free(pResult);
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function takes the next chunk for a worker: the front of its own deque,
+  *             else the back of another worker's deque.
+  * @param[in]  pPool               Pointer to run
+  * @param[in]  worker              Worker index
+  * @retval     Chunk index, LOGPARSE_NO_CHUNK when every deque is empty
+  */
+static uint32_t NEO6M_LogParse_Take(LogParse_Pool_t *pPool, const uint16_t worker)
+{
+    LogParse_Deque_t *pDeque;
+    uint32_t chunk = LOGPARSE_NO_CHUNK;
+    uint16_t offset;
+
+    for (offset = 0U; (offset < pPool->threads) && (chunk == LOGPARSE_NO_CHUNK); offset++)
+    {
+        pDeque = &pPool->deques[(worker + offset) % pPool->threads];
+
+        (void) pthread_mutex_lock(&pDeque->lock);
+
+        if (pDeque->begin < pDeque->end)
+        {
+            if (offset == 0U)
+            {
+                chunk = pDeque->begin++;
+            }
+            else
+            {
+                chunk = --pDeque->end;
+            }
+        }
+
+        (void) pthread_mutex_unlock(&pDeque->lock);
+    }
+
+    return chunk;
+}
+
+/**
+  * @brief      Worker thread: parses chunks until none are left anywhere.
+  * @param[in]  pArg                Pointer to LogParse_Worker_t
+  * @retval     NULL
+  */
+static void* NEO6M_LogParse_Worker(void *pArg)
+{
+    LogParse_Worker_t *pWorker = (LogParse_Worker_t*)pArg;
+    LogParse_Pool_t   *pPool   = pWorker->pPool;
+    NEO6M_Ctx_t ctx;
+    uint32_t chunk;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    for (chunk = NEO6M_LogParse_Take(pPool, pWorker->index);
+         chunk != LOGPARSE_NO_CHUNK;
+         chunk = NEO6M_LogParse_Take(pPool, pWorker->index))
+    {
+        NEO6M_LogParse_Chunk(&ctx, pPool->data, pPool->size, &pPool->chunks[chunk]);
+    }
+
+    return NULL;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function parses a log on the calling thread. A line starts at the
+  *             beginning of the log or after '\n' and is only parsed when it starts with '$'.
+  * @param[in]  data                Pointer to log
+  * @param[in]  size                Log size
+  * @param[out] pResult             Pointer to result
+  * @retval     NEO6M_OK if parsed, NEO6M_NOK if memory ran out
+  */
+CheckStatus_t NEO6M_LogParse_Buffer(char const* data, const uint64_t size, LogParse_Result_t *pResult)
+{
+    LogParse_Chunk_t chunk;
+    NEO6M_Ctx_t ctx;
+
+    (void) memset(&chunk, 0, sizeof(chunk));
+    chunk.end = size;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+    NEO6M_LogParse_Chunk(&ctx, data, size, &chunk);
+
+    return NEO6M_LogParse_Merge(&chunk, 1U, pResult);
+}
+
+/**
+  * @brief      This function parses a log on a work-stealing pool. The log is cut every
+  *             chunkSize bytes, each cut moved to the next line starting with '$'. The result
+  *             is identical to NEO6M_LogParse_Buffer.
+  * @param[in]  data                Pointer to log
+  * @param[in]  size                Log size
+  * @param[in]  threads             Worker threads, 0 for one per online core
+  * @param[in]  chunkSize           Bytes per chunk, 0 for LOGPARSE_DEFAULT_CHUNK
+  * @param[out] pResult             Pointer to result
+  * @retval     NEO6M_OK if parsed, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_LogParse_BufferParallel(char const* data, const uint64_t size, const uint16_t threads,
+                                            const uint64_t chunkSize, LogParse_Result_t *pResult)
+{
+    CheckStatus_t       status = NEO6M_NOK;
+    LogParse_Pool_t     pool;
+    LogParse_Worker_t   workers[LOGPARSE_MAX_THREADS];
+    pthread_t           handles[LOGPARSE_MAX_THREADS];
+    uint8_t             created[LOGPARSE_MAX_THREADS];  /* 1 if handles[n] is a live thread */
+    uint64_t            step    = (chunkSize > 0U) ? chunkSize : LOGPARSE_DEFAULT_CHUNK;
+    uint64_t            pos     = 0U;
+    uint32_t            chunkCount = 0U;
+    uint32_t            perWorker;
+    uint16_t            started = 0U;
+    uint16_t            index;
+    long                cores;
+
+    (void) memset(&pool, 0, sizeof(pool));
+    (void) memset(pResult, 0, sizeof(LogParse_Result_t));
+
+    pool.data       = data;
+    pool.size       = size;
+    pool.threads    = threads;
+
+    if (pool.threads == 0U)
+    {
+        cores = sysconf(_SC_NPROCESSORS_ONLN);
+        pool.threads = (cores > 0) ? (uint16_t)cores : 1U;
+    }
+
+    if (pool.threads > LOGPARSE_MAX_THREADS)
+    {
+        pool.threads = LOGPARSE_MAX_THREADS;
+    }
+
+    pool.chunks = (LogParse_Chunk_t*) calloc((size / step) + 1U, sizeof(LogParse_Chunk_t));
+
+    if (pool.chunks != NULL)
+    {
+        while (pos < size)
+        {
+            pool.chunks[chunkCount].begin   = pos;
+            pos                             = NEO6M_LogParse_Align(data, size, ((size - pos) > step) ? (pos + step) : size);
+            pool.chunks[chunkCount].end     = pos;
+            chunkCount++;
+        }
+
+        /* Each worker starts on a contiguous run of chunks */
+        perWorker = (chunkCount + pool.threads - 1U) / pool.threads;
+
+        for (index = 0U; index < pool.threads; index++)
+        {
+            (void) pthread_mutex_init(&pool.deques[index].lock, NULL);
+            pool.deques[index].begin    = (index * perWorker < chunkCount) ? (index * perWorker) : chunkCount;
+            pool.deques[index].end      = ((index + 1U) * perWorker < chunkCount) ? ((index + 1U) * perWorker) : chunkCount;
+        }
+
+        for (index = 0U; index < pool.threads; index++)
+        {
+            workers[index].pPool = &pool;
+            workers[index].index = index;
+
+            created[index] = (pthread_create(&handles[index], NULL, NEO6M_LogParse_Worker, &workers[index]) == 0) ? 1U : 0U;
+            started += created[index];
+        }
+
+        if (started == 0U)
+        {
+            /* No thread could be created: parse everything here */
+            (void) NEO6M_LogParse_Worker(&workers[0]);
+        }
+
+        /* Workers that started steal the chunks of those that did not */
+        for (index = 0U; index < pool.threads; index++)
+        {
+            if (created[index] != 0U)
+            {
+                (void) pthread_join(handles[index], NULL);
+            }
+
+            (void) pthread_mutex_destroy(&pool.deques[index].lock);
+        }
+
+        status = NEO6M_LogParse_Merge(pool.chunks, chunkCount, pResult);
+
+        free(pool.chunks);
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function maps a log file and parses it.
+  * @param[in]  path                Path of the log
+  * @param[in]  threads             Worker threads, 0 for one per online core, 1 for the serial path
+  * @param[out] pResult             Pointer to result
+  * @retval     NEO6M_OK if parsed, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_LogParse_File(char const* const path, const uint16_t threads, LogParse_Result_t *pResult)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    struct stat info;
+    void  *pMap;
+    int    fd;
+
+    (void) memset(pResult, 0, sizeof(LogParse_Result_t));
+
+    fd = open(path, O_RDONLY);
+
+    if (fd >= 0)
+    {
+        if (fstat(fd, &info) == 0)
+        {
+            if (info.st_size == 0)
+            {
+                status = NEO6M_OK;
+            }
+            else
+            {
+                pMap = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if (pMap != MAP_FAILED)
+                {
+                    (void) madvise(pMap, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+                    if (threads == 1U)
+                    {
+                        status = NEO6M_LogParse_Buffer((char const*)pMap, (uint64_t)info.st_size, pResult);
+                    }
+                    else
+                    {
+                        status = NEO6M_LogParse_BufferParallel((char const*)pMap, (uint64_t)info.st_size,
+                                                               threads, 0U, pResult);
+                    }
+
+                    (void) munmap(pMap, (size_t)info.st_size);
+                }
+            }
+        }
+
+        (void) close(fd);
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function releases the records of a result.
+  * @param[in]  pResult             Pointer to result
+  * @retval     None
+  */
+void NEO6M_LogParse_Free(LogParse_Result_t *pResult)
+{
+    free(pResult->records);
+    (void) memset(pResult, 0, sizeof(LogParse_Result_t));
+}
@@ -0,0 +1,485 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_NmeaGen.c
+  * @author  Huy Nguyen
+  * @brief   Deterministic synthetic NMEA stream generator for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+
+#include "Neo6M_NmeaGen.h"
+
+/* Private define ------------------------------------------------------------*/
+#define NMEAGEN_METRES_PER_DEGREE           111320.0        /* Along a meridian */
+#define NMEAGEN_KNOTS_PER_MPS               1.943844        /* m/s to knots */
+#define NMEAGEN_KPH_PER_MPS                 3.6             /* m/s to km/h */
+#define NMEAGEN_MS_PER_DAY                  86400000U       /* Milliseconds in a day */
+#define NMEAGEN_SV_PER_GSV                  4U              /* Satellites per GSV sentence */
+#define NMEAGEN_MAX_PRN                     32U             /* GPS PRN range */
+#define NMEAGEN_FIELD_LENGTH                24U             /* Formatted time or coordinate */
+#define NMEAGEN_MAX_LAT                     85.0            /* The walk turns back before the poles */
+#define NMEAGEN_MAX_BODY_LENGTH             (NMEAGEN_MAX_SENTENCE_LENGTH - 5U)  /* Room for "*hh\r\n" */
+
+/* Private variables ---------------------------------------------------------*/
+static const char    g_hexDigits[]  = "0123456789ABCDEF";
+static const uint8_t g_monthDays[]  = {31U, 28U, 31U, 30U, 31U, 30U, 31U, 31U, 30U, 31U, 30U, 31U};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function returns the next number of the xorshift64* generator.
+  * @param[in]  pCtx                Pointer to generator
+  * @retval     Pseudo random number
+  */
+static uint64_t NEO6M_NmeaGen_Random(NmeaGen_Ctx_t *pCtx)
+{
+    uint64_t x = pCtx->rng;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    pCtx->rng = x;
+
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+  * @brief      This function returns a pseudo random number below a limit.
+  * @param[in]  pCtx                Pointer to generator
+  * @param[in]  limit               Exclusive upper bound, not 0
+  * @retval     Number in [0, limit)
+  */
+static uint32_t NEO6M_NmeaGen_Below(NmeaGen_Ctx_t *pCtx, const uint32_t limit)
+{
+    return (uint32_t)(NEO6M_NmeaGen_Random(pCtx) % limit);
+}
+
+/**
+  * @brief      This function returns a pseudo random number in [-1, 1).
+  * @param[in]  pCtx                Pointer to generator
+  * @retval     Number
+  */
+static double NEO6M_NmeaGen_Signed(NmeaGen_Ctx_t *pCtx)
+{
+    return ((double)(NEO6M_NmeaGen_Random(pCtx) >> 11) / (double)(1ULL << 52)) - 1.0;
+}
+
+/**
+  * @brief      This function formats a coordinate as NMEA "(d)ddmm.mmmmm,H".
+  * @param[out] outBuf              Pointer to output buffer
+  * @param[in]  outSize             Size of output buffer
+  * @param[in]  degrees             Signed degrees
+  * @param[in]  isLng               0 for latitude, 1 for longitude
+  * @retval     None
+  */
+static void NEO6M_NmeaGen_FormatCoord(char *outBuf, const size_t outSize, const double degrees, const uint8_t isLng)
+{
+    double   magnitude  = (degrees < 0.0) ? -degrees : degrees;
+    uint64_t units      = (uint64_t)((magnitude * 6000000.0) + 0.5);   /* 1e-5 minutes */
+    uint32_t whole      = (uint32_t)(units / 6000000U);
+    uint32_t minutes    = (uint32_t)(units % 6000000U);
+    char     hemisphere;
+
+    if (isLng != 0U)
+    {
+        hemisphere = (degrees < 0.0) ? 'W' : 'E';
+        (void) snprintf(outBuf, outSize, "%03u%02u.%05u,%c", whole, minutes / 100000U, minutes % 100000U, hemisphere);
+    }
+    else
+    {
+        hemisphere = (degrees < 0.0) ? 'S' : 'N';
+        (void) snprintf(outBuf, outSize, "%02u%02u.%05u,%c", whole, minutes / 100000U, minutes % 100000U, hemisphere);
+    }
+}
+
+/**
+  * @brief      This function wraps a longitude into [-180, 180).
+  * @param[in]  degrees             Longitude, degrees
+  * @retval     Wrapped longitude
+  */
+static double NEO6M_NmeaGen_WrapLng(const double degrees)
+{
+    double wrapped = fmod(degrees + 180.0, 360.0);
+
+    return ((wrapped < 0.0) ? (wrapped + 360.0) : wrapped) - 180.0;
+}
+
+/**
+  * @brief      This function advances the date by one day.
+  * @param[in]  pCtx                Pointer to generator
+  * @retval     None
+  */
+static void NEO6M_NmeaGen_NextDay(NmeaGen_Ctx_t *pCtx)
+{
+    uint8_t days = g_monthDays[pCtx->month - 1U];
+
+    if ((pCtx->month == 2U) && ((pCtx->year % 4U) == 0U))
+    {
+        days++;
+    }
+
+    pCtx->day++;
+
+    if (pCtx->day > days)
+    {
+        pCtx->day = 1U;
+        pCtx->month++;
+
+        if (pCtx->month > 12U)
+        {
+            pCtx->month = 1U;
+            pCtx->year  = (uint8_t)((pCtx->year + 1U) % 100U);
+        }
+    }
+}
+
+/**
+  * @brief      This function moves the receiver along its trajectory by one epoch.
+  * @param[in]  pCtx                Pointer to generator
+  * @retval     None
+  */
+static void NEO6M_NmeaGen_Move(NmeaGen_Ctx_t *pCtx)
+{
+    double  dt      = (double)pCtx->config.epochMs / 1000.0;
+    double  limit   = 2.0 * ((double)pCtx->config.speedMmps / 1000.0);
+    double  fastest = (double)NMEAGEN_MAX_SPEED_MMPS / 1000.0;
+    double  radians;
+    uint8_t index;
+
+    /* Gentle turns and speed changes around the mean speed */
+    pCtx->heading  += NEO6M_NmeaGen_Signed(pCtx) * 5.0 * dt;
+    pCtx->heading   = fmod(pCtx->heading + 360.0, 360.0);
+    pCtx->speed    += NEO6M_NmeaGen_Signed(pCtx) * 0.5 * dt;
+    limit           = (limit > fastest) ? fastest : limit;
+    pCtx->speed     = (pCtx->speed < 0.0) ? 0.0 : ((pCtx->speed > limit) ? limit : pCtx->speed);
+    pCtx->alt      += NEO6M_NmeaGen_Signed(pCtx) * 0.2;
+
+    radians         = pCtx->heading * (M_PI / 180.0);
+    pCtx->lat      += (pCtx->speed * cos(radians) * dt) / NMEAGEN_METRES_PER_DEGREE;
+    pCtx->lng      += (pCtx->speed * sin(radians) * dt) / (NMEAGEN_METRES_PER_DEGREE * cos(pCtx->lat * (M_PI / 180.0)));
+
+    /* Bounce off the polar caps and wrap at the antimeridian, so coordinates stay valid */
+    if (pCtx->lat > NMEAGEN_MAX_LAT)
+    {
+        pCtx->lat       = (2.0 * NMEAGEN_MAX_LAT) - pCtx->lat;
+        pCtx->heading   = fmod(540.0 - pCtx->heading, 360.0);
+    }
+    else if (pCtx->lat < -NMEAGEN_MAX_LAT)
+    {
+        pCtx->lat       = (-2.0 * NMEAGEN_MAX_LAT) - pCtx->lat;
+        pCtx->heading   = fmod(540.0 - pCtx->heading, 360.0);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    pCtx->lng = NEO6M_NmeaGen_WrapLng(pCtx->lng);
+
+    for (index = 0U; index < pCtx->inView; index++)
+    {
+        /* SNR drifts by -2..+2 dBHz, wrapping inside 20..50 */
+        pCtx->snr[index] = (uint8_t)(20U + (((pCtx->snr[index] - 20U) + NEO6M_NmeaGen_Below(pCtx, 5U) + 29U) % 31U));
+    }
+
+    pCtx->timeMs += pCtx->config.epochMs;
+
+    if (pCtx->timeMs >= NMEAGEN_MS_PER_DAY)
+    {
+        pCtx->timeMs -= NMEAGEN_MS_PER_DAY;
+        NEO6M_NmeaGen_NextDay(pCtx);
+    }
+}
+
+/**
+  * @brief      This function finishes a sentence, applies corruption or truncation and
+  *             appends it to the output. A body longer than NMEAGEN_MAX_BODY_LENGTH is
+  *             dropped.
+  * @param[in]  pCtx                Pointer to generator
+  * @param[in]  sentence            Pointer to "$..." body, room for NMEAGEN_MAX_SENTENCE_LENGTH + 1
+  * @param[in]  bodyLen             Body length
+  * @param[out] outBuf              Pointer to output
+  * @param[in]  pLen                Bytes already in output, updated
+  * @retval     None
+  */
+static void NEO6M_NmeaGen_Emit(NmeaGen_Ctx_t *pCtx, char *sentence, const int bodyLen, char *outBuf, uint32_t *pLen)
+{
+    uint8_t len;
+    uint8_t index;
+    char    replacement;
+
+    /* A failed or truncated snprintf leaves a body that does not fit a sentence: drop it */
+    if ((bodyLen > 1) && (bodyLen <= (int)NMEAGEN_MAX_BODY_LENGTH))
+    {
+        len = NEO6M_NmeaGen_Finish(sentence, (uint8_t)bodyLen);
+
+        if (NEO6M_NmeaGen_Below(pCtx, 1000U) < pCtx->config.corruptPermille)
+        {
+            /* Change one body character, never into a frame delimiter */
+            index       = (uint8_t)(1U + NEO6M_NmeaGen_Below(pCtx, (uint32_t)bodyLen - 1U));
+            replacement = (char)(32 + (((sentence[index] - 32) + 1 + (int)NEO6M_NmeaGen_Below(pCtx, 94U)) % 95));
+
+            if ((replacement == '*') || (replacement == '$'))
+            {
+                replacement = (sentence[index] == '#') ? '%' : '#';
+            }
+
+            sentence[index] = replacement;
+            pCtx->corrupted++;
+        }
+
+        if (NEO6M_NmeaGen_Below(pCtx, 1000U) < pCtx->config.truncatePermille)
+        {
+            /* Cut anywhere before "\r\n", as when a capture or a UART drops bytes */
+            len = (uint8_t)(1U + NEO6M_NmeaGen_Below(pCtx, (uint32_t)len - 2U));
+            pCtx->truncated++;
+        }
+
+        (void) memcpy(&outBuf[*pLen], sentence, len);
+        *pLen += len;
+        pCtx->sentences++;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function fills a configuration with a 1 Hz walk, every sentence type,
+  *             no corruption.
+  * @param[out] pConfig             Pointer to configuration
+  * @retval     None
+  */
+void NEO6M_NmeaGen_DefaultConfig(NmeaGen_Config_t *pConfig)
+{
+    (void) memset(pConfig, 0, sizeof(NmeaGen_Config_t));
+
+    pConfig->seed           = 1U;
+    pConfig->startLatE7     = 107626000;
+    pConfig->startLngE7     = 1066600000;
+    pConfig->startTimeMs    = 8U * 3600000U;
+    pConfig->speedMmps      = 1500U;
+    pConfig->epochMs        = 1000U;
+    pConfig->sentenceMask   = NMEAGEN_ALL;
+    pConfig->day            = 1U;
+    pConfig->month          = 1U;
+    pConfig->year           = 24U;
+}
+
+/**
+  * @brief      This function initializes a generator.
+  * @param[out] pCtx                Pointer to generator
+  * @param[in]  pConfig             Pointer to configuration
+  * @retval     None
+  */
+void NEO6M_NmeaGen_Init(NmeaGen_Ctx_t *pCtx, NmeaGen_Config_t const* pConfig)
+{
+    uint32_t taken = 0U;
+    uint8_t  count;
+    uint8_t  prn;
+
+    (void) memset(pCtx, 0, sizeof(NmeaGen_Ctx_t));
+
+    pCtx->config    = *pConfig;
+    pCtx->lat       = fmax(fmin((double)pConfig->startLatE7 / 1e7, NMEAGEN_MAX_LAT), -NMEAGEN_MAX_LAT);
+    pCtx->lng       = NEO6M_NmeaGen_WrapLng((double)pConfig->startLngE7 / 1e7);
+    pCtx->alt       = 10.0;
+    pCtx->timeMs    = pConfig->startTimeMs % NMEAGEN_MS_PER_DAY;
+    pCtx->day       = ((pConfig->day > 0U) && (pConfig->day <= 28U)) ? pConfig->day : 1U;
+    pCtx->month     = ((pConfig->month > 0U) && (pConfig->month <= 12U)) ? pConfig->month : 1U;
+    pCtx->year      = pConfig->year % 100U;
+
+    if (pCtx->config.epochMs == 0U)
+    {
+        pCtx->config.epochMs = 1000U;
+    }
+
+    if (pCtx->config.speedMmps > NMEAGEN_MAX_SPEED_MMPS)
+    {
+        pCtx->config.speedMmps = NMEAGEN_MAX_SPEED_MMPS;
+    }
+
+    pCtx->speed     = (double)pCtx->config.speedMmps / 1000.0;
+
+    /* splitmix64 of the seed, so that 0 and neighbouring seeds give unrelated streams */
+    pCtx->rng = pConfig->seed + 0x9E3779B97F4A7C15ULL;
+    pCtx->rng = (pCtx->rng ^ (pCtx->rng >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    pCtx->rng = (pCtx->rng ^ (pCtx->rng >> 27)) * 0x94D049BB133111EBULL;
+    pCtx->rng = pCtx->rng ^ (pCtx->rng >> 31);
+
+    if (pCtx->rng == 0U)
+    {
+        pCtx->rng = 1U;
+    }
+
+    pCtx->heading   = (double)NEO6M_NmeaGen_Below(pCtx, 360U);
+    count           = (uint8_t)(8U + NEO6M_NmeaGen_Below(pCtx, NMEAGEN_MAX_SATS - 7U));
+
+    while (pCtx->inView < count)
+    {
+        prn = (uint8_t)(1U + NEO6M_NmeaGen_Below(pCtx, NMEAGEN_MAX_PRN));
+
+        if ((taken & (1UL << (prn - 1U))) == 0U)
+        {
+            taken |= (1UL << (prn - 1U));
+
+            pCtx->sv[pCtx->inView]          = prn;
+            pCtx->elevation[pCtx->inView]   = (uint8_t)(5U + NEO6M_NmeaGen_Below(pCtx, 81U));
+            pCtx->azimuth[pCtx->inView]     = (uint16_t)NEO6M_NmeaGen_Below(pCtx, 360U);
+            pCtx->snr[pCtx->inView]         = (uint8_t)(20U + NEO6M_NmeaGen_Below(pCtx, 31U));
+            pCtx->inView++;
+        }
+    }
+
+    pCtx->used = (uint8_t)(count - NEO6M_NmeaGen_Below(pCtx, 4U));
+}
+
+/**
+  * @brief      This function writes the sentences of one epoch, then moves the receiver.
+  * @param[in]  pCtx                Pointer to generator
+  * @param[out] outBuf              Pointer to output buffer, not NUL terminated
+  * @param[in]  outSize             Size of output buffer, at least NMEAGEN_MAX_EPOCH_LENGTH
+  * @retval     Bytes written, 0 if the buffer is too small
+  */
+uint32_t NEO6M_NmeaGen_NextEpoch(NmeaGen_Ctx_t *pCtx, char *outBuf, const uint32_t outSize)
+{
+    char     sentence[NMEAGEN_MAX_SENTENCE_LENGTH + 1U];
+    char     time[NMEAGEN_FIELD_LENGTH];
+    char     lat[NMEAGEN_FIELD_LENGTH];
+    char     lng[NMEAGEN_FIELD_LENGTH];
+    uint8_t  mask   = pCtx->config.sentenceMask;
+    double   hdop   = 0.5 + (6.0 / (double)pCtx->used);
+    double   vdop   = hdop * 1.4;
+    uint32_t len    = 0U;
+    uint32_t ms     = pCtx->timeMs;
+    uint8_t  msgs   = (uint8_t)((pCtx->inView + NMEAGEN_SV_PER_GSV - 1U) / NMEAGEN_SV_PER_GSV);
+    uint8_t  msg;
+    uint8_t  slot;
+    int      body;
+
+    if (outSize >= NMEAGEN_MAX_EPOCH_LENGTH)
+    {
+        (void) snprintf(time, sizeof(time), "%02u%02u%02u.%02u",
+                        ms / 3600000U, (ms / 60000U) % 60U, (ms / 1000U) % 60U, (ms / 10U) % 100U);
+        NEO6M_NmeaGen_FormatCoord(lat, sizeof(lat), pCtx->lat, 0U);
+        NEO6M_NmeaGen_FormatCoord(lng, sizeof(lng), pCtx->lng, 1U);
+
+        if ((mask & NMEAGEN_RMC) != 0U)
+        {
+            body = snprintf(sentence, sizeof(sentence), "$GPRMC,%s,A,%s,%s,%.3f,%.2f,%02u%02u%02u,,,A",
+                            time, lat, lng, pCtx->speed * NMEAGEN_KNOTS_PER_MPS, pCtx->heading,
+                            pCtx->day, pCtx->month, pCtx->year);
+            NEO6M_NmeaGen_Emit(pCtx, sentence, body, outBuf, &len);
+        }
+
+        if ((mask & NMEAGEN_VTG) != 0U)
+        {
+            body = snprintf(sentence, sizeof(sentence), "$GPVTG,%.2f,T,,M,%.3f,N,%.3f,K,A",
+                            pCtx->heading, pCtx->speed * NMEAGEN_KNOTS_PER_MPS, pCtx->speed * NMEAGEN_KPH_PER_MPS);
+            NEO6M_NmeaGen_Emit(pCtx, sentence, body, outBuf, &len);
+        }
+
+        if ((mask & NMEAGEN_GGA) != 0U)
+        {
+            body = snprintf(sentence, sizeof(sentence), "$GPGGA,%s,%s,%s,1,%02u,%.2f,%.1f,M,46.9,M,,",
+                            time, lat, lng, pCtx->used, hdop, pCtx->alt);
+            NEO6M_NmeaGen_Emit(pCtx, sentence, body, outBuf, &len);
+        }
+
+        if ((mask & NMEAGEN_GSA) != 0U)
+        {
+            body = snprintf(sentence, sizeof(sentence), "$GPGSA,A,3,");
+
+            for (slot = 0U; slot < GPGSA_MAX_SV; slot++)
+            {
+                if (slot < pCtx->used)
+                {
+                    body += snprintf(&sentence[body], sizeof(sentence) - (size_t)body, "%02u,", pCtx->sv[slot]);
+                }
+                else
+                {
+                    sentence[body++] = ',';
+                }
+            }
+
+            body += snprintf(&sentence[body], sizeof(sentence) - (size_t)body, "%.2f,%.2f,%.2f",
+                             sqrt((hdop * hdop) + (vdop * vdop)), hdop, vdop);
+            NEO6M_NmeaGen_Emit(pCtx, sentence, body, outBuf, &len);
+        }
+
+        if ((mask & NMEAGEN_GSV) != 0U)
+        {
+            for (msg = 0U; msg < msgs; msg++)
+            {
+                body = snprintf(sentence, sizeof(sentence), "$GPGSV,%u,%u,%02u", msgs, msg + 1U, pCtx->inView);
+
+                for (slot = msg * NMEAGEN_SV_PER_GSV; (slot < pCtx->inView) && (slot < ((msg + 1U) * NMEAGEN_SV_PER_GSV)); slot++)
+                {
+                    body += snprintf(&sentence[body], sizeof(sentence) - (size_t)body, ",%02u,%02u,%03u,%02u",
+                                     pCtx->sv[slot], pCtx->elevation[slot], pCtx->azimuth[slot], pCtx->snr[slot]);
+                }
+
+                NEO6M_NmeaGen_Emit(pCtx, sentence, body, outBuf, &len);
+            }
+        }
+
+        NEO6M_NmeaGen_Move(pCtx);
+    }
+
+    return len;
+}
+
+/**
+  * @brief      This function appends "*hh\r\n" and a NUL to a "$..." sentence body.
+  * @param[in]  sentence            Pointer to body, room for bodyLen + 6 characters
+  * @param[in]  bodyLen             Body length, starting with '$'
+  * @retval     Sentence length without NUL
+  */
+uint8_t NEO6M_NmeaGen_Finish(char *sentence, const uint8_t bodyLen)
+{
+    uint8_t checksum = 0U;
+    uint8_t index;
+
+    for (index = 1U; index < bodyLen; index++)
+    {
+        checksum ^= (uint8_t)sentence[index];
+    }
+
+    sentence[bodyLen]       = '*';
+    sentence[bodyLen + 1U]  = g_hexDigits[checksum >> 4];
+    sentence[bodyLen + 2U]  = g_hexDigits[checksum & 0x0FU];
+    sentence[bodyLen + 3U]  = '\r';
+    sentence[bodyLen + 4U]  = '\n';
+    sentence[bodyLen + 5U]  = '\0';
+
+    return (uint8_t)(bodyLen + 5U);
+}
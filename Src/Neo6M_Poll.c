@@ -0,0 +1,261 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Poll.c
+  * @author  Huy Nguyen
+  * @brief   On-demand GPQ/UBX polling mode for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_Poll.h"
+
+/* Private define ------------------------------------------------------------*/
+#define POLL_GPQ_PREFIX                     "$EIGPQ,"   /* Poll request sent to the receiver */
+#define POLL_GPQ_PREFIX_LENGTH              7U          /* Length of POLL_GPQ_PREFIX */
+#define POLL_SENTENCE_LENGTH                3U          /* Sentence id length, e.g. "RMC" */
+#define POLL_NMEA_MESSAGES                  6U          /* Periodic NMEA messages of the Neo 6M */
+
+/* Private variables ---------------------------------------------------------*/
+
+/* CFG-MSG payloads (class, id, rate on current port) that stop the periodic NMEA output */
+static const uint8_t g_disableMsg[POLL_NMEA_MESSAGES][3] =
+{
+    {UBX_CLASS_NMEA, 0x00U, 0x00U},     /* GGA */
+    {UBX_CLASS_NMEA, 0x01U, 0x00U},     /* GLL */
+    {UBX_CLASS_NMEA, 0x02U, 0x00U},     /* GSA */
+    {UBX_CLASS_NMEA, 0x03U, 0x00U},     /* GSV */
+    {UBX_CLASS_NMEA, 0x04U, 0x00U},     /* RMC */
+    {UBX_CLASS_NMEA, 0x05U, 0x00U}      /* VTG */
+};
+
+static const char g_hexDigits[] = "0123456789ABCDEF";
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function builds a GPQ poll request, e.g. "$EIGPQ,RMC*3A\r\n".
+  * @param[in]  sentence            Pointer to 3-character sentence id
+  * @param[out] outBuf              Pointer to output buffer, NUL terminated
+  * @param[in]  outSize             Size of output buffer, at least POLL_GPQ_MAX_LENGTH
+  * @retval     Length of the request without NUL, 0 on error
+  */
+uint8_t NEO6M_Poll_BuildGPQ(char const* const sentence, char *outBuf, const uint8_t outSize)
+{
+    uint8_t checksum = 0U;
+    uint8_t len      = 0U;
+    uint8_t index;
+
+    if ((outSize >= POLL_GPQ_MAX_LENGTH) && (strlen(sentence) == POLL_SENTENCE_LENGTH))
+    {
+        (void) memcpy(outBuf, POLL_GPQ_PREFIX, POLL_GPQ_PREFIX_LENGTH);
+        (void) memcpy(&outBuf[POLL_GPQ_PREFIX_LENGTH], sentence, POLL_SENTENCE_LENGTH);
+        len = POLL_GPQ_PREFIX_LENGTH + POLL_SENTENCE_LENGTH;
+
+        for (index = 1U; index < len; index++)
+        {
+            checksum ^= (uint8_t)outBuf[index];
+        }
+
+        outBuf[len++] = '*';
+        outBuf[len++] = g_hexDigits[checksum >> 4];
+        outBuf[len++] = g_hexDigits[checksum & 0x0FU];
+        outBuf[len++] = '\r';
+        outBuf[len++] = '\n';
+        outBuf[len]   = '\0';
+    }
+
+    return len;
+}
+
+/**
+  * @brief      This function queues the CFG-MSG commands that set the rate of every periodic
+  *             NMEA message to 0, so the receiver only talks when polled.
+  * @param[in]  pSession            Pointer to configuration session
+  * @retval     NEO6M_OK if all commands were queued, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_Poll_QueueDisablePeriodic(UBXCfg_Session_t *pSession)
+{
+    CheckStatus_t status = NEO6M_OK;
+    uint8_t index;
+
+    for (index = 0U; index < POLL_NMEA_MESSAGES; index++)
+    {
+        if (NEO6M_UBXCfg_Add(pSession, UBX_CLASS_CFG, UBX_ID_CFG_MSG, g_disableMsg[index],
+                             sizeof(g_disableMsg[index])) != NEO6M_OK)
+        {
+            status = NEO6M_NOK;
+        }
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function initializes a polling context.
+  * @param[out] pCtx                Pointer to polling context
+  * @param[in]  writeFn             Transmit callback
+  * @param[in]  tickFn              Millisecond tick callback
+  * @param[in]  pUser               User data passed to callbacks
+  * @retval     None
+  */
+void NEO6M_Poll_Init(Poll_Ctx_t *pCtx, NEO6M_WriteFn_t writeFn, NEO6M_TickFn_t tickFn, void *pUser)
+{
+    (void) memset(pCtx, 0, sizeof(Poll_Ctx_t));
+
+    pCtx->writeFn   = writeFn;
+    pCtx->tickFn    = tickFn;
+    pCtx->pUser     = pUser;
+    pCtx->status    = POLL_IDLE;
+}
+
+/**
+  * @brief      This function sends a GPQ request for one NMEA sentence.
+  * @param[in]  pCtx                Pointer to polling context
+  * @param[in]  sentence            Pointer to 3-character sentence id, e.g. "RMC"
+  * @param[in]  timeoutMs           Reply timeout
+  * @retval     NEO6M_OK if the request was sent, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_Poll_RequestNmea(Poll_Ctx_t *pCtx, char const* const sentence, const uint32_t timeoutMs)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    char    request[POLL_GPQ_MAX_LENGTH];
+    uint8_t len;
+
+    len = NEO6M_Poll_BuildGPQ(sentence, request, sizeof(request));
+
+    if (len > 0U)
+    {
+        (void) memcpy(pCtx->sentence, sentence, POLL_SENTENCE_LENGTH + 1U);
+        pCtx->line[0]   = '\0';
+        pCtx->isUbx     = 0U;
+        pCtx->timeoutMs = timeoutMs;
+        pCtx->startTick = pCtx->tickFn(pCtx->pUser);
+        pCtx->status    = POLL_PENDING;
+
+        pCtx->writeFn(pCtx->pUser, (uint8_t const*)request, len);
+
+        status = NEO6M_OK;
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function sends a UBX poll request (empty payload) for one message.
+  * @param[in]  pCtx                Pointer to polling context
+  * @param[in]  cls                 Message class
+  * @param[in]  id                  Message id
+  * @param[in]  timeoutMs           Reply timeout
+  * @retval     NEO6M_OK if the request was sent, NEO6M_NOK if not
+  */
+CheckStatus_t NEO6M_Poll_RequestUbx(Poll_Ctx_t *pCtx, const uint8_t cls, const uint8_t id, const uint32_t timeoutMs)
+{
+    uint8_t  request[UBX_FRAME_OVERHEAD];
+    uint16_t len;
+
+    len = NEO6M_UBX_EncodeFrame(cls, id, NULL, 0U, request, sizeof(request));
+
+    pCtx->ubxCls    = cls;
+    pCtx->ubxId     = id;
+    pCtx->isUbx     = 1U;
+    pCtx->timeoutMs = timeoutMs;
+    pCtx->startTick = pCtx->tickFn(pCtx->pUser);
+    pCtx->status    = POLL_PENDING;
+
+    pCtx->writeFn(pCtx->pUser, request, len);
+
+    return NEO6M_OK;
+}
+
+/**
+  * @brief      This function offers an NMEA line from the streaming parser to a pending request.
+  *             The talker is ignored, so "$GPRMC" and "$GNRMC" both answer "RMC". Only a
+  *             line with a valid checksum answers the request.
+  * @param[in]  pCtx                Pointer to polling context
+  * @param[in]  line                Pointer to NMEA line
+  * @param[in]  len                 Line length
+  * @retval     None
+  */
+void NEO6M_Poll_OnLine(Poll_Ctx_t *pCtx, char const* line, const uint8_t len)
+{
+    if ((pCtx->status == POLL_PENDING)
+        && (pCtx->isUbx == 0U)
+        && (len > 7U)
+        && (len <= STREAM_MAX_LINE_LENGTH)
+        && (memcmp(&line[3], pCtx->sentence, POLL_SENTENCE_LENGTH) == 0)
+        && (line[6] == ',')
+    )
+    {
+        (void) memcpy(pCtx->line, line, len);
+        pCtx->line[len] = '\0';
+
+        /* A corrupted reply is not the answer; the request stays pending for a good one */
+        if (NEO6M_GPSNeo6_VerifyChecksum(pCtx->line) == NEO6M_OK)
+        {
+            pCtx->status = POLL_DONE;
+        }
+    }
+}
+
+/**
+  * @brief      This function offers a UBX frame from the streaming parser to a pending request.
+  * @param[in]  pCtx                Pointer to polling context
+  * @param[in]  pFrame              Pointer to frame
+  * @retval     None
+  */
+void NEO6M_Poll_OnFrame(Poll_Ctx_t *pCtx, UBX_Frame_t const* pFrame)
+{
+    if ((pCtx->status == POLL_PENDING)
+        && (pCtx->isUbx != 0U)
+        && (pFrame->cls == pCtx->ubxCls)
+        && (pFrame->id == pCtx->ubxId)
+        && (pFrame->len > 0U)
+    )
+    {
+        pCtx->frame     = *pFrame;
+        pCtx->status    = POLL_DONE;
+    }
+}
+
+/**
+  * @brief      This function reports the state of the request, expiring it when overdue.
+  * @param[in]  pCtx                Pointer to polling context
+  * @retval     PollStatus_t
+  */
+PollStatus_t NEO6M_Poll_Check(Poll_Ctx_t *pCtx)
+{
+    if ((pCtx->status == POLL_PENDING)
+        && ((pCtx->tickFn(pCtx->pUser) - pCtx->startTick) >= pCtx->timeoutMs)
+    )
+    {
+        pCtx->status = POLL_TIMEOUT;
+    }
+
+    return pCtx->status;
+}
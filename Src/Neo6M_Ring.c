@@ -0,0 +1,257 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Ring.c
+  * @author  Huy Nguyen
+  * @brief   Lock-free single-producer/single-consumer byte ring for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_Ring.h"
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function returns the free space seen by the producer. The consumer
+  *             tail is only re-read (acquire) when the cached copy shows too little space.
+  * @param[in]  pRing               Pointer to ring
+  * @param[in]  head                Current head
+  * @param[in]  needed              Space the producer wants
+  * @retval     Free bytes
+  */
+static uint32_t NEO6M_Ring_FreeSpace(Ring_t *pRing, const uint32_t head, const uint32_t needed)
+{
+    uint32_t space = (pRing->mask + 1U) - (head - pRing->cachedTail);
+
+    if (space < needed)
+    {
+        pRing->cachedTail   = __atomic_load_n(&pRing->tail, __ATOMIC_ACQUIRE);
+        space               = (pRing->mask + 1U) - (head - pRing->cachedTail);
+    }
+
+    return space;
+}
+
+/**
+  * @brief      This function returns the bytes available to the consumer. The producer
+  *             head is only re-read (acquire) when the cached copy shows too little data.
+  * @param[in]  pRing               Pointer to ring
+  * @param[in]  tail                Current tail
+  * @param[in]  wanted              Bytes the consumer wants
+  * @retval     Available bytes
+  */
+static uint32_t NEO6M_Ring_Available(Ring_t *pRing, const uint32_t tail, const uint32_t wanted)
+{
+    if ((pRing->cachedHead - tail) < wanted)
+    {
+        pRing->cachedHead = __atomic_load_n(&pRing->head, __ATOMIC_ACQUIRE);
+    }
+
+    return pRing->cachedHead - tail;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function initializes an empty ring over a caller-owned buffer.
+  * @param[out] pRing               Pointer to ring
+  * @param[in]  buffer              Pointer to storage
+  * @param[in]  size                Storage size, a power of two
+  * @retval     NEO6M_OK if initialized, NEO6M_NOK if size is not a power of two
+  */
+CheckStatus_t NEO6M_Ring_Init(Ring_t *pRing, uint8_t *buffer, const uint32_t size)
+{
+    CheckStatus_t status = NEO6M_NOK;
+
+    (void) memset(pRing, 0, sizeof(Ring_t));
+
+    if ((size >= 2U) && ((size & (size - 1U)) == 0U))
+    {
+        pRing->buffer   = buffer;
+        pRing->mask     = size - 1U;
+
+        status = NEO6M_OK;
+    }
+
+    return status;
+}
+
+/**
+  * @brief      Producer side: copies bytes into the ring. Bytes that do not fit are dropped
+  *             and counted, the producer never waits for the consumer.
+  * @param[in]  pRing               Pointer to ring
+  * @param[in]  data                Pointer to bytes
+  * @param[in]  len                 Number of bytes
+  * @retval     Number of bytes stored
+  */
+uint32_t NEO6M_Ring_Push(Ring_t *pRing, uint8_t const* data, const uint32_t len)
+{
+    uint32_t head  = __atomic_load_n(&pRing->head, __ATOMIC_RELAXED);
+    uint32_t count = NEO6M_Ring_FreeSpace(pRing, head, len);
+    uint32_t offset;
+    uint32_t first;
+
+    if (count > len)
+    {
+        count = len;
+    }
+
+    if (count < len)
+    {
+        /* Only the producer writes them; the stores are atomic for readers on other threads */
+        __atomic_store_n(&pRing->overrunBytes,
+                         __atomic_load_n(&pRing->overrunBytes, __ATOMIC_RELAXED) + (len - count), __ATOMIC_RELAXED);
+        __atomic_store_n(&pRing->overrunEvents,
+                         __atomic_load_n(&pRing->overrunEvents, __ATOMIC_RELAXED) + 1U, __ATOMIC_RELAXED);
+    }
+
+    if (count > 0U)
+    {
+        offset  = head & pRing->mask;
+        first   = (pRing->mask + 1U) - offset;
+
+        if (first > count)
+        {
+            first = count;
+        }
+
+        (void) memcpy(&pRing->buffer[offset], data, first);
+        (void) memcpy(pRing->buffer, &data[first], count - first);
+
+        /* Publish the bytes to the consumer */
+        __atomic_store_n(&pRing->head, head + count, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/**
+  * @brief      Producer side: stores one byte, e.g. from a UART RX interrupt.
+  * @param[in]  pRing               Pointer to ring
+  * @param[in]  byte                Received byte
+  * @retval     NEO6M_OK if stored, NEO6M_NOK if the ring was full
+  */
+CheckStatus_t NEO6M_Ring_PushByte(Ring_t *pRing, const uint8_t byte)
+{
+    return (NEO6M_Ring_Push(pRing, &byte, 1U) == 1U) ? NEO6M_OK : NEO6M_NOK;
+}
+
+/**
+  * @brief      Consumer side: copies bytes out of the ring.
+  * @param[in]  pRing               Pointer to ring
+  * @param[out] outBuf              Pointer to output buffer
+  * @param[in]  outSize             Size of output buffer
+  * @retval     Number of bytes copied
+  */
+uint32_t NEO6M_Ring_Pop(Ring_t *pRing, uint8_t *outBuf, const uint32_t outSize)
+{
+    uint32_t tail  = __atomic_load_n(&pRing->tail, __ATOMIC_RELAXED);
+    uint32_t count = NEO6M_Ring_Available(pRing, tail, outSize);
+    uint32_t offset;
+    uint32_t first;
+
+    if (count > outSize)
+    {
+        count = outSize;
+    }
+
+    if (count > 0U)
+    {
+        offset  = tail & pRing->mask;
+        first   = (pRing->mask + 1U) - offset;
+
+        if (first > count)
+        {
+            first = count;
+        }
+
+        (void) memcpy(outBuf, &pRing->buffer[offset], first);
+        (void) memcpy(&outBuf[first], pRing->buffer, count - first);
+
+        /* Hand the space back to the producer */
+        __atomic_store_n(&pRing->tail, tail + count, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/**
+  * @brief      Consumer side: feeds the available bytes to the streaming parser straight
+  *             from the ring storage, without an intermediate copy. The producer head is
+  *             only re-read when the cached copy shows an empty ring, so bytes pushed since
+  *             are left for the next call. Messages are stamped with the drain time, which
+  *             lags the receive time by the time the bytes waited in the ring.
+  * @param[in]  pRing               Pointer to ring
+  * @param[in]  pStream             Pointer to framer context
+  * @retval     Number of bytes consumed
+  */
+uint32_t NEO6M_Ring_Drain(Ring_t *pRing, Stream_Ctx_t *pStream)
+{
+    uint32_t tail  = __atomic_load_n(&pRing->tail, __ATOMIC_RELAXED);
+    uint32_t count = NEO6M_Ring_Available(pRing, tail, 1U);
+    uint32_t offset;
+    uint32_t first;
+    uint64_t rxNs;
+
+    if (count > 0U)
+    {
+        offset  = tail & pRing->mask;
+        first   = (pRing->mask + 1U) - offset;
+
+        if (first > count)
+        {
+            first = count;
+        }
+
+        /* Both halves were received by the same time; read the clock once */
+        rxNs = NEO6M_Stream_NowNs();
+
+        NEO6M_Stream_FeedAt(pStream, &pRing->buffer[offset], first, rxNs);
+
+        if (count > first)
+        {
+            NEO6M_Stream_FeedAt(pStream, pRing->buffer, count - first, rxNs);
+        }
+
+        __atomic_store_n(&pRing->tail, tail + count, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/**
+  * @brief      This function returns the number of bytes dropped on overrun. It may be
+  *             read from any thread; the value can lag behind the producer.
+  * @param[in]  pRing               Pointer to ring
+  * @retval     Dropped bytes
+  */
+uint32_t NEO6M_Ring_GetOverrunBytes(Ring_t const* pRing)
+{
+    return __atomic_load_n(&pRing->overrunBytes, __ATOMIC_RELAXED);
+}
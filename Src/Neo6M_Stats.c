@@ -0,0 +1,95 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Stats.c
+  * @author  Huy Nguyen
+  * @brief   Optional per-sentence-type counters and cycle histograms for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "Neo6M_Stats.h"
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function clears every counter.
+  * @param[out] pStats              Pointer to counters
+  * @retval     None
+  */
+void NEO6M_Stats_Reset(NEO6M_Stats_t *pStats)
+{
+    (void) memset(pStats, 0, sizeof(NEO6M_Stats_t));
+}
+
+/**
+  * @brief      This function estimates a percentile of the decode time of one sentence type.
+  * @param[in]  pType               Pointer to counters of the type
+  * @param[in]  permille            Percentile in 1/1000, e.g. 990 for p99
+  * @retval     Upper bound in cycles of the bucket holding the percentile, 0 if nothing was timed
+  */
+uint64_t NEO6M_Stats_Percentile(NEO6M_StatsType_t const* pType, const uint16_t permille)
+{
+    uint64_t total  = 0U;
+    uint64_t seen   = 0U;
+    uint64_t rank;
+    uint64_t bound  = 0U;
+    uint8_t  bucket;
+
+    for (bucket = 0U; bucket < NEO6M_STATS_BUCKETS; bucket++)
+    {
+        total += pType->cycles[bucket];
+    }
+
+    if (total > 0U)
+    {
+        /* Rank of the wanted decode, rounded up and at least the first one */
+        rank = ((total * permille) + 999U) / 1000U;
+
+        if (rank == 0U)
+        {
+            rank = 1U;
+        }
+
+        for (bucket = 0U; bucket < NEO6M_STATS_BUCKETS; bucket++)
+        {
+            seen += pType->cycles[bucket];
+
+            if (seen >= rank)
+            {
+                bound = (uint64_t)2U << bucket;
+                break;
+            }
+        }
+    }
+
+    return bound;
+}
@@ -0,0 +1,348 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_Stream.c
+  * @author  Huy Nguyen
+  * @brief   Streaming NMEA/UBX framer for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <time.h>
+
+#include "Neo6M_Stream.h"
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function adds one byte to the running UBX checksum.
+  * @param[in]  pCtx                Pointer to framer context
+  * @param[in]  byte                Received byte
+  * @retval     None
+  */
+static void NEO6M_Stream_UpdateChecksum(Stream_Ctx_t *pCtx, const uint8_t byte)
+{
+    pCtx->ckA = (uint8_t)(pCtx->ckA + byte);
+    pCtx->ckB = (uint8_t)(pCtx->ckB + pCtx->ckA);
+}
+
+/**
+  * @brief      This function starts collecting a new NMEA line.
+  * @param[in]  pCtx                Pointer to framer context
+  * @retval     None
+  */
+static void NEO6M_Stream_StartLine(Stream_Ctx_t *pCtx)
+{
+    pCtx->line[0]   = '$';
+    pCtx->lineLen   = 1U;
+    pCtx->state     = STREAM_NMEA;
+}
+
+/**
+  * @brief      This function handles a byte while no message is being collected.
+  * @param[in]  pCtx                Pointer to framer context
+  * @param[in]  byte                Received byte
+  * @retval     None
+  */
+static void NEO6M_Stream_Hunt(Stream_Ctx_t *pCtx, const uint8_t byte)
+{
+    if (byte == (uint8_t)'$')
+    {
+        pCtx->stamp.firstNs = pCtx->rxNs;
+        NEO6M_Stream_StartLine(pCtx);
+    }
+    else if (byte == UBX_SYNC_CHAR_1)
+    {
+        pCtx->stamp.firstNs = pCtx->rxNs;
+        pCtx->state = STREAM_UBX_SYNC2;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/**
+  * @brief      This function handles a byte of an NMEA line.
+  * @param[in]  pCtx                Pointer to framer context
+  * @param[in]  byte                Received byte
+  * @retval     None
+  */
+static void NEO6M_Stream_CollectLine(Stream_Ctx_t *pCtx, const uint8_t byte)
+{
+    if ((byte == (uint8_t)'$') || (byte == UBX_SYNC_CHAR_1))
+    {
+        /* A new message started before the line ended: drop the partial line */
+        NEO6M_Stream_Hunt(pCtx, byte);
+    }
+    else if (pCtx->lineLen >= STREAM_MAX_LINE_LENGTH)
+    {
+        pCtx->stats.overflows++;
+        pCtx->state = STREAM_HUNT;
+    }
+    else if ((((byte < 0x20U) || (byte > 0x7EU)) && (byte != (uint8_t)'\r') && (byte != (uint8_t)'\n'))
+             || ((pCtx->line[pCtx->lineLen - 1U] == '\r') != (byte == (uint8_t)'\n')))
+    {
+        /* Not printable, or '\r' and '\n' not paired: line noise, resync at once */
+        pCtx->stats.rejectedLines++;
+        pCtx->state = STREAM_HUNT;
+    }
+    else
+    {
+        pCtx->line[pCtx->lineLen] = (char)byte;
+        pCtx->lineLen++;
+
+        if (byte == (uint8_t)'\n')
+        {
+            pCtx->line[pCtx->lineLen] = '\0';
+            pCtx->stamp.lastNs = pCtx->rxNs;
+            pCtx->stats.nmeaLines++;
+            pCtx->state = STREAM_HUNT;
+
+            if (pCtx->nmeaFn != NULL)
+            {
+                pCtx->nmeaFn(pCtx->pUser, pCtx->line, pCtx->lineLen);
+            }
+        }
+    }
+}
+
+/**
+  * @brief      This function handles a byte of a UBX frame.
+  * @param[in]  pCtx                Pointer to framer context
+  * @param[in]  byte                Received byte
+  * @retval     None
+  */
+static void NEO6M_Stream_CollectFrame(Stream_Ctx_t *pCtx, const uint8_t byte)
+{
+    switch (pCtx->state)
+    {
+        case STREAM_UBX_SYNC2:
+            if (byte == UBX_SYNC_CHAR_2)
+            {
+                pCtx->ckA   = 0U;
+                pCtx->ckB   = 0U;
+                pCtx->state = STREAM_UBX_CLASS;
+            }
+            else
+            {
+                pCtx->state = STREAM_HUNT;
+                NEO6M_Stream_Hunt(pCtx, byte);
+            }
+            break;
+
+        case STREAM_UBX_CLASS:
+            NEO6M_Stream_UpdateChecksum(pCtx, byte);
+            pCtx->frame.cls = byte;
+            pCtx->state     = STREAM_UBX_ID;
+            break;
+
+        case STREAM_UBX_ID:
+            NEO6M_Stream_UpdateChecksum(pCtx, byte);
+            pCtx->frame.id  = byte;
+            pCtx->state     = STREAM_UBX_LEN1;
+            break;
+
+        case STREAM_UBX_LEN1:
+            NEO6M_Stream_UpdateChecksum(pCtx, byte);
+            pCtx->frame.len = byte;
+            pCtx->state     = STREAM_UBX_LEN2;
+            break;
+
+        case STREAM_UBX_LEN2:
+            NEO6M_Stream_UpdateChecksum(pCtx, byte);
+            pCtx->frame.len     = (uint16_t)(pCtx->frame.len | ((uint16_t)byte << 8));
+            pCtx->payloadIndex  = 0U;
+
+            if (pCtx->frame.len > UBX_MAX_PAYLOAD_LENGTH)
+            {
+                pCtx->stats.overflows++;
+                pCtx->state = STREAM_HUNT;
+            }
+            else
+            {
+                pCtx->state = (pCtx->frame.len == 0U) ? STREAM_UBX_CKA : STREAM_UBX_PAYLOAD;
+            }
+            break;
+
+        case STREAM_UBX_PAYLOAD:
+            NEO6M_Stream_UpdateChecksum(pCtx, byte);
+            pCtx->frame.payload[pCtx->payloadIndex] = byte;
+            pCtx->payloadIndex++;
+
+            if (pCtx->payloadIndex >= pCtx->frame.len)
+            {
+                pCtx->state = STREAM_UBX_CKA;
+            }
+            break;
+
+        case STREAM_UBX_CKA:
+            pCtx->ckValid   = (byte == pCtx->ckA) ? 1U : 0U;
+            pCtx->state     = STREAM_UBX_CKB;
+            break;
+
+        case STREAM_UBX_CKB:
+            pCtx->state = STREAM_HUNT;
+
+            if ((pCtx->ckValid != 0U) && (byte == pCtx->ckB))
+            {
+                pCtx->stamp.lastNs = pCtx->rxNs;
+                pCtx->stats.ubxFrames++;
+
+                if (pCtx->ubxFn != NULL)
+                {
+                    pCtx->ubxFn(pCtx->pUser, &pCtx->frame);
+                }
+            }
+            else
+            {
+                pCtx->stats.ubxChecksumErrors++;
+            }
+            break;
+
+        default:
+            pCtx->state = STREAM_HUNT;
+            break;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function initializes a framer context.
+  * @param[out] pCtx                Pointer to framer context
+  * @param[in]  nmeaFn              NMEA line callback, may be NULL
+  * @param[in]  ubxFn               UBX frame callback, may be NULL
+  * @param[in]  pUser               User data passed to callbacks
+  * @retval     None
+  */
+void NEO6M_Stream_Init(Stream_Ctx_t *pCtx, Stream_NmeaFn_t nmeaFn, Stream_UbxFn_t ubxFn, void *pUser)
+{
+    (void) memset(pCtx, 0, sizeof(Stream_Ctx_t));
+
+    pCtx->state     = STREAM_HUNT;
+    pCtx->nmeaFn    = nmeaFn;
+    pCtx->ubxFn     = ubxFn;
+    pCtx->pUser     = pUser;
+}
+
+/**
+  * @brief      This function feeds received bytes into the framer, stamped with the time
+  *             of NEO6M_Stream_NowNs.
+  * @param[in]  pCtx                Pointer to framer context
+  * @param[in]  data                Pointer to received bytes
+  * @param[in]  len                 Number of received bytes
+  * @retval     None
+  */
+void NEO6M_Stream_Feed(Stream_Ctx_t *pCtx, uint8_t const* data, const uint32_t len)
+{
+    NEO6M_Stream_FeedAt(pCtx, data, len, NEO6M_Stream_NowNs());
+}
+
+/**
+  * @brief      This function feeds received bytes into the framer. Every byte of the call
+  *             shares rxNs, so a driver that knows when its DMA block or FIFO filled can
+  *             pass that time instead of the time the bytes were read.
+  * @param[in]  pCtx                Pointer to framer context
+  * @param[in]  data                Pointer to received bytes
+  * @param[in]  len                 Number of received bytes
+  * @param[in]  rxNs                Receive time of the bytes, any monotonic nanosecond clock
+  * @retval     None
+  */
+void NEO6M_Stream_FeedAt(Stream_Ctx_t *pCtx, uint8_t const* data, const uint32_t len, const uint64_t rxNs)
+{
+    uint32_t index;
+    uint32_t skip;
+
+    pCtx->rxNs = rxNs;
+
+    for (index = 0U; index < len; index++)
+    {
+        if (pCtx->state == STREAM_HUNT)
+        {
+            /* Jump over the noise to the next possible message start */
+            skip                        = NEO6M_Stream_Resync(&data[index], len - index);
+            pCtx->stats.skippedBytes   += skip;
+            index                      += skip;
+
+            if (index < len)
+            {
+                NEO6M_Stream_Hunt(pCtx, data[index]);
+            }
+        }
+        else if (pCtx->state == STREAM_NMEA)
+        {
+            NEO6M_Stream_CollectLine(pCtx, data[index]);
+        }
+        else
+        {
+            NEO6M_Stream_CollectFrame(pCtx, data[index]);
+        }
+    }
+}
+
+/**
+  * @brief      This function finds the next byte that can start a message, '$' or the first
+  *             UBX sync char, with memchr so long runs of noise are passed over word-wise.
+  *             A caller holding a line the parser rejected can resync with it too.
+  * @param[in]  data                Pointer to bytes
+  * @param[in]  len                 Number of bytes
+  * @retval     Bytes before the message start, len if there is none
+  */
+uint32_t NEO6M_Stream_Resync(uint8_t const* data, const uint32_t len)
+{
+    uint8_t const* pDollar  = (uint8_t const*) memchr(data, '$', len);
+    uint32_t       offset   = (pDollar != NULL) ? (uint32_t)(pDollar - data) : len;
+    uint8_t const* pSync    = (uint8_t const*) memchr(data, UBX_SYNC_CHAR_1, offset);
+
+    if (pSync != NULL)
+    {
+        offset = (uint32_t)(pSync - data);
+    }
+
+    return offset;
+}
+
+/**
+  * @brief      This function reads the clock NEO6M_Stream_Feed stamps messages with.
+  * @retval     CLOCK_MONOTONIC nanoseconds, 0 if NEO6M_CFG_STREAM_TIMESTAMP is 0
+  */
+uint64_t NEO6M_Stream_NowNs(void)
+{
+    uint64_t nowNs = 0U;
+#if (NEO6M_CFG_STREAM_TIMESTAMP != 0)
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0)
+    {
+        nowNs = ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+    }
+#endif
+
+    return nowNs;
+}
@@ -0,0 +1,103 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_UBX.c
+  * @author  Huy Nguyen
+  * @brief   UBX binary protocol frame encoder for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_UBX.h"
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function computes the 8-bit Fletcher checksum used by UBX frames.
+  * @param[in]  data                Pointer to class, id, length and payload bytes
+  * @param[in]  len                 Number of bytes
+  * @param[out] pCkA                Pointer to CK_A
+  * @param[out] pCkB                Pointer to CK_B
+  * @retval     None
+  */
+void NEO6M_UBX_Checksum(uint8_t const* const data, const uint16_t len, uint8_t *pCkA, uint8_t *pCkB)
+{
+    uint8_t  ckA = 0U;
+    uint8_t  ckB = 0U;
+    uint16_t index;
+
+    for (index = 0U; index < len; index++)
+    {
+        ckA = (uint8_t)(ckA + data[index]);
+        ckB = (uint8_t)(ckB + ckA);
+    }
+
+    *pCkA = ckA;
+    *pCkB = ckB;
+}
+
+/**
+  * @brief      This function encodes a complete UBX frame into a buffer.
+  * @param[in]  cls                 Message class
+  * @param[in]  id                  Message id
+  * @param[in]  payload             Pointer to payload, may be NULL when len is 0
+  * @param[in]  len                 Payload length
+  * @param[out] outBuf              Pointer to output buffer
+  * @param[in]  outSize             Size of output buffer
+  * @retval     Number of bytes written, 0 if the buffer is too small
+  */
+uint16_t NEO6M_UBX_EncodeFrame(const uint8_t cls, const uint8_t id,
+                               uint8_t const* const payload, const uint16_t len,
+                               uint8_t *outBuf, const uint16_t outSize)
+{
+    uint16_t frameLen = 0U;
+
+    if (((uint32_t)len + UBX_FRAME_OVERHEAD) <= outSize)
+    {
+        outBuf[0] = UBX_SYNC_CHAR_1;
+        outBuf[1] = UBX_SYNC_CHAR_2;
+        outBuf[2] = cls;
+        outBuf[3] = id;
+        outBuf[4] = (uint8_t)(len & 0xFFU);
+        outBuf[5] = (uint8_t)(len >> 8);
+
+        if (len > 0U)
+        {
+            (void) memcpy(&outBuf[UBX_HEADER_LENGTH], payload, len);
+        }
+
+        /* Checksum covers everything between the sync chars and the checksum */
+        NEO6M_UBX_Checksum(&outBuf[2], (uint16_t)(len + 4U),
+                           &outBuf[UBX_HEADER_LENGTH + len],
+                           &outBuf[UBX_HEADER_LENGTH + len + 1U]);
+
+        frameLen = (uint16_t)(len + UBX_FRAME_OVERHEAD);
+    }
+
+    return frameLen;
+}
@@ -0,0 +1,255 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_UBXConfig.c
+  * @author  Huy Nguyen
+  * @brief   Pipelined UBX configuration session for GPS Neo 6M implement file
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Neo6M_UBXConfig.h"
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function transmits one command and marks it as sent.
+  * @param[in]  pSession            Pointer to session
+  * @param[in]  pCmd                Pointer to command
+  * @retval     None
+  */
+static void NEO6M_UBXCfg_Send(UBXCfg_Session_t *pSession, UBXCfg_Cmd_t *pCmd)
+{
+    uint8_t  frame[UBXCFG_MAX_FRAME_LENGTH];
+    uint16_t frameLen;
+
+    frameLen = NEO6M_UBX_EncodeFrame(pCmd->cls, pCmd->id, pCmd->payload, pCmd->len, frame, sizeof(frame));
+
+    pCmd->attempts++;
+    pCmd->sendSeq   = pSession->nextSeq++;
+    pCmd->sentTick  = pSession->tickFn(pSession->pUser);
+    pCmd->state     = UBXCFG_CMD_SENT;
+
+    pSession->writeFn(pSession->pUser, frame, frameLen);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      This function initializes a configuration session.
+  * @param[out] pSession            Pointer to session
+  * @param[in]  writeFn             Transmit callback
+  * @param[in]  tickFn              Millisecond tick callback
+  * @param[in]  pUser               User data passed to callbacks
+  * @param[in]  timeoutMs           Reply timeout for each attempt
+  * @param[in]  maxAttempts         Max transmissions per command, including the first one
+  * @retval     None
+  */
+void NEO6M_UBXCfg_Init(UBXCfg_Session_t *pSession, NEO6M_WriteFn_t writeFn, NEO6M_TickFn_t tickFn,
+                       void *pUser, const uint32_t timeoutMs, const uint8_t maxAttempts)
+{
+    (void) memset(pSession, 0, sizeof(UBXCfg_Session_t));
+
+    pSession->writeFn       = writeFn;
+    pSession->tickFn        = tickFn;
+    pSession->pUser         = pUser;
+    pSession->timeoutMs     = timeoutMs;
+    pSession->maxAttempts   = (maxAttempts == 0U) ? 1U : maxAttempts;
+    pSession->status        = UBXCFG_BUSY;
+}
+
+/**
+  * @brief      This function queues a command. The payload must stay valid until the session is done.
+  * @param[in]  pSession            Pointer to session
+  * @param[in]  cls                 Message class
+  * @param[in]  id                  Message id
+  * @param[in]  payload             Pointer to payload
+  * @param[in]  len                 Payload length
+  * @retval     NEO6M_OK if queued, NEO6M_NOK if the session is full or the payload is too long
+  */
+CheckStatus_t NEO6M_UBXCfg_Add(UBXCfg_Session_t *pSession, const uint8_t cls, const uint8_t id,
+                               uint8_t const* const payload, const uint16_t len)
+{
+    CheckStatus_t status = NEO6M_NOK;
+    UBXCfg_Cmd_t *pCmd;
+
+    if ((pSession->count < UBXCFG_MAX_COMMANDS)
+        && ((len + UBX_FRAME_OVERHEAD) <= UBXCFG_MAX_FRAME_LENGTH)
+    )
+    {
+        pCmd = &pSession->cmds[pSession->count];
+
+        pCmd->cls       = cls;
+        pCmd->id        = id;
+        pCmd->payload   = payload;
+        pCmd->len       = len;
+        pCmd->attempts  = 0U;
+        pCmd->state     = UBXCFG_CMD_QUEUED;
+
+        pSession->count++;
+
+        status = NEO6M_OK;
+    }
+
+    return status;
+}
+
+/**
+  * @brief      This function sends every queued command back to back.
+  * @param[in]  pSession            Pointer to session
+  * @retval     None
+  */
+void NEO6M_UBXCfg_Start(UBXCfg_Session_t *pSession)
+{
+    uint8_t index;
+
+    pSession->startTick = pSession->tickFn(pSession->pUser);
+    pSession->status    = UBXCFG_BUSY;
+
+    for (index = 0U; index < pSession->count; index++)
+    {
+        NEO6M_UBXCfg_Send(pSession, &pSession->cmds[index]);
+    }
+}
+
+/**
+  * @brief      This function matches an ACK-ACK or ACK-NAK frame to the oldest outstanding
+  *             command with the same class and id. Other frames are ignored.
+  * @param[in]  pSession            Pointer to session
+  * @param[in]  pFrame              Pointer to frame delivered by the streaming parser
+  * @retval     None
+  */
+void NEO6M_UBXCfg_OnFrame(UBXCfg_Session_t *pSession, UBX_Frame_t const* pFrame)
+{
+    UBXCfg_Cmd_t *pMatch = NULL;
+    uint8_t index;
+
+    if ((pFrame->cls == UBX_CLASS_ACK)
+        && ((pFrame->id == UBX_ID_ACK_ACK) || (pFrame->id == UBX_ID_ACK_NAK))
+        && (pFrame->len == 2U)
+    )
+    {
+        for (index = 0U; index < pSession->count; index++)
+        {
+            if ((pSession->cmds[index].state == UBXCFG_CMD_SENT)
+                && (pSession->cmds[index].cls == pFrame->payload[0])
+                && (pSession->cmds[index].id == pFrame->payload[1])
+                && ((pMatch == NULL)
+                    || ((uint16_t)(pSession->cmds[index].sendSeq - pMatch->sendSeq) > 0x7FFFU))
+            )
+            {
+                pMatch = &pSession->cmds[index];
+            }
+        }
+
+        if (pMatch != NULL)
+        {
+            pMatch->state = (pFrame->id == UBX_ID_ACK_ACK) ? UBXCFG_CMD_ACKED : UBXCFG_CMD_NAKED;
+        }
+    }
+}
+
+/**
+  * @brief      This function expires overdue commands, resends the failed ones and
+  *             reports whether the session has finished.
+  * @param[in]  pSession            Pointer to session
+  * @retval     UBXCfg_Status_t
+  */
+UBXCfg_Status_t NEO6M_UBXCfg_Poll(UBXCfg_Session_t *pSession)
+{
+    UBXCfg_Cmd_t *pCmd;
+    uint32_t now;
+    uint8_t  index;
+    uint8_t  pending   = 0U;
+    uint8_t  failures  = 0U;
+
+    if (pSession->status == UBXCFG_BUSY)
+    {
+        now = pSession->tickFn(pSession->pUser);
+
+        for (index = 0U; index < pSession->count; index++)
+        {
+            pCmd = &pSession->cmds[index];
+
+            if ((pCmd->state == UBXCFG_CMD_SENT) && ((now - pCmd->sentTick) >= pSession->timeoutMs))
+            {
+                pCmd->state = UBXCFG_CMD_TIMEOUT;
+            }
+
+            if ((pCmd->state == UBXCFG_CMD_NAKED) || (pCmd->state == UBXCFG_CMD_TIMEOUT))
+            {
+                if (pCmd->attempts < pSession->maxAttempts)
+                {
+                    NEO6M_UBXCfg_Send(pSession, pCmd);
+                }
+                else
+                {
+                    pCmd->state = UBXCFG_CMD_FAILED;
+                }
+            }
+
+            if ((pCmd->state == UBXCFG_CMD_SENT) || (pCmd->state == UBXCFG_CMD_QUEUED))
+            {
+                pending++;
+            }
+            else if (pCmd->state == UBXCFG_CMD_FAILED)
+            {
+                failures++;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+
+        if (pending == 0U)
+        {
+            pSession->endTick   = now;
+            pSession->status    = (failures == 0U) ? UBXCFG_DONE : UBXCFG_DONE_WITH_FAILURES;
+        }
+    }
+
+    return pSession->status;
+}
+
+/**
+  * @brief      This function returns the time spent configuring the receiver.
+  * @param[in]  pSession            Pointer to session
+  * @retval     Milliseconds from start to finish, or to now while the session is busy
+  */
+uint32_t NEO6M_UBXCfg_GetElapsedMs(UBXCfg_Session_t const* pSession)
+{
+    uint32_t endTick = pSession->endTick;
+
+    if (pSession->status == UBXCFG_BUSY)
+    {
+        endTick = pSession->tickFn(pSession->pUser);
+    }
+
+    return endTick - pSession->startTick;
+}
@@ -0,0 +1,41 @@
+#ifndef NEO6M_ALLOCTRACKER_H
+#define NEO6M_ALLOCTRACKER_H
+
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+
+/**
+ * @brief Heap traffic seen by the tracker. The test binary is linked with
+ *        -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free, so every call made
+ *        by the library objects goes through the tracker.
+*/
+struct AllocTracker_Stats_t
+{
+    uint64_t calls;     /* malloc, calloc and realloc calls */
+    uint64_t bytes;     /* Bytes requested by those calls */
+    uint64_t frees;     /* free calls on a non-NULL pointer */
+};
+
+/* Counts of the calling thread since NEO6M_AllocTracker_Begin */
+extern void NEO6M_AllocTracker_Begin(void);
+extern AllocTracker_Stats_t NEO6M_AllocTracker_End(void);
+
+/* Counts of every thread since the current test started */
+extern AllocTracker_Stats_t NEO6M_AllocTracker_GetTest(void);
+
+/* Fails the test unless statement performs exactly expected heap allocations on this thread */
+#define ASSERT_ALLOCS(expected, statement)                                      \
+    do                                                                          \
+    {                                                                           \
+        AllocTracker_Stats_t allocStats_;                                       \
+        NEO6M_AllocTracker_Begin();                                             \
+        statement;                                                              \
+        allocStats_ = NEO6M_AllocTracker_End();                                 \
+        ASSERT_EQ(allocStats_.calls, (uint64_t) (expected)) << #statement;      \
+        ASSERT_EQ(allocStats_.frees, allocStats_.calls) << #statement;          \
+    } while (0)
+
+#define ASSERT_NO_ALLOCS(statement)         ASSERT_ALLOCS(0U, statement)
+
+#endif /* NEO6M_ALLOCTRACKER_H */
@@ -0,0 +1,218 @@
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_AidCache.h"
+    #include "Neo6M_Stream.h"
+}
+
+static void ByteSink_Write(void *pUser, uint8_t const* data, uint16_t len)
+{
+    std::vector<uint8_t> *pSink = (std::vector<uint8_t>*)pUser;
+
+    pSink->insert(pSink->end(), data, data + len);
+}
+
+static void Cache_OnFrame(void *pUser, UBX_Frame_t const* pFrame)
+{
+    (void)NEO6M_AidCache_OnFrame((AidCache_t*)pUser, pFrame);
+}
+
+static uint32_t Payload_U32(uint8_t const* data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void Frames_OnFrame(void *pUser, UBX_Frame_t const* pFrame)
+{
+    ((std::vector<UBX_Frame_t>*)pUser)->push_back(*pFrame);
+}
+
+/* Appends one AID frame whose payload starts with the SV number and is filled with a pattern */
+static void Receiver_AddAid(std::vector<uint8_t> *pStream, uint8_t id, uint32_t svid, uint16_t len)
+{
+    uint8_t  payload[AIDCACHE_EPH_LENGTH];
+    uint8_t  frame[AIDCACHE_EPH_LENGTH + UBX_FRAME_OVERHEAD];
+    uint16_t index;
+    uint16_t frameLen;
+
+    for (index = 0; index < len; index++)
+    {
+        payload[index] = (uint8_t)(id + svid + index);
+    }
+
+    if (len >= 4U)
+    {
+        payload[0] = (uint8_t)svid;
+        payload[1] = 0U;
+        payload[2] = 0U;
+        payload[3] = 0U;
+    }
+
+    frameLen = NEO6M_UBX_EncodeFrame(UBX_CLASS_AID, id, payload, len, frame, sizeof(frame));
+    pStream->insert(pStream->end(), frame, frame + frameLen);
+}
+
+/* Simulated receiver reply to NEO6M_AidCache_RequestAll, mixed with NMEA output */
+static std::vector<uint8_t> Receiver_AidReplies(void)
+{
+    std::vector<uint8_t>    stream;
+    const char              nmea[] = "$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n";
+
+    Receiver_AddAid(&stream, UBX_ID_AID_INI, 0U, AIDCACHE_INI_LENGTH);
+    stream.insert(stream.end(), nmea, nmea + sizeof(nmea) - 1U);
+    Receiver_AddAid(&stream, UBX_ID_AID_ALM, 3U, AIDCACHE_ALM_LENGTH);
+    Receiver_AddAid(&stream, UBX_ID_AID_ALM, 4U, 8U);
+    Receiver_AddAid(&stream, UBX_ID_AID_ALM, 17U, AIDCACHE_ALM_LENGTH);
+    Receiver_AddAid(&stream, UBX_ID_AID_EPH, 3U, AIDCACHE_EPH_LENGTH);
+    Receiver_AddAid(&stream, UBX_ID_AID_EPH, 4U, 8U);
+    stream.insert(stream.end(), nmea, nmea + sizeof(nmea) - 1U);
+
+    return stream;
+}
+
+TEST(NEO6M_AidCache, Testcase_001)
+{
+    /* Capture from the receiver stream */
+    std::vector<uint8_t>    rx = Receiver_AidReplies();
+    std::vector<uint8_t>    polls;
+    AidCache_t              cache;
+    Stream_Ctx_t            ctx;
+
+    NEO6M_AidCache_Init(&cache);
+    NEO6M_AidCache_RequestAll(ByteSink_Write, &polls);
+    NEO6M_Stream_Init(&ctx, NULL, Cache_OnFrame, &cache);
+    NEO6M_Stream_Feed(&ctx, rx.data(), rx.size());
+
+    ASSERT_EQ(polls.size(), 3U * UBX_FRAME_OVERHEAD);
+    ASSERT_EQ(cache.hasIni, 1U);
+    ASSERT_EQ(cache.almMask, (1UL << 2) | (1UL << 16));
+    ASSERT_EQ(cache.ephMask, (1UL << 2));
+}
+
+TEST(NEO6M_AidCache, Testcase_002)
+{
+    /* Save, load on "next boot" and replay to the receiver */
+    std::vector<uint8_t>    rx = Receiver_AidReplies();
+    std::vector<uint8_t>    tx;
+    std::vector<UBX_Frame_t> frames;
+    AidCache_t              cache;
+    AidCache_t              restored;
+    Stream_Ctx_t            ctx;
+    char                    path[] = "build/aid_cache_test.bin";
+    FILE                    *pFile;
+    long                    fileSize;
+
+    const uint32_t          captureS = 1760000000UL;
+    uint32_t                gpsS;
+    uint32_t                flags;
+
+    NEO6M_AidCache_Init(&cache);
+    NEO6M_Stream_Init(&ctx, NULL, Cache_OnFrame, &cache);
+    NEO6M_Stream_Feed(&ctx, rx.data(), rx.size());
+    NEO6M_AidCache_Stamp(&cache, captureS);
+
+    ASSERT_EQ(NEO6M_AidCache_Save(&cache, path), NEO6M_OK);
+
+    pFile = fopen(path, "rb");
+    ASSERT_NE(pFile, nullptr);
+    (void)fseek(pFile, 0, SEEK_END);
+    fileSize = ftell(pFile);
+    (void)fclose(pFile);
+    ASSERT_EQ(fileSize, 18 + AIDCACHE_INI_LENGTH + 2 * AIDCACHE_ALM_LENGTH + AIDCACHE_EPH_LENGTH + 2);
+
+    ASSERT_EQ(NEO6M_AidCache_Load(&restored, path), NEO6M_OK);
+    ASSERT_EQ(restored.captureS, captureS);
+    ASSERT_EQ(NEO6M_AidCache_Replay(&restored, captureS + 600UL, ByteSink_Write, &tx), 4U);
+    (void)remove(path);
+
+    NEO6M_Stream_Init(&ctx, NULL, Frames_OnFrame, &frames);
+    NEO6M_Stream_Feed(&ctx, tx.data(), tx.size());
+
+    ASSERT_EQ(frames.size(), 4U);
+    ASSERT_EQ(frames[0].id, UBX_ID_AID_INI);
+    ASSERT_EQ(memcmp(frames[0].payload, cache.ini, 18U), 0);
+
+    /* AID-INI carries the replay time in GPS week and time of week, not the captured one */
+    gpsS = (captureS + 600UL - 315964800UL) + 18UL;
+    ASSERT_EQ(frames[0].payload[18] | (frames[0].payload[19] << 8), (int)(gpsS / 604800UL));
+    ASSERT_EQ(Payload_U32(&frames[0].payload[20]), (gpsS % 604800UL) * 1000UL);
+    flags = Payload_U32(&frames[0].payload[44]);
+    ASSERT_EQ(flags & 0x0002UL, 0x0002UL);
+    ASSERT_EQ(flags & (0x0004UL | 0x0008UL | 0x0010UL | 0x0080UL | 0x0400UL), 0U);
+    ASSERT_EQ(flags & 0x0001UL, Payload_U32(&cache.ini[44]) & 0x0001UL);
+    ASSERT_EQ(frames[1].id, UBX_ID_AID_ALM);
+    ASSERT_EQ(frames[1].payload[0], 3U);
+    ASSERT_EQ(frames[2].id, UBX_ID_AID_ALM);
+    ASSERT_EQ(frames[2].payload[0], 17U);
+    ASSERT_EQ(frames[3].id, UBX_ID_AID_EPH);
+    ASSERT_EQ(frames[3].len, AIDCACHE_EPH_LENGTH);
+    ASSERT_EQ(memcmp(frames[3].payload, cache.eph[2], AIDCACHE_EPH_LENGTH), 0);
+}
+
+TEST(NEO6M_AidCache, Testcase_003)
+{
+    /* Corrupted or truncated images are rejected */
+    std::vector<uint8_t>    rx = Receiver_AidReplies();
+    static uint8_t          image[AIDCACHE_MAX_SERIALIZED_LENGTH];
+    AidCache_t              cache;
+    AidCache_t              restored;
+    Stream_Ctx_t            ctx;
+    uint32_t                len;
+
+    NEO6M_AidCache_Init(&cache);
+    NEO6M_Stream_Init(&ctx, NULL, Cache_OnFrame, &cache);
+    NEO6M_Stream_Feed(&ctx, rx.data(), rx.size());
+
+    len = NEO6M_AidCache_Serialize(&cache, image, sizeof(image));
+    ASSERT_GT(len, 0U);
+    ASSERT_EQ(NEO6M_AidCache_Deserialize(&restored, image, len), NEO6M_OK);
+    ASSERT_EQ(NEO6M_AidCache_Deserialize(&restored, image, len - 1U), NEO6M_NOK);
+
+    image[20] ^= 0x01U;
+    ASSERT_EQ(NEO6M_AidCache_Deserialize(&restored, image, len), NEO6M_NOK);
+    ASSERT_EQ(restored.almMask, 0U);
+    ASSERT_EQ(NEO6M_AidCache_Load(&restored, "build/does_not_exist.bin"), NEO6M_NOK);
+}
+
+TEST(NEO6M_AidCache, Testcase_004)
+{
+    /* Stale or undated cache: no ephemerides, no position, time only when the caller knows it */
+    std::vector<uint8_t>    rx = Receiver_AidReplies();
+    std::vector<uint8_t>    tx;
+    std::vector<UBX_Frame_t> frames;
+    AidCache_t              cache;
+    Stream_Ctx_t            ctx;
+    const uint32_t          captureS = 1760000000UL;
+
+    NEO6M_AidCache_Init(&cache);
+    NEO6M_Stream_Init(&ctx, NULL, Cache_OnFrame, &cache);
+    NEO6M_Stream_Feed(&ctx, rx.data(), rx.size());
+    cache.ini[44] |= 0x03U;
+    NEO6M_AidCache_Stamp(&cache, captureS);
+
+    /* Five hours later: INI with the new time and no position, almanacs only */
+    ASSERT_EQ(NEO6M_AidCache_Replay(&cache, captureS + 5UL * 3600UL, ByteSink_Write, &tx), 3U);
+    NEO6M_Stream_Init(&ctx, NULL, Frames_OnFrame, &frames);
+    NEO6M_Stream_Feed(&ctx, tx.data(), tx.size());
+    ASSERT_EQ(frames.size(), 3U);
+    ASSERT_EQ(frames[0].id, UBX_ID_AID_INI);
+    ASSERT_EQ(Payload_U32(&frames[0].payload[44]) & 0x0003UL, 0x0002UL);
+    ASSERT_EQ(frames[1].id, UBX_ID_AID_ALM);
+    ASSERT_EQ(frames[2].id, UBX_ID_AID_ALM);
+
+    /* Within the ephemeris validity, position and ephemeris are kept */
+    tx.clear();
+    ASSERT_EQ(NEO6M_AidCache_Replay(&cache, captureS + 3UL * 3600UL, ByteSink_Write, &tx), 4U);
+
+    /* Unknown current time: INI would carry nothing valid and is dropped */
+    tx.clear();
+    ASSERT_EQ(NEO6M_AidCache_Replay(&cache, 0U, ByteSink_Write, &tx), 2U);
+
+    /* Never stamped: age unknown, treated as stale */
+    tx.clear();
+    NEO6M_AidCache_Stamp(&cache, 0U);
+    ASSERT_EQ(NEO6M_AidCache_Replay(&cache, captureS, ByteSink_Write, &tx), 3U);
+}
@@ -0,0 +1,123 @@
+#include <atomic>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Neo6M_AllocTracker.h"
+
+/* Whole test, every thread */
+static std::atomic<uint64_t>    g_testCalls(0U);
+static std::atomic<uint64_t>    g_testBytes(0U);
+static std::atomic<uint64_t>    g_testFrees(0U);
+
+/* Scope opened by NEO6M_AllocTracker_Begin, calling thread only */
+static thread_local bool                    t_scoped = false;
+static thread_local AllocTracker_Stats_t    t_scope;
+
+extern "C" {
+
+extern void* __real_malloc(size_t size);
+extern void* __real_calloc(size_t count, size_t size);
+extern void* __real_realloc(void *ptr, size_t size);
+extern void  __real_free(void *ptr);
+
+static void AllocTracker_Count(const uint64_t bytes)
+{
+    g_testCalls.fetch_add(1U, std::memory_order_relaxed);
+    g_testBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    if (t_scoped)
+    {
+        t_scope.calls++;
+        t_scope.bytes += bytes;
+    }
+}
+
+void* __wrap_malloc(size_t size)
+{
+    AllocTracker_Count(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    AllocTracker_Count((uint64_t) count * size);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void *ptr, size_t size)
+{
+    AllocTracker_Count(size);
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr != NULL)
+    {
+        g_testFrees.fetch_add(1U, std::memory_order_relaxed);
+
+        if (t_scoped)
+        {
+            t_scope.frees++;
+        }
+    }
+
+    __real_free(ptr);
+}
+
+}
+
+void NEO6M_AllocTracker_Begin(void)
+{
+    t_scope     = AllocTracker_Stats_t();
+    t_scoped    = true;
+}
+
+AllocTracker_Stats_t NEO6M_AllocTracker_End(void)
+{
+    t_scoped = false;
+    return t_scope;
+}
+
+AllocTracker_Stats_t NEO6M_AllocTracker_GetTest(void)
+{
+    AllocTracker_Stats_t stats;
+
+    stats.calls = g_testCalls.load(std::memory_order_relaxed);
+    stats.bytes = g_testBytes.load(std::memory_order_relaxed);
+    stats.frees = g_testFrees.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+/* Resets the totals before each test and reports them after it */
+class AllocTracker_Listener : public testing::EmptyTestEventListener
+{
+    void OnTestStart(testing::TestInfo const&) override
+    {
+        g_testCalls.store(0U);
+        g_testBytes.store(0U);
+        g_testFrees.store(0U);
+    }
+
+    void OnTestEnd(testing::TestInfo const& info) override
+    {
+        AllocTracker_Stats_t stats = NEO6M_AllocTracker_GetTest();
+
+        if (stats.calls > 0U)
+        {
+            printf("[  ALLOCS  ] %s.%s: %llu calls, %llu bytes, %llu frees\n",
+                   info.test_suite_name(), info.name(),
+                   (unsigned long long) stats.calls, (unsigned long long) stats.bytes,
+                   (unsigned long long) stats.frees);
+        }
+    }
+};
+
+/* gtest_main owns main(), so the listener registers itself at start-up */
+static bool g_listenerAdded = []()
+{
+    testing::UnitTest::GetInstance()->listeners().Append(new AllocTracker_Listener);
+    return true;
+}();
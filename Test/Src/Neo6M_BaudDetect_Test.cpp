@@ -0,0 +1,197 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_BaudDetect.h"
+}
+
+static const uint32_t candidates[] = {4800U, 9600U, 19200U, 38400U, 57600U, 115200U};
+
+static const char nmeaCapture[] =
+    "$GPRMC,142754.00,A,1048.17086,N,10639.46105,E,0.034,,210923,,,A*73\r\n"
+    "$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32\r\n"
+    "$GPGSV,2,1,05,04,,,44,08,,,41,09,,,37,21,,,26*7C\r\n"
+    "$GPRMC,142700.00,A,1048.17269,N,10639.47400,E,2.408,,210923,,,A*79\r\n"
+    "$GPVTG,,T,,M,2.181,N,4.039,K,A*27\r\n"
+    "$GPRMC,142706.00,A,1048.17259,N,10639.47070,E,2.547,275.81,210923,,,A*62\r\n";
+
+/* Replays what a UART set to rxBaud receives when the bytes are sent at txBaud (8N1,
+   back to back). Bytes with a bad stop bit are counted as framing errors and dropped,
+   as most UART drivers do. */
+static std::vector<uint8_t> Uart_Capture(std::vector<uint8_t> const& tx, uint32_t txBaud, uint32_t rxBaud,
+                                         uint32_t *pFramingErrors)
+{
+    std::vector<uint8_t>    bits;
+    std::vector<uint8_t>    rx;
+    size_t                  next = 1U;
+    size_t                  index;
+    int                     bit;
+
+    /* Line idles high before and after the capture */
+    bits.insert(bits.end(), 10U, 1U);
+    for (index = 0; index < tx.size(); index++)
+    {
+        bits.push_back(0U);
+        for (bit = 0; bit < 8; bit++)
+        {
+            bits.push_back((tx[index] >> bit) & 1U);
+        }
+        bits.push_back(1U);
+    }
+    bits.insert(bits.end(), 20U, 1U);
+
+    *pFramingErrors = 0U;
+
+    auto level = [&](double time) -> uint8_t {
+        size_t bitIndex = (size_t)(time * txBaud);
+        return (bitIndex < bits.size()) ? bits[bitIndex] : 1U;
+    };
+
+    for (;;)
+    {
+        /* Next falling edge happens on a tx bit boundary */
+        size_t  edge = next;
+        uint8_t byte = 0U;
+
+        while ((edge < bits.size()) && !((bits[edge - 1U] == 1U) && (bits[edge] == 0U)))
+        {
+            edge++;
+        }
+        if (edge >= bits.size())
+        {
+            break;
+        }
+
+        double start = (double)edge / txBaud;
+
+        if (level(start + 0.5 / rxBaud) != 0U)
+        {
+            next = edge + 1U;
+            continue;
+        }
+
+        for (bit = 0; bit < 8; bit++)
+        {
+            byte |= (uint8_t)(level(start + (bit + 1.5) / rxBaud) << bit);
+        }
+
+        if (level(start + 9.5 / rxBaud) == 0U)
+        {
+            (*pFramingErrors)++;
+        }
+        else
+        {
+            rx.push_back(byte);
+        }
+
+        /* Resume looking for a start bit after the stop bit sample */
+        next = (size_t)((start + 9.5 / rxBaud) * txBaud) + 1U;
+        if (next <= edge)
+        {
+            next = edge + 1U;
+        }
+    }
+
+    return rx;
+}
+
+TEST(NEO6M_BaudDetect, Testcase_001)
+{
+    /* Receiver at 9600: only the 9600 window locks, within the first few hundred bytes */
+    std::vector<uint8_t>    tx(nmeaCapture, nmeaCapture + sizeof(nmeaCapture) - 1U);
+    BaudDetect_Ctx_t        ctx;
+    uint32_t                baud = 0U;
+    uint8_t                 protocols = 0U;
+    uint8_t                 index;
+
+    NEO6M_BaudDetect_Init(&ctx, candidates, 6U);
+
+    for (index = 0; index < 6U; index++)
+    {
+        uint32_t                framingErrors;
+        std::vector<uint8_t>    rx = Uart_Capture(tx, 9600U, candidates[index], &framingErrors);
+
+        if (rx.size() > 300U)
+        {
+            rx.resize(300U);
+        }
+
+        ASSERT_EQ(NEO6M_BaudDetect_Feed(&ctx, index, rx.data(), rx.size(), framingErrors),
+                  (candidates[index] == 9600U) ? NEO6M_OK : NEO6M_NOK) << candidates[index];
+    }
+
+    ASSERT_EQ(NEO6M_BaudDetect_GetBest(&ctx, &baud, &protocols), NEO6M_OK);
+    ASSERT_EQ(baud, 9600U);
+    ASSERT_EQ(protocols, BAUDDETECT_PROTO_NMEA);
+}
+
+TEST(NEO6M_BaudDetect, Testcase_002)
+{
+    /* UBX only receiver at 115200 */
+    std::vector<uint8_t>    tx;
+    BaudDetect_Ctx_t        ctx;
+    uint32_t                baud = 0U;
+    uint8_t                 protocols = 0U;
+    uint8_t                 payload[28] = {0};
+    uint8_t                 frame[28 + UBX_FRAME_OVERHEAD];
+    uint16_t                frameLen;
+    uint8_t                 index;
+
+    for (index = 0; index < 5U; index++)
+    {
+        payload[0] = index;
+        frameLen = NEO6M_UBX_EncodeFrame(0x01, 0x02, payload, sizeof(payload), frame, sizeof(frame));
+        tx.insert(tx.end(), frame, frame + frameLen);
+    }
+
+    NEO6M_BaudDetect_Init(&ctx, candidates, 6U);
+
+    for (index = 0; index < 6U; index++)
+    {
+        uint32_t                framingErrors;
+        std::vector<uint8_t>    rx = Uart_Capture(tx, 115200U, candidates[index], &framingErrors);
+
+        (void)NEO6M_BaudDetect_Feed(&ctx, index, rx.data(), rx.size(), framingErrors);
+    }
+
+    ASSERT_EQ(NEO6M_BaudDetect_GetBest(&ctx, &baud, &protocols), NEO6M_OK);
+    ASSERT_EQ(baud, 115200U);
+    ASSERT_EQ(protocols, BAUDDETECT_PROTO_UBX);
+}
+
+TEST(NEO6M_BaudDetect, Testcase_003)
+{
+    /* Recorded dump at the wrong rate scores below the right one */
+    std::vector<uint8_t>    tx(nmeaCapture, nmeaCapture + sizeof(nmeaCapture) - 1U);
+    BaudDetect_Score_t      good;
+    BaudDetect_Score_t      bad;
+    uint32_t                framingErrors;
+    std::vector<uint8_t>    rxGood = Uart_Capture(tx, 38400U, 38400U, &framingErrors);
+    std::vector<uint8_t>    rxBad;
+
+    NEO6M_BaudDetect_Score(rxGood.data(), rxGood.size(), framingErrors, &good);
+    rxBad = Uart_Capture(tx, 38400U, 9600U, &framingErrors);
+    NEO6M_BaudDetect_Score(rxBad.data(), rxBad.size(), framingErrors, &bad);
+
+    ASSERT_EQ(good.nmeaHits, 6U);
+    ASSERT_EQ(good.framingErrors, 0U);
+    ASSERT_EQ(bad.nmeaHits, 0U);
+    ASSERT_GT(bad.framingErrors, 0U);
+    ASSERT_GT(good.score, bad.score);
+}
+
+TEST(NEO6M_BaudDetect, Testcase_004)
+{
+    /* Nothing valid: no rate is reported */
+    uint8_t                 noise[] = {0x00, 0xFF, 0x80, 0x24, 0x2A, 0x0D, 0x0A, 0xB5, 0x00};
+    BaudDetect_Ctx_t        ctx;
+    uint32_t                baud = 0U;
+    uint8_t                 protocols = 0U;
+
+    NEO6M_BaudDetect_Init(&ctx, candidates, 6U);
+
+    ASSERT_EQ(NEO6M_BaudDetect_Feed(&ctx, 0U, noise, sizeof(noise), 3U), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_BaudDetect_GetBest(&ctx, &baud, &protocols), NEO6M_NOK);
+}
@@ -0,0 +1,153 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Neo6M_Cpp.hpp"
+
+extern "C" {
+    #include "Neo6M_NmeaGen.h"
+}
+
+using FullParser = Neo6m::Parser<Neo6m::Rmc, Neo6m::Vtg, Neo6m::Gga, Neo6m::Gsa>;
+
+static bool operator==(Time_Info_t const& a, Time_Info_t const& b)
+{
+    return (a.hr == b.hr) && (a.min == b.min) && (a.sec == b.sec);
+}
+
+static bool operator==(Date_Info_t const& a, Date_Info_t const& b)
+{
+    return (a.year == b.year) && (a.month == b.month) && (a.day == b.day);
+}
+
+static bool operator==(Coord_Info_t const& a, Coord_Info_t const& b)
+{
+    return (a.fracDegs == b.fracDegs) && (a.degs == b.degs) && (a.pole == b.pole);
+}
+
+/* Compares the C++ result of a line with what NEO6M_GPSNeo6_ParseSentence decoded */
+static bool Cpp_SameAsC(FullParser::Result const& result, CheckStatus_t status, GPS_Sentence_t const& c)
+{
+    bool same = false;
+
+    if (status != NEO6M_OK)
+    {
+        same = std::holds_alternative<std::monostate>(result);
+    }
+    else if (auto const* pRmc = std::get_if<GPRMC_Info_t>(&result))
+    {
+        same = (c.type == SENTENCE_GPRMC) && (pRmc->time == c.info.rmc.time) && (pRmc->date == c.info.rmc.date)
+               && (pRmc->lat == c.info.rmc.lat) && (pRmc->lng == c.info.rmc.lng)
+               && (pRmc->present == c.info.rmc.present);
+    }
+    else if (auto const* pVtg = std::get_if<GPVTG_Info_t>(&result))
+    {
+        same = (c.type == SENTENCE_GPVTG) && (pVtg->cogt == c.info.vtg.cogt)
+               && (pVtg->sknots == c.info.vtg.sknots) && (pVtg->skph == c.info.vtg.skph)
+               && (pVtg->present == c.info.vtg.present);
+    }
+    else if (auto const* pGga = std::get_if<GPGGA_Info_t>(&result))
+    {
+        same = (c.type == SENTENCE_GPGGA) && (pGga->time == c.info.gga.time) && (pGga->lat == c.info.gga.lat)
+               && (pGga->lng == c.info.gga.lng) && (pGga->hdop == c.info.gga.hdop) && (pGga->alt == c.info.gga.alt)
+               && (pGga->quality == c.info.gga.quality) && (pGga->numSats == c.info.gga.numSats)
+               && (pGga->present == c.info.gga.present);
+    }
+    else if (auto const* pGsa = std::get_if<GPGSA_Info_t>(&result))
+    {
+        same = (c.type == SENTENCE_GPGSA) && (pGsa->pdop == c.info.gsa.pdop) && (pGsa->hdop == c.info.gsa.hdop)
+               && (pGsa->vdop == c.info.gsa.vdop) && (pGsa->fixType == c.info.gsa.fixType)
+               && (pGsa->mode == c.info.gsa.mode) && (pGsa->present == c.info.gsa.present)
+               && (memcmp(pGsa->sv, c.info.gsa.sv, sizeof(pGsa->sv)) == 0);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return same;
+}
+
+TEST(NEO6M_Cpp_Parse, Testcase_001)
+{
+    FullParser  parser;
+    auto        result = parser.Parse("$GPGGA,142754.00,1048.17086,N,10639.46105,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n");
+    auto const* pGga   = std::get_if<GPGGA_Info_t>(&result);
+
+    ASSERT_NE(pGga, nullptr);
+    ASSERT_EQ(pGga->time.hr, 14U);
+    ASSERT_EQ(pGga->lat.fracDegs, 80284U);
+    ASSERT_EQ(pGga->lng.degs, 106U);
+    ASSERT_EQ(pGga->numSats, 6U);
+    ASSERT_EQ(pGga->hdop, 370U);
+    ASSERT_EQ(pGga->alt, 210);
+
+    /* The line end may also be the end of the view */
+    result = parser.Parse("$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32");
+    ASSERT_TRUE(std::holds_alternative<GPVTG_Info_t>(result));
+    ASSERT_EQ(std::get<GPVTG_Info_t>(result).cogt, 18434U);
+
+    /* Invalid fix, unsupported sentence, embedded NUL and empty header */
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(parser.Parse("$GPGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99*30\r\n")));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(parser.Parse("$GPGSV,1,1,00*79\r\n")));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(parser.Parse(std::string_view("$GPVTG,1\0,T\r\n", 13U))));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(parser.Parse(",GPRMC\r\n")));
+}
+
+TEST(NEO6M_Cpp_Parse, Testcase_002)
+{
+    /* Types left out of the parameter list are not decoded */
+    Neo6m::Parser<Neo6m::Rmc>   parser;
+    uint32_t                    visits = 0U;
+
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(parser.Parse("$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32\r\n")));
+    ASSERT_TRUE(parser.Visit("$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n",
+                             [&visits](GPRMC_Info_t const& rmc)
+                             {
+                                 visits += rmc.date.day;
+                             }));
+    ASSERT_EQ(visits, 9U);
+}
+
+TEST(NEO6M_Cpp_Parse, Testcase_003)
+{
+    /* Field for field the same results as the C entry point over a noisy generated stream */
+    NmeaGen_Config_t    config;
+    NmeaGen_Ctx_t       gen;
+    FullParser          parser;
+    GPS_Sentence_t      sentence;
+    CheckStatus_t       status;
+    char                epoch[NMEAGEN_MAX_EPOCH_LENGTH];
+    std::string         stream;
+    std::string         line;
+    std::size_t         begin = 0U;
+    std::size_t         end;
+    uint32_t            decoded = 0U;
+    uint32_t            index;
+
+    NEO6M_NmeaGen_DefaultConfig(&config);
+    config.seed             = 2024U;
+    config.corruptPermille  = 100U;
+    config.truncatePermille = 50U;
+    NEO6M_NmeaGen_Init(&gen, &config);
+
+    for (index = 0U; index < 500U; index++)
+    {
+        stream.append(epoch, NEO6M_NmeaGen_NextEpoch(&gen, epoch, sizeof(epoch)));
+    }
+
+    stream += "$GPRMC," + std::string(120U, '9') + "\r\n";
+    stream += "$GPGGA,08x559.00,47a7.11437,N,00833.91522,E,1,08,1.01,499.6,M,48.0,M,,*43\r\n";
+
+    while ((end = stream.find('\n', begin)) != std::string::npos)
+    {
+        line    = stream.substr(begin, end + 1U - begin);
+        begin   = end + 1U;
+        status  = NEO6M_GPSNeo6_ParseSentence(line.c_str(), &sentence);
+        decoded += (status == NEO6M_OK) ? 1U : 0U;
+
+        ASSERT_TRUE(Cpp_SameAsC(parser.Parse(line), status, sentence)) << line;
+    }
+
+    ASSERT_GT(decoded, 1500U);
+}
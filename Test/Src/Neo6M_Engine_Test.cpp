@@ -0,0 +1,238 @@
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_Engine.h"
+}
+
+/* Writes sentences with consecutive UTC seconds, so the order can be checked on the output */
+static void Engine_WriteSentences(int fd, uint8_t count)
+{
+    char        line[STREAM_MAX_LINE_LENGTH];
+    uint8_t     sec;
+    int         len;
+
+    for (sec = 0U; sec < count; sec++)
+    {
+        len = snprintf(line, sizeof(line), "$GPRMC,0000%02u.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n", sec);
+        ASSERT_EQ(write(fd, line, len), len);
+
+        /* Not decoded, must not disturb the others */
+        ASSERT_EQ(write(fd, "$GPGSV,1,1,00*79\r\n", 18), 18);
+    }
+}
+
+TEST(NEO6M_Engine_Init, Testcase_001)
+{
+    static Engine_t engine;
+    uint16_t        id;
+    int             fds[2];
+
+    ASSERT_EQ(NEO6M_Engine_Init(&engine, 0U), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, 0, &id), NEO6M_NOK);
+    NEO6M_Engine_Stop(&engine);
+    ASSERT_EQ(NEO6M_Engine_Init(&engine, ENGINE_MAX_SHARDS + 1U), NEO6M_NOK);
+    NEO6M_Engine_Stop(&engine);
+
+    ASSERT_EQ(NEO6M_Engine_Init(&engine, 3U), NEO6M_OK);
+    ASSERT_EQ(pipe(fds), 0);
+
+    for (uint16_t index = 0U; index < ENGINE_MAX_RECEIVERS; index++)
+    {
+        ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, fds[0], &id), NEO6M_OK);
+        ASSERT_EQ(id, index);
+        ASSERT_EQ(engine.receivers[id].pShard->index, index % 3U);
+    }
+
+    ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, fds[0], &id), NEO6M_NOK);
+
+    NEO6M_Engine_Stop(&engine);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(NEO6M_Engine_Init, Testcase_002)
+{
+    /* Out of descriptors part way: the pipes already made are closed again */
+    static Engine_t engine;
+    struct rlimit   saved;
+    struct rlimit   limit;
+    uint16_t        id;
+    int             fds[2];
+
+    ASSERT_EQ(pipe(fds), 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    /* Room for the wake pipe of one shard only */
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &saved), 0);
+    limit           = saved;
+    limit.rlim_cur  = (rlim_t)fds[0] + 2U;
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &limit), 0);
+
+    ASSERT_EQ(NEO6M_Engine_Init(&engine, 3U), NEO6M_NOK);
+    ASSERT_EQ(engine.shardCount, 0U);
+    ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, 0, &id), NEO6M_NOK);
+    NEO6M_Engine_Stop(&engine);
+
+    /* Both descriptors of the first shard are free again */
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &saved), 0);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(NEO6M_Engine_Pop, Testcase_001)
+{
+    /* Six receivers on four shards; every fix arrives once and in order per receiver */
+    static Engine_t     engine;
+    Engine_Fix_t        fix;
+    std::vector<int>    next(6U, 0);
+    int                 fds[6][2];
+    uint16_t            id;
+    uint32_t            total = 0U;
+    uint32_t            failures = 0U;
+
+    ASSERT_EQ(NEO6M_Engine_Init(&engine, 4U), NEO6M_OK);
+
+    for (int index = 0; index < 6; index++)
+    {
+        ASSERT_EQ(pipe(fds[index]), 0);
+        ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, fds[index][0], &id), NEO6M_OK);
+    }
+
+    ASSERT_EQ(NEO6M_Engine_Start(&engine), NEO6M_OK);
+    ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, fds[0][0], &id), NEO6M_NOK);
+
+    uint64_t written = NEO6M_Stream_NowNs();
+
+    for (int index = 0; index < 6; index++)
+    {
+        Engine_WriteSentences(fds[index][1], 50U);
+        close(fds[index][1]);
+    }
+
+    while (NEO6M_Engine_Pop(&engine, &fix, 2000U) == NEO6M_OK)
+    {
+        ASSERT_LT(fix.receiverId, 6U);
+        ASSERT_EQ(fix.sentence.type, SENTENCE_GPRMC);
+        ASSERT_EQ(fix.sentence.info.rmc.time.sec, next[fix.receiverId]);
+        ASSERT_GE(fix.stamp.firstNs, written);
+        ASSERT_LE(fix.stamp.firstNs, fix.stamp.lastNs);
+        ASSERT_LE(fix.stamp.lastNs, NEO6M_Stream_NowNs());
+        next[fix.receiverId]++;
+        total++;
+    }
+
+    ASSERT_EQ(total, 300U);
+    ASSERT_EQ(engine.openReceivers, 0U);
+
+    for (int index = 0; index < 4; index++)
+    {
+        failures += engine.shards[index].failures;
+    }
+
+    ASSERT_EQ(failures, 300U);
+
+    NEO6M_Engine_Stop(&engine);
+
+    for (int index = 0; index < 6; index++)
+    {
+        close(fds[index][0]);
+    }
+}
+
+TEST(NEO6M_Engine_Pop, Testcase_002)
+{
+    /* Times out while receivers are open, stop wakes idle workers */
+    static Engine_t engine;
+    Engine_Fix_t    fix;
+    int             fds[2];
+    uint16_t        id;
+
+    ASSERT_EQ(NEO6M_Engine_Init(&engine, 2U), NEO6M_OK);
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, fds[0], &id), NEO6M_OK);
+    ASSERT_EQ(NEO6M_Engine_Start(&engine), NEO6M_OK);
+
+    ASSERT_EQ(NEO6M_Engine_Pop(&engine, &fix, 20U), NEO6M_NOK);
+    ASSERT_EQ(engine.openReceivers, 1U);
+
+    NEO6M_Engine_Stop(&engine);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/* Linked with --wrap=pthread_create: creation n of the countdown fails, 0 disables it */
+static std::atomic<uint32_t> g_createFailAt(0U);
+
+extern "C" int __real_pthread_create(pthread_t *pThread, const pthread_attr_t *pAttr,
+                                     void *(*pRoutine)(void *), void *pArg);
+
+extern "C" int __wrap_pthread_create(pthread_t *pThread, const pthread_attr_t *pAttr,
+                                     void *(*pRoutine)(void *), void *pArg)
+{
+    int result = EAGAIN;
+
+    if ((g_createFailAt.load() == 0U) || (g_createFailAt.fetch_sub(1U) != 1U))
+    {
+        result = __real_pthread_create(pThread, pAttr, pRoutine, pArg);
+    }
+
+    return result;
+}
+
+TEST(NEO6M_Engine_Start, Testcase_001)
+{
+    /* The third worker cannot be created: the others are joined and a retry succeeds */
+    static Engine_t engine;
+    Engine_Fix_t    fix;
+    uint32_t        total = 0U;
+    uint16_t        id;
+    int             fds[3][2];
+
+    ASSERT_EQ(NEO6M_Engine_Init(&engine, 3U), NEO6M_OK);
+
+    for (int index = 0; index < 3; index++)
+    {
+        ASSERT_EQ(pipe(fds[index]), 0);
+        ASSERT_EQ(NEO6M_Engine_AddReceiver(&engine, fds[index][0], &id), NEO6M_OK);
+    }
+
+    g_createFailAt.store(3U);
+    ASSERT_EQ(NEO6M_Engine_Start(&engine), NEO6M_NOK);
+    ASSERT_EQ(g_createFailAt.load(), 0U);
+    ASSERT_EQ(engine.running, 0U);
+
+    ASSERT_EQ(NEO6M_Engine_Start(&engine), NEO6M_OK);
+    ASSERT_EQ(engine.running, 3U);
+
+    for (int index = 0; index < 3; index++)
+    {
+        Engine_WriteSentences(fds[index][1], 10U);
+        close(fds[index][1]);
+    }
+
+    while (NEO6M_Engine_Pop(&engine, &fix, 2000U) == NEO6M_OK)
+    {
+        total++;
+    }
+
+    ASSERT_EQ(total, 30U);
+
+    NEO6M_Engine_Stop(&engine);
+
+    for (int index = 0; index < 3; index++)
+    {
+        close(fds[index][0]);
+    }
+}
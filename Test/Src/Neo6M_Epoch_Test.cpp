@@ -0,0 +1,164 @@
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Neo6M_AllocTracker.h"
+
+extern "C" {
+    #include "Neo6M_Epoch.h"
+}
+
+static void Epoch_Collect(void *pUser, Epoch_Fix_t const* pFix)
+{
+    ((std::vector<Epoch_Fix_t>*)pUser)->push_back(*pFix);
+}
+
+static const char* epochLines[] =
+{
+    "$GPRMC,142754.00,A,1048.17086,N,10639.46105,E,0.034,,210923,,,A*73\r\n",
+    "$GPVTG,0.00,T,,M,0.034,N,0.063,K,A*3F\r\n",
+    "$GPGGA,142754.00,1048.17086,N,10639.46105,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n",
+    "$GPGSA,A,3,04,08,09,21,,,,,,,,,5.12,3.70,3.54*04\r\n",
+    "$GPGSV,2,1,05,04,,,44,08,,,41,09,,,37,21,,,26*7C\r\n",
+    "$GPRMC,142755.00,A,1048.17090,N,10639.46110,E,0.012,,210923,,,A*75\r\n",
+    "$GPVTG,0.00,T,,M,0.034,N,0.063,K,A*3F\r\n",
+    "$GPGGA,142755.00,1048.17090,N,10639.46110,E,1,06,3.70,21.1,M,-2.6,M,,*78\r\n",
+    "$GPGSA,A,3,04,08,09,21,,,,,,,,,5.12,3.70,3.54*04\r\n",
+};
+
+TEST(NEO6M_Epoch, Testcase_001)
+{
+    /* One record per epoch, published as soon as the epoch is complete */
+    std::vector<Epoch_Fix_t>    fixes;
+    Epoch_Ctx_t                 ctx;
+    size_t                      index;
+
+    NEO6M_Epoch_Init(&ctx, EPOCH_HAS_ALL, Epoch_Collect, &fixes);
+
+    for (index = 0; index < 4U; index++)
+    {
+        ASSERT_EQ(fixes.size(), 0U);
+        (void)NEO6M_Epoch_OnLine(&ctx, epochLines[index]);
+    }
+
+    ASSERT_EQ(fixes.size(), 1U);
+
+    for (index = 4U; index < sizeof(epochLines) / sizeof(epochLines[0]); index++)
+    {
+        (void)NEO6M_Epoch_OnLine(&ctx, epochLines[index]);
+    }
+
+    ASSERT_EQ(fixes.size(), 2U);
+    ASSERT_EQ(fixes[0].present, EPOCH_HAS_ALL);
+    ASSERT_EQ(fixes[0].time.sec, 54U);
+    ASSERT_EQ(fixes[0].rmc.date.day, 21U);
+    ASSERT_EQ(fixes[0].vtg.sknots, 34U);
+    ASSERT_EQ(fixes[0].gga.numSats, 6U);
+    ASSERT_EQ(fixes[0].gsa.fixType, 3U);
+    ASSERT_EQ(fixes[1].time.sec, 55U);
+    ASSERT_EQ(fixes[1].gga.alt, 211);
+}
+
+TEST(NEO6M_Epoch, Testcase_002)
+{
+    /* Missing GSA: the epoch ends when the next UTC time shows up */
+    std::vector<Epoch_Fix_t>    fixes;
+    Epoch_Ctx_t                 ctx;
+
+    NEO6M_Epoch_Init(&ctx, EPOCH_HAS_ALL, Epoch_Collect, &fixes);
+
+    (void)NEO6M_Epoch_OnLine(&ctx, epochLines[0]);
+    (void)NEO6M_Epoch_OnLine(&ctx, epochLines[1]);
+    (void)NEO6M_Epoch_OnLine(&ctx, epochLines[2]);
+    ASSERT_EQ(fixes.size(), 0U);
+
+    (void)NEO6M_Epoch_OnLine(&ctx, epochLines[5]);
+    ASSERT_EQ(fixes.size(), 1U);
+    ASSERT_EQ(fixes[0].present, EPOCH_HAS_RMC | EPOCH_HAS_VTG | EPOCH_HAS_GGA);
+    ASSERT_EQ(fixes[0].time.sec, 54U);
+
+    NEO6M_Epoch_Flush(&ctx);
+    ASSERT_EQ(fixes.size(), 2U);
+    ASSERT_EQ(fixes[1].present, EPOCH_HAS_RMC);
+    ASSERT_EQ(fixes[1].time.sec, 55U);
+    ASSERT_EQ(ctx.published, 2U);
+}
+
+TEST(NEO6M_Epoch, Testcase_003)
+{
+    /* Receiver configured for RMC and VTG only; a repeated VTG also starts a new epoch */
+    std::vector<Epoch_Fix_t>    fixes;
+    Epoch_Ctx_t                 ctx;
+
+    NEO6M_Epoch_Init(&ctx, EPOCH_HAS_RMC | EPOCH_HAS_VTG, Epoch_Collect, &fixes);
+
+    (void)NEO6M_Epoch_OnLine(&ctx, epochLines[1]);
+    (void)NEO6M_Epoch_OnLine(&ctx, epochLines[6]);
+    ASSERT_EQ(fixes.size(), 1U);
+    ASSERT_EQ(fixes[0].hasTime, 0U);
+
+    ASSERT_EQ(NEO6M_Epoch_OnLine(&ctx, epochLines[4]), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_Epoch_OnLine(&ctx, epochLines[5]), NEO6M_OK);
+    ASSERT_EQ(fixes.size(), 2U);
+    ASSERT_EQ(fixes[1].present, EPOCH_HAS_RMC | EPOCH_HAS_VTG);
+    ASSERT_EQ(fixes[1].time.sec, 55U);
+}
+
+TEST(NEO6M_Epoch, Testcase_004)
+{
+    /* Merging already decoded sentences never touches the heap */
+    GPS_Sentence_t  sentences[4];
+    Epoch_Ctx_t     ctx;
+    uint8_t         index;
+
+    for (index = 0U; index < 4U; index++)
+    {
+        ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(epochLines[index], &sentences[index]), NEO6M_OK);
+    }
+
+    NEO6M_Epoch_Init(&ctx, EPOCH_HAS_ALL, NULL, NULL);
+
+    ASSERT_NO_ALLOCS(
+        for (index = 0U; index < 4U; index++)
+        {
+            NEO6M_Epoch_OnSentence(&ctx, &sentences[index]);
+        }
+    );
+    ASSERT_EQ(ctx.published, 1U);
+}
+
+TEST(NEO6M_Epoch, Testcase_005)
+{
+    /* One aggregator per receiver thread: each decodes with its own parser context */
+    static const uint32_t       rounds = 2000U;
+    std::vector<Epoch_Fix_t>    fixes[2];
+    Epoch_Ctx_t                 ctx[2];
+    std::thread                 workers[2];
+    size_t                      receiver;
+
+    for (receiver = 0U; receiver < 2U; receiver++)
+    {
+        NEO6M_Epoch_Init(&ctx[receiver], EPOCH_HAS_ALL, Epoch_Collect, &fixes[receiver]);
+        workers[receiver] = std::thread([&ctx, receiver]()
+        {
+            uint32_t    round;
+            size_t      index;
+
+            for (round = 0U; round < rounds; round++)
+            {
+                for (index = 0U; index < sizeof(epochLines) / sizeof(epochLines[0]); index++)
+                {
+                    (void)NEO6M_Epoch_OnLine(&ctx[receiver], epochLines[index]);
+                }
+            }
+        });
+    }
+
+    for (receiver = 0U; receiver < 2U; receiver++)
+    {
+        workers[receiver].join();
+        ASSERT_EQ(fixes[receiver].size(), 2U * rounds);
+        ASSERT_EQ(fixes[receiver].back().present, EPOCH_HAS_ALL);
+        ASSERT_EQ(fixes[receiver].back().gga.alt, 211);
+    }
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_FixStore.h"
+}
+
+#define FIXSTORE_STRESS_FIXES       200000U
+#define FIXSTORE_STRESS_READERS     4U
+#define FIXSTORE_STRESS_SNAPSHOTS   10000U
+
+/* Fix whose every field is derived from n, so a torn copy mixes two values */
+static GPRMC_Info_t FixStore_MakeFix(uint32_t n)
+{
+    GPRMC_Info_t fix;
+
+    memset(&fix, 0, sizeof(fix));
+    fix.time        = Time_Info_t {(uint8_t)(n % 24U), (uint8_t)(n % 60U), (uint8_t)(n % 59U)};
+    fix.date        = Date_Info_t {(uint8_t)(n % 100U), (uint8_t)(n % 12U), (uint8_t)(n % 31U)};
+    fix.lat         = Coord_Info_t {n, (uint8_t)(n % 90U), 'N'};
+    fix.lng         = Coord_Info_t {n, (uint8_t)(n % 180U), 'E'};
+    fix.present     = n;
+
+    return fix;
+}
+
+TEST(NEO6M_FixStore_Read, Testcase_001)
+{
+    static FixStore_t   store;
+    GPRMC_Info_t        fix = FixStore_MakeFix(7U);
+    GPRMC_Info_t        copy;
+    uint32_t            version = 0U;
+
+    NEO6M_FixStore_Init(&store);
+    ASSERT_EQ(NEO6M_FixStore_Read(&store, &copy, &version), NEO6M_NOK);
+    ASSERT_EQ(version, 0U);
+
+    NEO6M_FixStore_Publish(&store, &fix);
+    ASSERT_EQ(NEO6M_FixStore_Read(&store, &copy, &version), NEO6M_OK);
+    ASSERT_EQ(memcmp(&copy, &fix, sizeof(fix)), 0);
+    ASSERT_EQ(version, 1U);
+
+    fix = FixStore_MakeFix(8U);
+    NEO6M_FixStore_Publish(&store, &fix);
+    ASSERT_EQ(NEO6M_FixStore_Read(&store, &copy, NULL), NEO6M_OK);
+    ASSERT_EQ(memcmp(&copy, &fix, sizeof(fix)), 0);
+
+    /* A writer stopped halfway: the reader gives up instead of returning a torn fix */
+    store.seq++;
+    store.data.fix.lat.fracDegs = 9U;
+    ASSERT_EQ(NEO6M_FixStore_Read(&store, &copy, &version), NEO6M_NOK);
+    ASSERT_EQ(version, 1U);
+    ASSERT_EQ(copy.lat.fracDegs, 8U);
+}
+
+TEST(NEO6M_FixStore_Read, Testcase_002)
+{
+    /* One writer publishing without pause; every fix a reader gets is whole and never older
+       than the one it got before */
+    static FixStore_t       store;
+    std::atomic<bool>       done(false);
+    std::atomic<uint32_t>   torn(0U);
+    std::vector<std::thread> readers;
+    std::atomic<uint32_t>   snapshots[FIXSTORE_STRESS_READERS];
+    uint32_t                slowest = 0U;
+    uint32_t                n;
+
+    NEO6M_FixStore_Init(&store);
+
+    for (uint32_t reader = 0U; reader < FIXSTORE_STRESS_READERS; reader++)
+    {
+        snapshots[reader] = 0U;
+        readers.emplace_back([&done, &torn, &snapshots, reader]()
+        {
+            GPRMC_Info_t    copy;
+            GPRMC_Info_t    expected;
+            uint32_t        version;
+            uint32_t        last = 0U;
+
+            while (!done.load(std::memory_order_acquire))
+            {
+                if (NEO6M_FixStore_Read(&store, &copy, &version) == NEO6M_OK)
+                {
+                    expected = FixStore_MakeFix(copy.present);
+
+                    if ((memcmp(&copy, &expected, sizeof(copy)) != 0) || (version != copy.present) || (version < last))
+                    {
+                        torn++;
+                    }
+
+                    last = version;
+                    snapshots[reader]++;
+                }
+            }
+        });
+    }
+
+    /* Keep publishing until every reader had its share of overlapping reads */
+    for (n = 1U; (n <= FIXSTORE_STRESS_FIXES) || (slowest < FIXSTORE_STRESS_SNAPSHOTS); n++)
+    {
+        GPRMC_Info_t fix = FixStore_MakeFix(n);
+
+        NEO6M_FixStore_Publish(&store, &fix);
+
+        slowest = snapshots[0].load();
+
+        for (uint32_t reader = 1U; reader < FIXSTORE_STRESS_READERS; reader++)
+        {
+            slowest = std::min(slowest, snapshots[reader].load());
+        }
+    }
+
+    done.store(true, std::memory_order_release);
+
+    for (auto &thread : readers)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0U);
+
+    ASSERT_GE(slowest, FIXSTORE_STRESS_SNAPSHOTS);
+}
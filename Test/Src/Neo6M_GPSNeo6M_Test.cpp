@@ -1,9 +1,17 @@
 #include "gtest/gtest.h"
+#include "Neo6M_AllocTracker.h"
 
 extern "C" {
     #include "Neo6M_GPSNeo6M.h"
 }
 
+/* Heap blocks taken by the list of the eager parse; none with the static pool */
+#if (NEO6M_CFG_STATIC_POOL != 0)
+#define LIST_ALLOCS(n)                      0U
+#else
+#define LIST_ALLOCS(n)                      (n)
+#endif
+
 TEST(NEO6M_ParseGPSMsg, Testcase_001)
 {
     char            str[] = "$GPGSV,2,1,05,04,,,44,08,,,41,09,,,37,21,,,26*7C\r\n";
@@ -256,3 +264,608 @@ TEST(NEO6M_ParseGPRMCMsg, Testcase_005)
     ASSERT_EQ(pGPRMC_Info.lng.degs, 106U);
     ASSERT_EQ(pGPRMC_Info.lng.pole, 'E');
 }
+
+TEST(NEO6M_VerifyChecksum, Testcase_001)
+{
+    char            str[] = "$GPRMC,142754.00,A,1048.17086,N,10639.46105,E,0.034,,210923,,,A*73\r\n";
+
+    ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksum(str), NEO6M_OK);
+}
+
+TEST(NEO6M_VerifyChecksum, Testcase_002)
+{
+    char            str[] = "$GPVTG,,T,,M,2.181,N,4.039,K,D*27\r\n";
+
+    ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksum(str), NEO6M_NOK);
+}
+
+TEST(NEO6M_VerifyChecksum, Testcase_003)
+{
+    char            str1[] = "GPRMC,,V,,,,,,,,,,N*53\r\n";
+    char            str2[] = "$GPVTG,,,,,,,,,N\r\n";
+    char            str3[] = "$GPVTG,,,,,,,,,N*3\r\n";
+
+    ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksum(str1), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksum(str2), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksum(str3), NEO6M_NOK);
+}
+
+TEST(NEO6M_ParseSentence, Testcase_001)
+{
+    char            str[] = "$GPGGA,142754.00,1048.17086,N,10639.46105,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n";
+    GPS_Sentence_t  sentence;
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(str, &sentence), NEO6M_OK);
+    ASSERT_EQ(sentence.type, SENTENCE_GPGGA);
+    ASSERT_EQ(sentence.info.gga.time.hr, 14U);
+    ASSERT_EQ(sentence.info.gga.time.min, 27U);
+    ASSERT_EQ(sentence.info.gga.time.sec, 54U);
+    ASSERT_EQ(sentence.info.gga.lat.fracDegs, 80284U);
+    ASSERT_EQ(sentence.info.gga.lat.degs, 10U);
+    ASSERT_EQ(sentence.info.gga.lat.pole, 'N');
+    ASSERT_EQ(sentence.info.gga.lng.fracDegs, 65768U);
+    ASSERT_EQ(sentence.info.gga.lng.degs, 106U);
+    ASSERT_EQ(sentence.info.gga.lng.pole, 'E');
+    ASSERT_EQ(sentence.info.gga.quality, 1U);
+    ASSERT_EQ(sentence.info.gga.numSats, 6U);
+    ASSERT_EQ(sentence.info.gga.hdop, 370U);
+    ASSERT_EQ(sentence.info.gga.alt, 210);
+}
+
+TEST(NEO6M_ParseSentence, Testcase_002)
+{
+    char            str[] = "$GPGSA,A,3,04,08,09,21,,,,,,,,,5.12,3.70,3.54*04\r\n";
+    GPS_Sentence_t  sentence;
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(str, &sentence), NEO6M_OK);
+    ASSERT_EQ(sentence.type, SENTENCE_GPGSA);
+    ASSERT_EQ(sentence.info.gsa.mode, 'A');
+    ASSERT_EQ(sentence.info.gsa.fixType, 3U);
+    ASSERT_EQ(sentence.info.gsa.sv[0], 4U);
+    ASSERT_EQ(sentence.info.gsa.sv[3], 21U);
+    ASSERT_EQ(sentence.info.gsa.sv[4], 0U);
+    ASSERT_EQ(sentence.info.gsa.pdop, 512U);
+    ASSERT_EQ(sentence.info.gsa.hdop, 370U);
+    ASSERT_EQ(sentence.info.gsa.vdop, 354U);
+}
+
+TEST(NEO6M_ParseSentence, Testcase_003)
+{
+    char            str1[] = "$GPGGA,142456.00,,,,,0,00,99.99,,,,,,*66\r\n";
+    char            str2[] = "$GPGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99*30\r\n";
+    char            str3[] = "$GPGSV,2,1,05,04,,,44,08,,,41,09,,,37,21,,,26*7C\r\n";
+    char            str4[] = "$GPVTG,1\r\n";
+    GPS_Sentence_t  sentence;
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(str1, &sentence), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_GPGGA);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(str2, &sentence), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_GPGSA);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(str3, &sentence), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_UNKNOWN);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(str4, &sentence), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_GPVTG);
+}
+
+TEST(NEO6M_ParseSentenceCtx, Testcase_001)
+{
+    char            str1[] = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    char            str2[] = "$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32\r\n";
+    NEO6M_Ctx_t     ctx1;
+    NEO6M_Ctx_t     ctx2;
+    GPS_Sentence_t  sentence1;
+    GPS_Sentence_t  sentence2;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx1);
+    NEO6M_GPSNeo6_InitCtx(&ctx2);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx1, str1, &sentence1), NEO6M_OK);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx2, str2, &sentence2), NEO6M_OK);
+    ASSERT_EQ(sentence1.type, SENTENCE_GPRMC);
+    ASSERT_EQ(sentence1.info.rmc.time.sec, 59U);
+    ASSERT_EQ(sentence2.type, SENTENCE_GPVTG);
+    ASSERT_EQ(sentence2.info.vtg.cogt, 18434U);
+
+    /* Nothing is left allocated in a context after a parse */
+    ASSERT_EQ(ctx1.pHead, (Node_t*)NULL);
+    ASSERT_EQ(ctx1.fieldNum, 0U);
+    ASSERT_EQ(ctx2.pHead, (Node_t*)NULL);
+}
+
+TEST(NEO6M_Allocations, Testcase_001)
+{
+    char            str[] = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    GPS_Sentence_t  sentence;
+    CheckStatus_t   status;
+
+    /* Checksum verification never touches the heap */
+    ASSERT_NO_ALLOCS(status = NEO6M_GPSNeo6_VerifyChecksum(str));
+    ASSERT_EQ(status, NEO6M_OK);
+
+    /* A node and a field buffer for each of the 13 tokens; lower this as the parser sheds mallocs */
+    ASSERT_ALLOCS(LIST_ALLOCS(26U), status = NEO6M_GPSNeo6_ParseSentence(str, &sentence));
+    ASSERT_EQ(status, NEO6M_OK);
+}
+
+TEST(NEO6M_ParseSentenceFields, Testcase_001)
+{
+    /* Position only: same coordinates, nothing else converted, fewer copies */
+    char            rmc[]   = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    char            gga[]   = "$GPGGA,142754.00,1048.17086,N,10639.46105,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n";
+    char            rmcV[]  = "$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n";
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  full;
+    GPS_Sentence_t  part;
+    CheckStatus_t   status;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, rmc, &full), NEO6M_OK);
+    ASSERT_ALLOCS(LIST_ALLOCS(19U), status = NEO6M_GPSNeo6_ParseSentenceFields(&ctx, rmc, &part, NEO6M_FIELD_POSITION));
+    ASSERT_EQ(status, NEO6M_OK);
+    ASSERT_EQ(part.type, SENTENCE_GPRMC);
+    ASSERT_EQ(memcmp(&part.info.rmc.lat, &full.info.rmc.lat, sizeof(Coord_Info_t)), 0);
+    ASSERT_EQ(memcmp(&part.info.rmc.lng, &full.info.rmc.lng, sizeof(Coord_Info_t)), 0);
+    ASSERT_EQ(part.info.rmc.time.sec, 0U);
+    ASSERT_EQ(part.info.rmc.date.day, 0U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceFields(&ctx, gga, &part, NEO6M_FIELD_ALT), NEO6M_OK);
+    ASSERT_EQ(part.info.gga.alt, 210);
+    ASSERT_EQ(part.info.gga.quality, 1U);
+    ASSERT_EQ(part.info.gga.lat.degs, 0U);
+    ASSERT_EQ(part.info.gga.hdop, 0U);
+
+    /* Validity does not depend on the selection */
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceFields(&ctx, rmcV, &part, 0U), NEO6M_NOK);
+    ASSERT_EQ(part.type, SENTENCE_GPRMC);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceFields(&ctx, rmc, &part, 0U), NEO6M_OK);
+    ASSERT_EQ(ctx.pHead, (Node_t*)NULL);
+}
+
+TEST(NEO6M_LazyParse, Testcase_001)
+{
+    /* Every field on demand matches the eager decode */
+    char const*     lines[] =
+    {
+        "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n",
+        "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n",
+        "$GPGGA,142754.00,1048.17086,N,10639.46105,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n",
+        "$GPGSA,A,3,10,07,05,02,29,04,08,13,,,,,1.72,1.03,1.38*0A\r\n",
+    };
+    NEO6M_Ctx_t             ctx;
+    GPS_Lazy_t              lazy;
+    GPS_Sentence_t          eager;
+    GPS_Sentence_t const*   pSentence;
+    CheckStatus_t           status;
+    uint8_t                 index;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    for (index = 0U; index < (sizeof(lines) / sizeof(lines[0])); index++)
+    {
+        /* The eager parse leaves the rest of the union untouched */
+        memset(&eager, 0, sizeof(eager));
+        ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, lines[index], &eager), NEO6M_OK);
+        ASSERT_NO_ALLOCS(status = NEO6M_GPSNeo6_LazyParse(&lazy, lines[index]));
+        ASSERT_EQ(status, NEO6M_OK);
+        ASSERT_EQ(lazy.sentence.type, eager.type);
+        ASSERT_EQ(lazy.converted, 0U);
+
+        ASSERT_NO_ALLOCS(pSentence = NEO6M_GPSNeo6_LazyGet(&lazy, NEO6M_FIELD_ALL));
+        ASSERT_EQ(memcmp(pSentence, &eager, sizeof(GPS_Sentence_t)), 0);
+    }
+}
+
+TEST(NEO6M_LazyParse, Testcase_002)
+{
+    /* Accessors convert once, then read the cached value */
+    char            rmc[]   = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    GPS_Lazy_t      lazy;
+    Time_Info_t     time;
+    Date_Info_t     date;
+    Coord_Info_t    lat;
+    Coord_Info_t    lng;
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyParse(&lazy, rmc), NEO6M_OK);
+    ASSERT_EQ(lazy.sentence.info.rmc.time.hr, 0U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetTime(&lazy, &time), NEO6M_OK);
+    ASSERT_EQ(time.hr, 8U);
+    ASSERT_EQ(time.min, 35U);
+    ASSERT_EQ(time.sec, 59U);
+    ASSERT_EQ(lazy.converted, NEO6M_FIELD_TIME);
+
+    /* The line is a private copy; a second access must not convert it again */
+    rmc[7] = '2';
+    lazy.line[7] = '2';
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetTime(&lazy, &time), NEO6M_OK);
+    ASSERT_EQ(time.hr, 8U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetDate(&lazy, &date), NEO6M_OK);
+    ASSERT_EQ(date.day, 9U);
+    ASSERT_EQ(date.month, 12U);
+    ASSERT_EQ(date.year, 2U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetPosition(&lazy, &lat, &lng), NEO6M_OK);
+    ASSERT_EQ(lat.degs, 47U);
+    ASSERT_EQ(lat.pole, 'N');
+    ASSERT_EQ(lng.degs, 8U);
+    ASSERT_EQ(lng.pole, 'E');
+    ASSERT_EQ(lazy.converted, NEO6M_FIELD_TIME | NEO6M_FIELD_DATE | NEO6M_FIELD_POSITION);
+}
+
+TEST(NEO6M_LazyParse, Testcase_003)
+{
+    /* Invalid sentences, properties a type lacks and broken lines */
+    char            rmcV[]  = "$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n";
+    char            vtg[]   = "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n";
+    char            noCr[]  = "$GPRMC,083559.00,A,4717.11437,N";
+    GPS_Lazy_t      lazy;
+    Time_Info_t     time;
+    Date_Info_t     date;
+    Coord_Info_t    lat;
+    Coord_Info_t    lng;
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyParse(&lazy, rmcV), NEO6M_NOK);
+    ASSERT_EQ(lazy.sentence.type, SENTENCE_GPRMC);
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetTime(&lazy, &time), NEO6M_NOK);
+    ASSERT_EQ(lazy.converted, 0U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyParse(&lazy, vtg), NEO6M_OK);
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetTime(&lazy, &time), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetDate(&lazy, &date), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGetPosition(&lazy, &lat, &lng), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGet(&lazy, NEO6M_FIELD_SPEED)->info.vtg.skph, 8U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyParse(&lazy, noCr), NEO6M_NOK);
+    ASSERT_EQ(lazy.sentence.type, SENTENCE_UNKNOWN);
+}
+
+TEST(NEO6M_FieldCache, Testcase_001)
+{
+    /* A parked receiver repeats its date and coordinates; only changed text is converted */
+    char const*     rmc1    = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    char const*     rmc2    = "$GPRMC,083600.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*5D\r\n";
+    char const*     rmcS    = "$GPRMC,083601.00,A,4717.11437,S,00833.91522,E,0.004,77.52,091202,,,A*49\r\n";
+    char const*     gga     = "$GPGGA,083602.00,4717.11437,N,00833.91522,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n";
+    NEO6M_Ctx_t     ctx;
+    NEO6M_Ctx_t     fresh;
+    GPS_Sentence_t  first;
+    GPS_Sentence_t  cached;
+    GPS_Sentence_t  expected;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, rmc1, &first), NEO6M_OK);
+    ASSERT_EQ(ctx.cache.hits, 0U);
+    ASSERT_EQ(ctx.cache.misses, 3U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, rmc2, &cached), NEO6M_OK);
+    ASSERT_EQ(ctx.cache.hits, 3U);
+    ASSERT_EQ(ctx.cache.misses, 3U);
+    ASSERT_EQ(cached.info.rmc.time.sec, 0U);
+    ASSERT_EQ(memcmp(&cached.info.rmc.date, &first.info.rmc.date, sizeof(Date_Info_t)), 0);
+    ASSERT_EQ(memcmp(&cached.info.rmc.lat, &first.info.rmc.lat, sizeof(Coord_Info_t)), 0);
+    ASSERT_EQ(memcmp(&cached.info.rmc.lng, &first.info.rmc.lng, sizeof(Coord_Info_t)), 0);
+
+    /* Same digits, other pole: converted again and equal to an uncached parse */
+    NEO6M_GPSNeo6_InitCtx(&fresh);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, rmcS, &cached), NEO6M_OK);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&fresh, rmcS, &expected), NEO6M_OK);
+    ASSERT_EQ(ctx.cache.hits, 5U);
+    ASSERT_EQ(ctx.cache.misses, 4U);
+    ASSERT_EQ(cached.info.rmc.lat.pole, 'S');
+    ASSERT_EQ(memcmp(&cached.info.rmc, &expected.info.rmc, sizeof(GPRMC_Info_t)), 0);
+
+    /* Every sentence type keeps its own slots */
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, gga, &cached), NEO6M_OK);
+    ASSERT_EQ(ctx.cache.misses, 6U);
+    ASSERT_EQ(memcmp(&cached.info.gga.lat, &first.info.rmc.lat, sizeof(Coord_Info_t)), 0);
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+    ASSERT_EQ(ctx.cache.hits, 0U);
+    ASSERT_EQ(ctx.cache.entry[NEO6M_CACHE_ENTRIES - 1U].keyLen, 0U);
+}
+
+TEST(NEO6M_ParseSentence, Testcase_004)
+{
+    /* Line noise fails at the first bad byte, for the eager and the lazy parse */
+    char            noisy[] = "$GPRMC,083559.00,A,4717.11437,N,00\x83""833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    GPS_Sentence_t  sentence;
+    GPS_Lazy_t      lazy;
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(noisy, &sentence), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_UNKNOWN);
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyParse(&lazy, noisy), NEO6M_NOK);
+    ASSERT_EQ(lazy.sentence.type, SENTENCE_UNKNOWN);
+}
+
+TEST(NEO6M_ParseSentenceLen, Testcase_001)
+{
+    /* Same result as the terminated parse, whichever terminator ends the line */
+    char const*     line    = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    size_t          star    = strchr(line, '*') - line;
+    std::string     buffer  = std::string(line, star) + "$GPVTG";
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  expected;
+    GPS_Sentence_t  sentence;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+    memset(&expected, 0, sizeof(expected));
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, line, &expected), NEO6M_OK);
+
+    /* '\r', '*', the end of the buffer */
+    memset(&sentence, 0, sizeof(sentence));
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, line, strlen(line), &sentence), NEO6M_OK);
+    ASSERT_EQ(memcmp(&sentence, &expected, sizeof(GPS_Sentence_t)), 0);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, line, star + 3U, &sentence), NEO6M_OK);
+    ASSERT_EQ(memcmp(&sentence, &expected, sizeof(GPS_Sentence_t)), 0);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, buffer.data(), star, &sentence), NEO6M_OK);
+    ASSERT_EQ(memcmp(&sentence, &expected, sizeof(GPS_Sentence_t)), 0);
+
+    /* '\n' only, as in a log */
+    buffer = std::string(line, star) + "\n";
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, buffer.data(), buffer.size(), &sentence), NEO6M_OK);
+    ASSERT_EQ(ctx.pHead, (Node_t*)NULL);
+}
+
+TEST(NEO6M_ParseSentenceLen, Testcase_002)
+{
+    /* Nothing past len is read, and long buffers cost at most one line limit */
+    std::string     digits(200, '1');
+    std::string     longLine = "$GPVTG," + digits;
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  sentence;
+    char*           pExact;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    /* A heap block of exactly len bytes, so reading past it shows up in sanitizer builds */
+    pExact = (char*)malloc(9U);
+    memcpy(pExact, "$GPVTG,1,", 9U);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, pExact, 9U, &sentence), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_GPVTG);
+    free(pExact);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, longLine.data(), longLine.size(), &sentence), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_UNKNOWN);
+
+    /* len 0 at the very end of a heap block: not even the first byte is read */
+    pExact = (char*)malloc(1U);
+    pExact[0] = '$';
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, &pExact[1], 0U, &sentence), NEO6M_NOK);
+    free(pExact);
+    ASSERT_EQ(ctx.pHead, (Node_t*)NULL);
+}
+
+TEST(NEO6M_ParseInPlace, Testcase_001)
+{
+    /* Same decode as the list parser, without a copy or an allocation */
+    char const*             lines[] =
+    {
+        "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n",
+        "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n",
+        "$GPGGA,142754.00,1048.17086,N,10639.46105,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n",
+        "$GPGSA,A,3,10,07,05,02,29,04,08,13,,,,,1.72,1.03,1.38*0A\r\n",
+    };
+    NEO6M_Ctx_t             ctx;
+    GPS_InPlace_t           tok;
+    GPS_Sentence_t          eager;
+    GPS_Sentence_t          inPlace;
+    AllocTracker_Stats_t    heap;
+    CheckStatus_t           status;
+    char                    line[GPS_LAZY_LINE_LENGTH + 1U];
+    uint8_t                 index;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    for (index = 0U; index < (sizeof(lines) / sizeof(lines[0])); index++)
+    {
+        memset(&eager, 0, sizeof(eager));
+        memset(&inPlace, 0, sizeof(inPlace));
+
+        NEO6M_AllocTracker_Begin();
+        ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, lines[index], &eager), NEO6M_OK);
+        heap = NEO6M_AllocTracker_End();
+
+        strcpy(line, lines[index]);
+        ASSERT_NO_ALLOCS(status = NEO6M_GPSNeo6_ParseInPlace(&tok, line, &inPlace, NEO6M_FIELD_ALL));
+        ASSERT_EQ(status, NEO6M_OK);
+        ASSERT_EQ(memcmp(&inPlace, &eager, sizeof(GPS_Sentence_t)), 0);
+#if (NEO6M_CFG_STATIC_POOL == 0)
+        /* The list parser requests more heap per line than the whole in-place state */
+        ASSERT_GT(heap.bytes, sizeof(GPS_InPlace_t));
+#endif
+    }
+
+    /* A few dozen bytes of state on any target */
+    ASSERT_LE(sizeof(GPS_InPlace_t), 32U);
+}
+
+TEST(NEO6M_ParseInPlace, Testcase_002)
+{
+    /* Raw fields of the rewritten line, selection and failures */
+    char            line[]  = "$GPGGA,142754.00,1048.17086,N,10639.46105,E,1,06,3.70,21.0,M,-2.6,M,,*7B\r\n";
+    char            copy[sizeof(line)];
+    char            noCr[]  = "$GPGGA,142754.00";
+    GPS_InPlace_t   tok;
+    GPS_Sentence_t  sentence;
+
+    memcpy(copy, line, sizeof(line));
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseInPlace(&tok, line, NULL, 0U), NEO6M_OK);
+    ASSERT_EQ(tok.fieldNum, 15U);
+    ASSERT_STREQ(NEO6M_GPSNeo6_InPlaceField(&tok, 0U), "$GPGGA");
+    ASSERT_STREQ(NEO6M_GPSNeo6_InPlaceField(&tok, 9U), "21.0");
+    ASSERT_STREQ(NEO6M_GPSNeo6_InPlaceField(&tok, 14U), "*7B");
+    ASSERT_STREQ(NEO6M_GPSNeo6_InPlaceField(&tok, 15U), "");
+    ASSERT_EQ(line[6], '\0');
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseInPlace(&tok, copy, &sentence, NEO6M_FIELD_ALT), NEO6M_OK);
+    ASSERT_EQ(sentence.type, SENTENCE_GPGGA);
+    ASSERT_EQ(sentence.info.gga.alt, 210);
+    ASSERT_EQ(sentence.info.gga.hdop, 0U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseInPlace(&tok, noCr, &sentence, NEO6M_FIELD_ALL), NEO6M_NOK);
+    ASSERT_EQ(sentence.type, SENTENCE_UNKNOWN);
+}
+
+TEST(NEO6M_Allocations, Testcase_002)
+{
+    /* The longest lines fit the list storage, whichever backend serves it */
+    std::string     commas  = "$GPVTG" + std::string(GPS_MAX_LINE_LENGTH - 7U, ',') + "\r\n";
+    std::string     full    = "$GPVTG" + std::string(GPS_MAX_LINE_LENGTH - 6U, ',');
+    char const*     vtg     = "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n";
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  sentence;
+    uint32_t        round;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    for (round = 0U; round < 3U; round++)
+    {
+        ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, commas.c_str(), &sentence), NEO6M_NOK);
+        ASSERT_EQ(sentence.type, SENTENCE_GPVTG);
+        ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, full.data(), full.size(), &sentence), NEO6M_NOK);
+        ASSERT_EQ(sentence.type, SENTENCE_GPVTG);
+        ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, vtg, &sentence), NEO6M_OK);
+        ASSERT_EQ(sentence.info.vtg.cogt, 7752U);
+        ASSERT_EQ(ctx.pHead, (Node_t*)NULL);
+    }
+
+#if (NEO6M_CFG_STATIC_POOL != 0)
+    ASSERT_EQ(ctx.pool.nodeUsed, 0U);
+    ASSERT_EQ(ctx.pool.dataUsed, 0U);
+#endif
+}
+
+TEST(NEO6M_ParseSentenceErr, Testcase_001)
+{
+    /* One line per kind of failure */
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  sentence;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n", &sentence, NULL), NEO6M_ERR_NONE);
+    ASSERT_EQ(sentence.type, SENTENCE_GPRMC);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n", &sentence, NULL), NEO6M_ERR_NONE);
+    ASSERT_EQ(sentence.type, SENTENCE_GPVTG);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06\r\n", &sentence, NULL), NEO6M_ERR_BAD_START);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*07\r\n", &sentence, NULL), NEO6M_ERR_CHECKSUM);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*0G\r\n", &sentence, NULL), NEO6M_ERR_CHECKSUM);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A\r\n", &sentence, NULL), NEO6M_ERR_CHECKSUM);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPVTG,77.52,T,,M,0.004,N,0.008,K,A*06", &sentence, NULL), NEO6M_ERR_TRUNCATED);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, (std::string("$GPVTG") + std::string(120, ',') + "\r\n").c_str(), &sentence, NULL), NEO6M_ERR_TRUNCATED);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPGSV,1,1,00*79\r\n", &sentence, NULL), NEO6M_ERR_UNKNOWN_TYPE);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, "$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n", &sentence, NULL), NEO6M_ERR_NO_FIX);
+    ASSERT_EQ(sentence.type, SENTENCE_GPRMC);
+
+#if (NEO6M_STATS_ENABLE != 0)
+    ASSERT_EQ(ctx.stats.checksumFail, 3U);
+#endif
+    ASSERT_EQ(ctx.pHead, (Node_t*)NULL);
+}
+
+TEST(NEO6M_ParseSentenceErr, Testcase_002)
+{
+    /* An invalid field reports its index */
+    auto frame = [](std::string const& body)
+    {
+        uint8_t checksum = 0U;
+        char    digits[3];
+
+        for (char c : body)
+        {
+            checksum ^= (uint8_t)c;
+        }
+
+        (void) snprintf(digits, sizeof(digits), "%02X", checksum);
+
+        return "$" + body + "*" + digits + "\r\n";
+    };
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  sentence;
+    uint8_t         field;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, frame("GPRMC,083559.00,A,4717.11437,X,00833.91522,E,0.004,77.52,091202,,,A").c_str(), &sentence, &field), NEO6M_ERR_FIELD);
+    ASSERT_EQ(field, 3U);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, frame("GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091302,,,A").c_str(), &sentence, &field), NEO6M_ERR_FIELD);
+    ASSERT_EQ(field, 9U);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, frame("GPGGA,253559.00,4717.11437,N,00833.91522,E,1,08,0.94,499.6,M,48.0,M,,").c_str(), &sentence, &field), NEO6M_ERR_FIELD);
+    ASSERT_EQ(field, 1U);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, frame("GPGGA,083559.00,4717.11437,N,0083x.91522,E,1,08,0.94,499.6,M,48.0,M,,").c_str(), &sentence, &field), NEO6M_ERR_FIELD);
+    ASSERT_EQ(field, 4U);
+
+    /* Any other result clears the index */
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceErr(&ctx, frame("GPVTG,77.52,T,,M,0.004,N,0.008,K,A").c_str(), &sentence, &field), NEO6M_ERR_NONE);
+    ASSERT_EQ(field, 0U);
+
+#if (NEO6M_STATS_ENABLE != 0)
+    /* Rejected for a field, so counted as failed */
+    ASSERT_EQ(ctx.stats.type[SENTENCE_GPRMC].ok, 0U);
+    ASSERT_EQ(ctx.stats.type[SENTENCE_GPRMC].fail, 2U);
+    ASSERT_EQ(ctx.stats.type[SENTENCE_GPGGA].fail, 2U);
+    ASSERT_EQ(ctx.stats.type[SENTENCE_GPVTG].ok, 1U);
+#endif
+
+    ASSERT_EQ(sizeof(NEO6M_Error_t), 1U);
+}
+
+TEST(NEO6M_FieldPresence, Testcase_001)
+{
+    /* An empty course and a course of 0 both read as 0, the presence mask tells them apart */
+    char const*     empty   = "$GPVTG,,T,,M,0.004,N,0.008,K,A*2F\r\n";
+    char const*     zero    = "$GPVTG,0.00,T,,M,0.004,N,0.008,K,A*31\r\n";
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  sentence;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, empty, &sentence), NEO6M_OK);
+    ASSERT_EQ(sentence.info.vtg.cogt, 0U);
+    ASSERT_EQ(sentence.info.vtg.present & GPVTG_PRESENT_COGT, 0U);
+    ASSERT_NE(sentence.info.vtg.present & GPVTG_PRESENT_SKNOTS, 0U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, zero, &sentence), NEO6M_OK);
+    ASSERT_EQ(sentence.info.vtg.cogt, 0U);
+    ASSERT_NE(sentence.info.vtg.present & GPVTG_PRESENT_COGT, 0U);
+
+    /* Header, fields 1, 2, 4-9; the empty magnetic course and the checksum are not present */
+    ASSERT_EQ(sentence.info.vtg.present, 0x3F7UL);
+    ASSERT_EQ(ctx.present, 0U);
+}
+
+TEST(NEO6M_FieldPresence, Testcase_002)
+{
+    /* Every tokenizer fills in the same mask, whatever ends the line */
+    char const*     line    = "$GPGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*5B\r\n";
+    std::string     copy    = line;
+    NEO6M_Ctx_t     ctx;
+    GPS_Sentence_t  eager;
+    GPS_Sentence_t  sentence;
+    GPS_Lazy_t      lazy;
+    GPS_InPlace_t   tok;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, line, &eager), NEO6M_OK);
+    ASSERT_EQ((eager.info.gga.present & GPGGA_PRESENT_LAT), GPGGA_PRESENT_LAT);
+    ASSERT_EQ(eager.info.gga.present & NEO6M_PRESENT(14U), 0U);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceLen(&ctx, line, strchr(line, '*') - line, &sentence), NEO6M_OK);
+    ASSERT_EQ(sentence.info.gga.present, eager.info.gga.present);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyParse(&lazy, line), NEO6M_OK);
+    ASSERT_EQ(NEO6M_GPSNeo6_LazyGet(&lazy, NEO6M_FIELD_ALL)->info.gga.present, eager.info.gga.present);
+
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseInPlace(&tok, &copy[0], &sentence, NEO6M_FIELD_ALL), NEO6M_OK);
+    ASSERT_EQ(sentence.info.gga.present, eager.info.gga.present);
+
+    /* Fields left out of a selection are still reported */
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentenceFields(&ctx, line, &sentence, NEO6M_FIELD_TIME), NEO6M_OK);
+    ASSERT_EQ(sentence.info.gga.present, eager.info.gga.present);
+}
@@ -0,0 +1,132 @@
+#include <string>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_LogParse.h"
+}
+
+/* Builds a log mixing decodable sentences, no-fix sentences, garbage, long and unterminated lines */
+static std::string LogParse_BuildLog(uint32_t epochs)
+{
+    std::string log = "garbage before the first line\n";
+    char        line[128];
+    uint32_t    epoch;
+
+    for (epoch = 0U; epoch < epochs; epoch++)
+    {
+        snprintf(line, sizeof(line), "$GPRMC,%02u%02u%02u.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n",
+                 (epoch / 3600U) % 24U, (epoch / 60U) % 60U, epoch % 60U);
+        log += line;
+        snprintf(line, sizeof(line), "$GPVTG,%u.52,T,,M,0.004,N,0.008,K,A*06\r\n", epoch % 360U);
+        log += line;
+        snprintf(line, sizeof(line), "$GPGGA,%02u%02u%02u.00,4717.11437,N,00833.91522,E,1,08,1.01,-%u.6,M,48.0,M,,*5B\r\n",
+                 (epoch / 3600U) % 24U, (epoch / 60U) % 60U, epoch % 60U, epoch % 500U);
+        log += line;
+        log += "$GPGSA,A,3,04,05,09,12,,,,,,,,,2.56,1.27,2.22*0D\r\n";
+        log += "$GPGSV,2,1,05,04,,,44,08,,,41,09,,,37,21,,,26*7C\r\n";
+
+        switch (epoch % 7U)
+        {
+            case 0U: log += "$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n"; break;
+            case 1U: log += "noise $GPVTG,1.0,T,,M,0.004,N,0.008,K,A*06\r\n"; break;
+            case 2U: log += "$GPTXT," + std::string(120, 'x') + "*00\r\n"; break;
+            case 3U: log += "\n\n$$\n"; break;
+            case 4U: log += "$GPVTG,2.0,T,,M,0.004,N,0.008,K,A*06\n"; break;
+            default: break;
+        }
+    }
+
+    /* Last line cut by the end of the capture */
+    log += "$GPRMC,235959.00,A,4717.1";
+
+    return log;
+}
+
+static void LogParse_ExpectSame(LogParse_Result_t const* pA, LogParse_Result_t const* pB)
+{
+    ASSERT_EQ(pA->count, pB->count);
+    ASSERT_EQ(pA->lines, pB->lines);
+    ASSERT_EQ(pA->failures, pB->failures);
+    ASSERT_EQ(pA->skipped, pB->skipped);
+    ASSERT_EQ(memcmp(pA->records, pB->records, pA->count * sizeof(LogParse_Record_t)), 0);
+}
+
+TEST(NEO6M_LogParse_Buffer, Testcase_001)
+{
+    std::string         log = LogParse_BuildLog(7U);
+    LogParse_Result_t   result;
+
+    ASSERT_EQ(NEO6M_LogParse_Buffer(log.data(), log.size(), &result), NEO6M_OK);
+
+    /* RMC, VTG, GGA, GSA per epoch decode; the extra VTG only ends in '\n' */
+    ASSERT_EQ(result.count, 28U);
+    ASSERT_EQ(result.lines, 7U * 5U + 4U + 1U);
+    ASSERT_EQ(result.skipped, 1U);
+    ASSERT_EQ(result.records[0].offset, log.find("$GPRMC"));
+    ASSERT_EQ(result.records[0].sentence.type, SENTENCE_GPRMC);
+    ASSERT_EQ(result.records[1].sentence.type, SENTENCE_GPVTG);
+    ASSERT_EQ(result.records[2].sentence.type, SENTENCE_GPGGA);
+    ASSERT_EQ(result.records[3].sentence.type, SENTENCE_GPGSA);
+    ASSERT_EQ(result.records[6].sentence.info.gga.alt, -16);
+    ASSERT_EQ(result.records[24].sentence.info.rmc.time.sec, 6U);
+
+    NEO6M_LogParse_Free(&result);
+    ASSERT_EQ(result.records, (LogParse_Record_t*)NULL);
+}
+
+TEST(NEO6M_LogParse_BufferParallel, Testcase_001)
+{
+    /* Identical to the serial path whatever the chunk size and thread count */
+    std::string         log = LogParse_BuildLog(500U);
+    LogParse_Result_t   serial;
+    LogParse_Result_t   parallel;
+    uint64_t            chunks[] = {1U, 7U, 64U, 333U, 4096U, 0U};
+    uint16_t            threads[] = {1U, 2U, 3U, 8U, 0U};
+
+    ASSERT_EQ(NEO6M_LogParse_Buffer(log.data(), log.size(), &serial), NEO6M_OK);
+    ASSERT_EQ(serial.count, 2000U);
+
+    for (uint64_t chunk : chunks)
+    {
+        for (uint16_t thread : threads)
+        {
+            ASSERT_EQ(NEO6M_LogParse_BufferParallel(log.data(), log.size(), thread, chunk, &parallel), NEO6M_OK);
+            LogParse_ExpectSame(&serial, &parallel);
+            NEO6M_LogParse_Free(&parallel);
+        }
+    }
+
+    NEO6M_LogParse_Free(&serial);
+
+    ASSERT_EQ(NEO6M_LogParse_BufferParallel("", 0U, 4U, 0U, &parallel), NEO6M_OK);
+    ASSERT_EQ(parallel.count, 0U);
+    ASSERT_EQ(parallel.lines, 0U);
+}
+
+TEST(NEO6M_LogParse_File, Testcase_001)
+{
+    std::string         log = LogParse_BuildLog(200U);
+    char                path[] = "/tmp/neo6m_logparse_XXXXXX";
+    int                 fd = mkstemp(path);
+    LogParse_Result_t   serial;
+    LogParse_Result_t   parallel;
+
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, log.data(), log.size()), (ssize_t)log.size());
+    close(fd);
+
+    ASSERT_EQ(NEO6M_LogParse_File(path, 1U, &serial), NEO6M_OK);
+    ASSERT_EQ(NEO6M_LogParse_File(path, 0U, &parallel), NEO6M_OK);
+    ASSERT_EQ(serial.count, 800U);
+    LogParse_ExpectSame(&serial, &parallel);
+
+    NEO6M_LogParse_Free(&serial);
+    NEO6M_LogParse_Free(&parallel);
+    unlink(path);
+
+    ASSERT_EQ(NEO6M_LogParse_File(path, 1U, &serial), NEO6M_NOK);
+}
@@ -0,0 +1,182 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_NmeaGen.h"
+}
+
+static std::string NmeaGen_Run(NmeaGen_Config_t const* pConfig, uint32_t epochs, NmeaGen_Ctx_t *pCtx)
+{
+    char        epoch[NMEAGEN_MAX_EPOCH_LENGTH];
+    std::string out;
+    uint32_t    index;
+
+    NEO6M_NmeaGen_Init(pCtx, pConfig);
+
+    for (index = 0U; index < epochs; index++)
+    {
+        out.append(epoch, NEO6M_NmeaGen_NextEpoch(pCtx, epoch, sizeof(epoch)));
+    }
+
+    return out;
+}
+
+static std::vector<std::string> NmeaGen_Lines(std::string const& stream)
+{
+    std::vector<std::string>    lines;
+    size_t                      begin = 0U;
+    size_t                      end;
+
+    while ((end = stream.find('\n', begin)) != std::string::npos)
+    {
+        lines.push_back(stream.substr(begin, end + 1U - begin));
+        begin = end + 1U;
+    }
+
+    return lines;
+}
+
+TEST(NEO6M_NmeaGen_NextEpoch, Testcase_001)
+{
+    /* Same seed, same bytes; another seed, another stream */
+    NmeaGen_Config_t    config;
+    NmeaGen_Ctx_t       ctx;
+    std::string         first;
+    char                small[NMEAGEN_MAX_EPOCH_LENGTH - 1U];
+
+    NEO6M_NmeaGen_DefaultConfig(&config);
+    config.seed = 42U;
+    config.corruptPermille  = 100U;
+    config.truncatePermille = 100U;
+
+    first = NmeaGen_Run(&config, 200U, &ctx);
+    ASSERT_EQ(NmeaGen_Run(&config, 200U, &ctx), first);
+
+    config.seed = 43U;
+    ASSERT_NE(NmeaGen_Run(&config, 200U, &ctx), first);
+
+    ASSERT_EQ(NEO6M_NmeaGen_NextEpoch(&ctx, small, sizeof(small)), 0U);
+}
+
+TEST(NEO6M_NmeaGen_NextEpoch, Testcase_002)
+{
+    /* Without corruption every sentence is valid and every supported type decodes */
+    NmeaGen_Config_t            config;
+    NmeaGen_Ctx_t               ctx;
+    GPS_Sentence_t              sentence;
+    std::vector<std::string>    lines;
+    uint32_t                    decoded[5] = {0};
+
+    NEO6M_NmeaGen_DefaultConfig(&config);
+    config.epochMs = 100U;
+    config.startTimeMs = 86399000U;
+
+    lines = NmeaGen_Lines(NmeaGen_Run(&config, 50U, &ctx));
+
+    ASSERT_EQ(lines.size(), ctx.sentences);
+    ASSERT_EQ(ctx.corrupted, 0U);
+    ASSERT_EQ(ctx.truncated, 0U);
+
+    for (std::string const& line : lines)
+    {
+        ASSERT_LE(line.size(), NMEAGEN_MAX_SENTENCE_LENGTH);
+        ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksum(line.c_str()), NEO6M_OK) << line;
+
+        if (line.compare(0, 6, "$GPGSV") != 0)
+        {
+            ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(line.c_str(), &sentence), NEO6M_OK) << line;
+            decoded[sentence.type]++;
+        }
+    }
+
+    ASSERT_EQ(decoded[SENTENCE_GPRMC], 50U);
+    ASSERT_EQ(decoded[SENTENCE_GPVTG], 50U);
+    ASSERT_EQ(decoded[SENTENCE_GPGGA], 50U);
+    ASSERT_EQ(decoded[SENTENCE_GPGSA], 50U);
+
+    /* 10 Hz from 23:59:59 crosses midnight into the next day */
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(lines.back().c_str(), &sentence), NEO6M_NOK);
+    ASSERT_EQ(ctx.day, 2U);
+    ASSERT_EQ(ctx.timeMs, 4000U);
+}
+
+TEST(NEO6M_NmeaGen_NextEpoch, Testcase_003)
+{
+    /* Sentence mask, movement, corruption and truncation */
+    NmeaGen_Config_t            config;
+    NmeaGen_Ctx_t               ctx;
+    GPS_Sentence_t              first;
+    GPS_Sentence_t              last;
+    std::vector<std::string>    lines;
+    std::string                 stream;
+    uint32_t                    invalid = 0U;
+
+    NEO6M_NmeaGen_DefaultConfig(&config);
+    config.sentenceMask = NMEAGEN_RMC;
+    config.speedMmps    = 20000U;
+
+    lines = NmeaGen_Lines(NmeaGen_Run(&config, 120U, &ctx));
+    ASSERT_EQ(lines.size(), 120U);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(lines.front().c_str(), &first), NEO6M_OK);
+    ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(lines.back().c_str(), &last), NEO6M_OK);
+    ASSERT_EQ(last.info.rmc.time.min, (first.info.rmc.time.min + 1U) % 60U);
+    ASSERT_EQ(last.info.rmc.time.sec, (first.info.rmc.time.sec + 59U) % 60U);
+    ASSERT_TRUE((last.info.rmc.lat.fracDegs != first.info.rmc.lat.fracDegs)
+                || (last.info.rmc.lng.fracDegs != first.info.rmc.lng.fracDegs));
+
+    config.sentenceMask     = NMEAGEN_ALL;
+    config.corruptPermille  = 1000U;
+    stream = NmeaGen_Run(&config, 20U, &ctx);
+    ASSERT_EQ(ctx.corrupted, ctx.sentences);
+
+    for (std::string const& line : NmeaGen_Lines(stream))
+    {
+        invalid += (NEO6M_GPSNeo6_VerifyChecksum(line.c_str()) == NEO6M_NOK) ? 1U : 0U;
+    }
+
+    ASSERT_EQ(invalid, ctx.sentences);
+
+    config.corruptPermille  = 0U;
+    config.truncatePermille = 1000U;
+    stream = NmeaGen_Run(&config, 20U, &ctx);
+    ASSERT_EQ(ctx.truncated, ctx.sentences);
+    ASSERT_EQ(stream.find("\r\n"), std::string::npos);
+}
+
+TEST(NEO6M_NmeaGen_NextEpoch, Testcase_004)
+{
+    /* Out of range settings are clamped: sentences fit the NMEA limit and coordinates stay valid */
+    NmeaGen_Config_t            config;
+    NmeaGen_Ctx_t               ctx;
+    GPS_Sentence_t              sentence;
+    std::vector<std::string>    lines;
+
+    NEO6M_NmeaGen_DefaultConfig(&config);
+    config.sentenceMask = NMEAGEN_RMC | NMEAGEN_VTG | NMEAGEN_GGA;
+    config.speedMmps    = 4000000000U;
+    config.startLatE7   = 899999999;
+    config.startLngE7   = 1799999999;
+
+    lines = NmeaGen_Lines(NmeaGen_Run(&config, 2000U, &ctx));
+
+    ASSERT_EQ(ctx.config.speedMmps, NMEAGEN_MAX_SPEED_MMPS);
+    ASSERT_EQ(lines.size(), ctx.sentences);
+    ASSERT_EQ(lines.size(), 3U * 2000U);
+
+    for (std::string const& line : lines)
+    {
+        ASSERT_LE(line.size(), NMEAGEN_MAX_SENTENCE_LENGTH) << line;
+        ASSERT_EQ(NEO6M_GPSNeo6_ParseSentence(line.c_str(), &sentence), NEO6M_OK) << line;
+
+        if (sentence.type == SENTENCE_GPRMC)
+        {
+            ASSERT_LT(sentence.info.rmc.lat.degs, 90U) << line;
+            ASSERT_LE(sentence.info.rmc.lng.degs, 180U) << line;
+        }
+    }
+
+    ASSERT_LE(ctx.lat, 85.0);
+    ASSERT_GE(ctx.lat, -85.0);
+}
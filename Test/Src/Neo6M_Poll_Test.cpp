@@ -0,0 +1,182 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_Poll.h"
+}
+
+/* Simulated receiver with periodic output disabled: answers only the polls it gets */
+struct PolledReceiver
+{
+    std::vector<std::string>    requests;
+    std::string                 replies;
+    uint32_t                    tick;
+};
+
+static void PolledReceiver_Write(void *pUser, uint8_t const* data, uint16_t len)
+{
+    PolledReceiver *pRx = (PolledReceiver*)pUser;
+    std::string     request((char const*)data, len);
+    uint8_t         posllh[28] = {0};
+    uint8_t         frame[28 + UBX_FRAME_OVERHEAD];
+    uint16_t        frameLen;
+
+    pRx->requests.push_back(request);
+
+    if (request == "$EIGPQ,RMC*3A\r\n")
+    {
+        pRx->replies += "$GPRMC,142754.00,A,1048.17086,N,10639.46105,E,0.034,,210923,,,A*73\r\n";
+    }
+    else if ((len == UBX_FRAME_OVERHEAD) && (data[2] == 0x01) && (data[3] == 0x02))
+    {
+        /* NAV-POSLLH: the poll echo of the receiver is not a reply */
+        posllh[0] = 0x2A;
+        frameLen = NEO6M_UBX_EncodeFrame(0x01, 0x02, posllh, sizeof(posllh), frame, sizeof(frame));
+        pRx->replies.append((char*)frame, frameLen);
+    }
+}
+
+static uint32_t PolledReceiver_Tick(void *pUser)
+{
+    return ((PolledReceiver*)pUser)->tick;
+}
+
+static void Poll_OnLine(void *pUser, char const* line, uint8_t len)
+{
+    NEO6M_Poll_OnLine((Poll_Ctx_t*)pUser, line, len);
+}
+
+static void Poll_OnFrame(void *pUser, UBX_Frame_t const* pFrame)
+{
+    NEO6M_Poll_OnFrame((Poll_Ctx_t*)pUser, pFrame);
+}
+
+TEST(NEO6M_Poll_BuildGPQ, Testcase_001)
+{
+    char            request[POLL_GPQ_MAX_LENGTH];
+
+    ASSERT_EQ(NEO6M_Poll_BuildGPQ("RMC", request, sizeof(request)), 15U);
+    ASSERT_STREQ(request, "$EIGPQ,RMC*3A\r\n");
+    ASSERT_EQ(NEO6M_Poll_BuildGPQ("GGA", request, sizeof(request)), 15U);
+    ASSERT_STREQ(request, "$EIGPQ,GGA*27\r\n");
+    ASSERT_EQ(NEO6M_Poll_BuildGPQ("RM", request, sizeof(request)), 0U);
+    ASSERT_EQ(NEO6M_Poll_BuildGPQ("RMC", request, 10U), 0U);
+}
+
+TEST(NEO6M_Poll, Testcase_001)
+{
+    /* One GPQ request, one reply, decoded with the regular API */
+    PolledReceiver  rx = {{}, "", 0U};
+    Poll_Ctx_t      poll;
+    Stream_Ctx_t    stream;
+    GPRMC_Info_t    pGPRMC_Info = {0};
+
+    NEO6M_Poll_Init(&poll, PolledReceiver_Write, PolledReceiver_Tick, &rx);
+    NEO6M_Stream_Init(&stream, Poll_OnLine, Poll_OnFrame, &poll);
+
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_IDLE);
+    ASSERT_EQ(NEO6M_Poll_RequestNmea(&poll, "RMC", 1000U), NEO6M_OK);
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_PENDING);
+
+    rx.tick = 120U;
+    NEO6M_Stream_Feed(&stream, (uint8_t const*)rx.replies.data(), rx.replies.size());
+
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_DONE);
+    ASSERT_EQ(rx.requests.size(), 1U);
+    ASSERT_EQ(NEO6M_GPSNeo6_Api(poll.line, &pGPRMC_Info), NEO6M_OK);
+    ASSERT_EQ(pGPRMC_Info.time.hr, 14U);
+    ASSERT_EQ(pGPRMC_Info.lng.degs, 106U);
+}
+
+TEST(NEO6M_Poll, Testcase_002)
+{
+    /* Other sentences do not answer the request, which then times out */
+    PolledReceiver  rx = {{}, "", 0U};
+    Poll_Ctx_t      poll;
+    Stream_Ctx_t    stream;
+    char            other[] = "$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32\r\n$GPRMCX,1*00\r\n";
+
+    NEO6M_Poll_Init(&poll, PolledReceiver_Write, PolledReceiver_Tick, &rx);
+    NEO6M_Stream_Init(&stream, Poll_OnLine, Poll_OnFrame, &poll);
+
+    ASSERT_EQ(NEO6M_Poll_RequestNmea(&poll, "GGA", 500U), NEO6M_OK);
+    NEO6M_Stream_Feed(&stream, (uint8_t const*)other, strlen(other));
+
+    rx.tick = 499U;
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_PENDING);
+    rx.tick = 500U;
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_TIMEOUT);
+}
+
+TEST(NEO6M_Poll, Testcase_003)
+{
+    /* UBX poll of NAV-POSLLH */
+    PolledReceiver  rx = {{}, "", 0U};
+    Poll_Ctx_t      poll;
+    Stream_Ctx_t    stream;
+
+    NEO6M_Poll_Init(&poll, PolledReceiver_Write, PolledReceiver_Tick, &rx);
+    NEO6M_Stream_Init(&stream, Poll_OnLine, Poll_OnFrame, &poll);
+
+    ASSERT_EQ(NEO6M_Poll_RequestUbx(&poll, 0x01, 0x02, 1000U), NEO6M_OK);
+    NEO6M_Stream_Feed(&stream, (uint8_t const*)rx.replies.data(), rx.replies.size());
+
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_DONE);
+    ASSERT_EQ(poll.frame.len, 28U);
+    ASSERT_EQ(poll.frame.payload[0], 0x2A);
+}
+
+static void Sink_Write(void *pUser, uint8_t const* data, uint16_t len)
+{
+    ((std::vector<std::vector<uint8_t>>*)pUser)->push_back(std::vector<uint8_t>(data, data + len));
+}
+
+static uint32_t Sink_Tick(void *pUser)
+{
+    (void)pUser;
+    return 0U;
+}
+
+TEST(NEO6M_Poll, Testcase_004)
+{
+    /* Periodic output is switched off with one CFG-MSG per NMEA message */
+    std::vector<std::vector<uint8_t>>   frames;
+    UBXCfg_Session_t                    session;
+    uint8_t                             rmcOff[] = {0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0xF0, 0x04, 0x00, 0xFE, 0x17};
+
+    NEO6M_UBXCfg_Init(&session, Sink_Write, Sink_Tick, &frames, 1000U, 3U);
+    ASSERT_EQ(NEO6M_Poll_QueueDisablePeriodic(&session), NEO6M_OK);
+    NEO6M_UBXCfg_Start(&session);
+
+    ASSERT_EQ(frames.size(), 6U);
+    ASSERT_EQ(frames[4], std::vector<uint8_t>(rmcOff, rmcOff + sizeof(rmcOff)));
+}
+
+TEST(NEO6M_Poll, Testcase_005)
+{
+    /* A reply corrupted on the wire is not taken; the good one that follows is */
+    PolledReceiver  rx = {{}, "", 0U};
+    Poll_Ctx_t      poll;
+    Stream_Ctx_t    stream;
+    char            corrupted[] = "$GPRMC,142754.00,A,1048.17086,N,10639.46105,E,0.034,,210923,,,A*74\r\n";
+    GPRMC_Info_t    pGPRMC_Info = {0};
+
+    NEO6M_Poll_Init(&poll, PolledReceiver_Write, PolledReceiver_Tick, &rx);
+    NEO6M_Stream_Init(&stream, Poll_OnLine, Poll_OnFrame, &poll);
+
+    ASSERT_EQ(NEO6M_Poll_RequestNmea(&poll, "RMC", 1000U), NEO6M_OK);
+    NEO6M_Stream_Feed(&stream, (uint8_t const*)corrupted, strlen(corrupted));
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_PENDING);
+
+    corrupted[10] = '9';
+    corrupted[strlen(corrupted) - 3U] = '3';
+    NEO6M_Stream_Feed(&stream, (uint8_t const*)corrupted, strlen(corrupted));
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_PENDING);
+
+    NEO6M_Stream_Feed(&stream, (uint8_t const*)rx.replies.data(), rx.replies.size());
+    ASSERT_EQ(NEO6M_Poll_Check(&poll), POLL_DONE);
+    ASSERT_EQ(NEO6M_GPSNeo6_Api(poll.line, &pGPRMC_Info), NEO6M_OK);
+    ASSERT_EQ(pGPRMC_Info.time.sec, 54U);
+}
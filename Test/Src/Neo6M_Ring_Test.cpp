@@ -0,0 +1,189 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#include "gtest/gtest.h"
+#include "Neo6M_AllocTracker.h"
+
+extern "C" {
+    #include "Neo6M_Ring.h"
+}
+
+#define RING_STRESS_SENTENCES       200000U
+
+struct RingCapture
+{
+    std::vector<std::string>    lines;
+    uint32_t                    expectedSeq;
+    uint32_t                    mismatches;
+};
+
+static void Ring_OnLine(void *pUser, char const* line, uint8_t len)
+{
+    ((RingCapture*)pUser)->lines.push_back(std::string(line, len));
+}
+
+static void Ring_CheckLine(void *pUser, char const* line, uint8_t len)
+{
+    RingCapture *pCapture = (RingCapture*)pUser;
+    char         expected[STREAM_MAX_LINE_LENGTH];
+    int          n;
+
+    n = snprintf(expected, sizeof(expected), "$GPTXT,%010u*00\r\n", pCapture->expectedSeq);
+
+    if ((n != len) || (memcmp(expected, line, len) != 0))
+    {
+        pCapture->mismatches++;
+    }
+
+    pCapture->expectedSeq++;
+}
+
+/* Pins the given thread to one CPU, wrapping when the machine has fewer CPUs */
+static void Ring_PinThread(std::thread &thread, unsigned cpu)
+{
+    unsigned    cpus = std::thread::hardware_concurrency();
+    cpu_set_t   set;
+
+    CPU_ZERO(&set);
+    CPU_SET((cpus > 0U) ? (cpu % cpus) : 0U, &set);
+    (void) pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+}
+
+TEST(NEO6M_Ring_Init, Testcase_001)
+{
+    uint8_t storage[16];
+    Ring_t  ring;
+
+    ASSERT_EQ(NEO6M_Ring_Init(&ring, storage, 16U), NEO6M_OK);
+    ASSERT_EQ(NEO6M_Ring_Init(&ring, storage, 12U), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_Ring_Init(&ring, storage, 1U), NEO6M_NOK);
+
+    /* Producer and consumer indexes live on separate cache lines */
+    ASSERT_GE(offsetof(Ring_t, tail) - offsetof(Ring_t, head), RING_CACHE_LINE_SIZE);
+    ASSERT_GE(offsetof(Ring_t, head) - offsetof(Ring_t, buffer), RING_CACHE_LINE_SIZE);
+}
+
+TEST(NEO6M_Ring_Push, Testcase_001)
+{
+    /* Wrap-around and overrun accounting */
+    uint8_t storage[8];
+    uint8_t out[8];
+    Ring_t  ring;
+
+    NEO6M_Ring_Init(&ring, storage, sizeof(storage));
+
+    ASSERT_EQ(NEO6M_Ring_Push(&ring, (uint8_t const*)"abcdef", 6U), 6U);
+    ASSERT_EQ(NEO6M_Ring_Pop(&ring, out, 4U), 4U);
+    ASSERT_EQ(memcmp(out, "abcd", 4U), 0);
+
+    ASSERT_EQ(NEO6M_Ring_Push(&ring, (uint8_t const*)"ghijklmn", 8U), 6U);
+    ASSERT_EQ(NEO6M_Ring_GetOverrunBytes(&ring), 2U);
+    ASSERT_EQ(ring.overrunEvents, 1U);
+    ASSERT_EQ(NEO6M_Ring_PushByte(&ring, 'x'), NEO6M_NOK);
+    ASSERT_EQ(NEO6M_Ring_GetOverrunBytes(&ring), 3U);
+
+    ASSERT_EQ(NEO6M_Ring_Pop(&ring, out, sizeof(out)), 8U);
+    ASSERT_EQ(memcmp(out, "efghijkl", 8U), 0);
+    ASSERT_EQ(NEO6M_Ring_Pop(&ring, out, sizeof(out)), 0U);
+
+    /* Both sides run from interrupt context, so neither may touch the heap */
+    ASSERT_NO_ALLOCS(NEO6M_Ring_Push(&ring, (uint8_t const*)"opq", 3U));
+    ASSERT_NO_ALLOCS(NEO6M_Ring_Pop(&ring, out, sizeof(out)));
+}
+
+TEST(NEO6M_Ring_Drain, Testcase_001)
+{
+    /* A sentence split across the end of the storage reaches the framer intact */
+    char            str[] = "$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n";
+    uint8_t         storage[32];
+    uint8_t         out[16];
+    RingCapture     capture;
+    Stream_Ctx_t    stream;
+    Ring_t          ring;
+
+    NEO6M_Ring_Init(&ring, storage, sizeof(storage));
+    NEO6M_Stream_Init(&stream, Ring_OnLine, NULL, &capture);
+
+    NEO6M_Ring_Push(&ring, (uint8_t const*)"0123456789ABCDEF", 16U);
+    NEO6M_Ring_Pop(&ring, out, sizeof(out));
+
+    ASSERT_EQ(NEO6M_Ring_Push(&ring, (uint8_t const*)str, 20U), 20U);
+    ASSERT_EQ(NEO6M_Ring_Drain(&ring, &stream), 20U);
+    ASSERT_EQ(NEO6M_Ring_Push(&ring, (uint8_t const*)&str[20], strlen(str) - 20U), strlen(str) - 20U);
+    ASSERT_EQ(NEO6M_Ring_Drain(&ring, &stream), strlen(str) - 20U);
+
+    ASSERT_EQ(capture.lines.size(), 1U);
+    ASSERT_EQ(capture.lines[0], str);
+    ASSERT_EQ(NEO6M_Ring_Drain(&ring, &stream), 0U);
+}
+
+TEST(NEO6M_Ring_Drain, Testcase_002)
+{
+    /* Producer and consumer threads on separate cores; every line must arrive once, in order */
+    static uint8_t      storage[1024];
+    RingCapture         capture = {};
+    Stream_Ctx_t        stream;
+    Ring_t              ring;
+    std::atomic<bool>   done(false);
+
+    NEO6M_Ring_Init(&ring, storage, sizeof(storage));
+    NEO6M_Stream_Init(&stream, Ring_CheckLine, NULL, &capture);
+
+    std::thread producer([&ring, &done]()
+    {
+        char        line[STREAM_MAX_LINE_LENGTH];
+        uint32_t    seq;
+        uint32_t    sent;
+        int         len;
+
+        for (seq = 0U; seq < RING_STRESS_SENTENCES; seq++)
+        {
+            len  = snprintf(line, sizeof(line), "$GPTXT,%010u*00\r\n", seq);
+            sent = 0U;
+
+            while (sent < (uint32_t)len)
+            {
+                sent += NEO6M_Ring_Push(&ring, (uint8_t const*)&line[sent], (uint32_t)len - sent);
+
+                if (sent < (uint32_t)len)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        done.store(true, std::memory_order_release);
+    });
+
+    std::thread consumer([&ring, &stream, &done]()
+    {
+        while (done.load(std::memory_order_acquire) == false)
+        {
+            if (NEO6M_Ring_Drain(&ring, &stream) == 0U)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        while (NEO6M_Ring_Drain(&ring, &stream) != 0U)
+        {
+        }
+    });
+
+    Ring_PinThread(producer, 0U);
+    Ring_PinThread(consumer, 1U);
+
+    producer.join();
+    consumer.join();
+
+    ASSERT_EQ(capture.expectedSeq, RING_STRESS_SENTENCES);
+    ASSERT_EQ(capture.mismatches, 0U);
+    ASSERT_EQ(stream.stats.nmeaLines, RING_STRESS_SENTENCES);
+    ASSERT_EQ(stream.stats.overflows, 0U);
+}
@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_GPSNeo6M.h"
+}
+
+static uint32_t Stats_Timed(NEO6M_StatsType_t const* pType)
+{
+    uint32_t total = 0U;
+    uint8_t  bucket;
+
+    for (bucket = 0U; bucket < NEO6M_STATS_BUCKETS; bucket++)
+    {
+        total += pType->cycles[bucket];
+    }
+
+    return total;
+}
+
+TEST(NEO6M_Stats, Testcase_001)
+{
+    /* Per-type outcomes and one histogram entry per decode */
+    char            rmc[]       = "$GPRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n";
+    char            rmcVoid[]   = "$GPRMC,083559.00,V,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*41\r\n";
+    char            gsa[]       = "$GPGSA,A,3,04,08,09,21,,,,,,,,,5.12,3.70,3.54*04\r\n";
+    char            gsv[]       = "$GPGSV,2,1,05,04,,,44,08,,,41,09,,,37,21,,,26*7C\r\n";
+    char            badSum[]    = "$GPGSA,A,3,04,08,09,21,,,,,,,,,5.12,3.70,3.54*05\r\n";
+    NEO6M_Ctx_t     ctx;
+    NEO6M_Stats_t  *pStats;
+    GPS_Sentence_t  sentence;
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+    pStats = NEO6M_GPSNeo6_GetStats(&ctx);
+    ASSERT_EQ(pStats, &ctx.stats);
+
+    (void)NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, rmc, &sentence);
+    (void)NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, rmc, &sentence);
+    (void)NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, rmcVoid, &sentence);
+    (void)NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, gsa, &sentence);
+    (void)NEO6M_GPSNeo6_ParseSentenceCtx(&ctx, gsv, &sentence);
+    ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksumCtx(&ctx, gsa), NEO6M_OK);
+    ASSERT_EQ(NEO6M_GPSNeo6_VerifyChecksumCtx(&ctx, badSum), NEO6M_NOK);
+
+    ASSERT_EQ(pStats->type[SENTENCE_GPRMC].ok, 2U);
+    ASSERT_EQ(pStats->type[SENTENCE_GPRMC].fail, 1U);
+    ASSERT_EQ(pStats->type[SENTENCE_GPGSA].ok, 1U);
+    ASSERT_EQ(pStats->type[SENTENCE_GPVTG].ok + pStats->type[SENTENCE_GPVTG].fail, 0U);
+    ASSERT_EQ(pStats->type[SENTENCE_UNKNOWN].fail, 1U);
+    ASSERT_EQ(pStats->checksumFail, 1U);
+
+    ASSERT_EQ(Stats_Timed(&pStats->type[SENTENCE_GPRMC]), 3U);
+    ASSERT_EQ(Stats_Timed(&pStats->type[SENTENCE_UNKNOWN]), 1U);
+    ASSERT_GT(NEO6M_Stats_Percentile(&pStats->type[SENTENCE_GPRMC], 500U), 0U);
+    ASSERT_EQ(NEO6M_Stats_Percentile(&pStats->type[SENTENCE_GPVTG], 500U), 0U);
+
+    NEO6M_GPSNeo6_InitCtx(&ctx);
+    ASSERT_EQ(pStats->type[SENTENCE_GPRMC].ok, 0U);
+}
+
+TEST(NEO6M_Stats, Testcase_002)
+{
+    /* The legacy Api records into the default context */
+    char            vtg[]   = "$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32\r\n";
+    char            bad[]   = "$GPVTG,1\r\n";
+    GPVTG_Info_t    info;
+    NEO6M_Stats_t  *pStats  = NEO6M_GPSNeo6_GetStats(NULL);
+    uint32_t        ok      = pStats->type[SENTENCE_GPVTG].ok;
+    uint32_t        fail    = pStats->type[SENTENCE_GPVTG].fail;
+
+    ASSERT_EQ(NEO6M_GPSNeo6_Api(vtg, &info), NEO6M_OK);
+    ASSERT_EQ(NEO6M_GPSNeo6_Api(bad, &info), NEO6M_NOK);
+
+    ASSERT_EQ(pStats->type[SENTENCE_GPVTG].ok, ok + 1U);
+    ASSERT_EQ(pStats->type[SENTENCE_GPVTG].fail, fail + 1U);
+}
+
+TEST(NEO6M_Stats_Percentile, Testcase_001)
+{
+    NEO6M_StatsType_t type;
+
+    memset(&type, 0, sizeof(type));
+    type.cycles[6]  = 90U;      /* [64, 128) */
+    type.cycles[10] = 10U;      /* [1024, 2048) */
+
+    ASSERT_EQ(NEO6M_Stats_Percentile(&type, 0U), 128U);
+    ASSERT_EQ(NEO6M_Stats_Percentile(&type, 900U), 128U);
+    ASSERT_EQ(NEO6M_Stats_Percentile(&type, 910U), 2048U);
+    ASSERT_EQ(NEO6M_Stats_Percentile(&type, 1000U), 2048U);
+}
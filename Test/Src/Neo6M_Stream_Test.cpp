@@ -0,0 +1,191 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_Stream.h"
+}
+
+struct StreamCapture
+{
+    std::vector<std::string>    lines;
+    std::vector<UBX_Frame_t>    frames;
+};
+
+static void Stream_OnLine(void *pUser, char const* line, uint8_t len)
+{
+    ((StreamCapture*)pUser)->lines.push_back(std::string(line, len));
+}
+
+static void Stream_OnFrame(void *pUser, UBX_Frame_t const* pFrame)
+{
+    ((StreamCapture*)pUser)->frames.push_back(*pFrame);
+}
+
+TEST(NEO6M_Stream_Feed, Testcase_001)
+{
+    char            str[] = "$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32\r\n$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n";
+    StreamCapture   capture;
+    Stream_Ctx_t    ctx;
+    GPVTG_Info_t    pGPVTG_Info = {0};
+
+    NEO6M_Stream_Init(&ctx, Stream_OnLine, Stream_OnFrame, &capture);
+    NEO6M_Stream_Feed(&ctx, (uint8_t const*)str, strlen(str));
+
+    ASSERT_EQ(capture.lines.size(), 2U);
+    ASSERT_EQ(capture.lines[0], "$GPVTG,184.34,T,,M,1.936,N,3.586,K,A*32\r\n");
+    ASSERT_EQ(capture.lines[1], "$GPRMC,142456.00,V,,,,,,,,,,N*7D\r\n");
+    ASSERT_EQ(NEO6M_GPSNeo6_Api(capture.lines[0].c_str(), &pGPVTG_Info), NEO6M_OK);
+    ASSERT_EQ(pGPVTG_Info.cogt, 18434U);
+}
+
+TEST(NEO6M_Stream_Feed, Testcase_002)
+{
+    /* NMEA and UBX interleaved, delivered one byte at a time */
+    uint8_t         ack[] = {0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, 0x06, 0x01, 0x0F, 0x38};
+    std::string     input = std::string("noise$GPVTG,,,,,,,,,N*30\r\n") + std::string((char*)ack, sizeof(ack)) + "$GPVTG,,T";
+    StreamCapture   capture;
+    Stream_Ctx_t    ctx;
+    size_t          index;
+
+    NEO6M_Stream_Init(&ctx, Stream_OnLine, Stream_OnFrame, &capture);
+
+    for (index = 0; index < input.size(); index++)
+    {
+        NEO6M_Stream_Feed(&ctx, (uint8_t const*)&input[index], 1);
+    }
+
+    ASSERT_EQ(capture.lines.size(), 1U);
+    ASSERT_EQ(capture.frames.size(), 1U);
+    ASSERT_EQ(capture.frames[0].cls, UBX_CLASS_ACK);
+    ASSERT_EQ(capture.frames[0].id, UBX_ID_ACK_ACK);
+    ASSERT_EQ(capture.frames[0].len, 2U);
+    ASSERT_EQ(capture.frames[0].payload[0], UBX_CLASS_CFG);
+    ASSERT_EQ(capture.frames[0].payload[1], 0x01);
+    ASSERT_EQ(ctx.state, STREAM_NMEA);
+}
+
+TEST(NEO6M_Stream_Feed, Testcase_003)
+{
+    /* Corrupted checksum is dropped, following line still delivered */
+    uint8_t         ack[] = {0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, 0x06, 0x01, 0x0F, 0x39};
+    std::string     input = std::string((char*)ack, sizeof(ack)) + "$GPVTG,,,,,,,,,N*30\r\n";
+    StreamCapture   capture;
+    Stream_Ctx_t    ctx;
+
+    NEO6M_Stream_Init(&ctx, Stream_OnLine, Stream_OnFrame, &capture);
+    NEO6M_Stream_Feed(&ctx, (uint8_t const*)input.data(), input.size());
+
+    ASSERT_EQ(capture.frames.size(), 0U);
+    ASSERT_EQ(capture.lines.size(), 1U);
+    ASSERT_EQ(ctx.stats.ubxChecksumErrors, 1U);
+}
+
+TEST(NEO6M_Stream_Feed, Testcase_004)
+{
+    /* Line longer than the buffer is dropped */
+    std::string     input = "$GPGSV" + std::string(STREAM_MAX_LINE_LENGTH, '1') + "\r\n$GPVTG,,,,,,,,,N*30\r\n";
+    StreamCapture   capture;
+    Stream_Ctx_t    ctx;
+
+    NEO6M_Stream_Init(&ctx, Stream_OnLine, NULL, &capture);
+    NEO6M_Stream_Feed(&ctx, (uint8_t const*)input.data(), input.size());
+
+    ASSERT_EQ(capture.lines.size(), 1U);
+    ASSERT_EQ(capture.lines[0], "$GPVTG,,,,,,,,,N*30\r\n");
+    ASSERT_EQ(ctx.stats.overflows, 1U);
+}
+
+TEST(NEO6M_Stream_Feed, Testcase_005)
+{
+    /* Noise is passed over in one search and counted */
+    std::string     noise(300, '\x11');
+    std::string     input = noise + "$GPVTG,,,,,,,,,N*30\r\n" + noise;
+    StreamCapture   capture;
+    Stream_Ctx_t    ctx;
+
+    NEO6M_Stream_Init(&ctx, Stream_OnLine, NULL, &capture);
+    NEO6M_Stream_Feed(&ctx, (uint8_t const*)input.data(), input.size());
+
+    ASSERT_EQ(capture.lines.size(), 1U);
+    ASSERT_EQ(ctx.stats.skippedBytes, 600U);
+    ASSERT_EQ(ctx.stats.rejectedLines, 0U);
+    ASSERT_EQ(ctx.state, STREAM_HUNT);
+}
+
+TEST(NEO6M_Stream_Feed, Testcase_006)
+{
+    /* Lines with bytes no NMEA line holds are dropped as soon as the byte arrives */
+    std::string     input = std::string("$GPVTG,1\x01") + "3,,,,,,,N*30\r\n"
+                            + "$GPVTG,,,,,,,,,N*30\rX\n"
+                            + "$GPVTG,,,,,,,,,N*30\n"
+                            + "$GPVTG,,,,,,,,,N*30\r\n";
+    StreamCapture   capture;
+    Stream_Ctx_t    ctx;
+
+    NEO6M_Stream_Init(&ctx, Stream_OnLine, NULL, &capture);
+    NEO6M_Stream_Feed(&ctx, (uint8_t const*)input.data(), input.size());
+
+    ASSERT_EQ(capture.lines.size(), 1U);
+    ASSERT_EQ(capture.lines[0], "$GPVTG,,,,,,,,,N*30\r\n");
+    ASSERT_EQ(ctx.stats.rejectedLines, 3U);
+    /* Rest of the first line and the '\n' after "\rX"; the rejecting byte itself is not skipped */
+    ASSERT_EQ(ctx.stats.skippedBytes, std::string("3,,,,,,,N*30\r\n").size() + 1U);
+}
+
+TEST(NEO6M_Stream_Feed, Testcase_007)
+{
+    /* Each message carries the receive times of its first and last byte */
+    struct StampCapture
+    {
+        Stream_Ctx_t                ctx;
+        std::vector<Stream_Stamp_t> stamps;
+    };
+    uint8_t         ack[] = {0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, 0x06, 0x01, 0x0F, 0x38};
+    std::string     line  = "$GPVTG,,,,,,,,,N*30\r\n";
+    StampCapture    capture;
+    auto onLine = [](void *pUser, char const*, uint8_t)
+    {
+        StampCapture *pCapture = (StampCapture*)pUser;
+
+        pCapture->stamps.push_back(pCapture->ctx.stamp);
+    };
+
+    NEO6M_Stream_Init(&capture.ctx, onLine, NULL, &capture);
+
+    /* A line split over three reads, a frame in one, then a line whose '$' ends a read */
+    NEO6M_Stream_FeedAt(&capture.ctx, (uint8_t const*)line.data(), 5U, 100U);
+    NEO6M_Stream_FeedAt(&capture.ctx, (uint8_t const*)&line[5], 5U, 200U);
+    NEO6M_Stream_FeedAt(&capture.ctx, (uint8_t const*)&line[10], line.size() - 10U, 300U);
+    NEO6M_Stream_FeedAt(&capture.ctx, ack, sizeof(ack), 400U);
+    ASSERT_EQ(capture.ctx.stamp.firstNs, 400U);
+    ASSERT_EQ(capture.ctx.stamp.lastNs, 400U);
+    NEO6M_Stream_FeedAt(&capture.ctx, (uint8_t const*)"noise$", 6U, 500U);
+    NEO6M_Stream_FeedAt(&capture.ctx, (uint8_t const*)&line[1], line.size() - 1U, 600U);
+
+    ASSERT_EQ(capture.stamps.size(), 2U);
+    ASSERT_EQ(capture.stamps[0].firstNs, 100U);
+    ASSERT_EQ(capture.stamps[0].lastNs, 300U);
+    ASSERT_EQ(capture.stamps[1].firstNs, 500U);
+    ASSERT_EQ(capture.stamps[1].lastNs, 600U);
+
+    /* Feed stamps with the monotonic clock */
+    uint64_t before = NEO6M_Stream_NowNs();
+
+    NEO6M_Stream_Feed(&capture.ctx, (uint8_t const*)line.data(), line.size());
+    ASSERT_EQ(capture.stamps.size(), 3U);
+    ASSERT_GE(capture.stamps[2].firstNs, before);
+    ASSERT_LE(capture.stamps[2].lastNs, NEO6M_Stream_NowNs());
+}
+
+TEST(NEO6M_Stream_Resync, Testcase_001)
+{
+    uint8_t         noise[]  = {0x00, 0x11, 0xB5, 0x62, '$'};
+    uint8_t         dollar[] = {'a', 'b', '$', 0xB5};
+
+    ASSERT_EQ(NEO6M_Stream_Resync(noise, sizeof(noise)), 2U);
+    ASSERT_EQ(NEO6M_Stream_Resync(dollar, sizeof(dollar)), 2U);
+    ASSERT_EQ(NEO6M_Stream_Resync(noise, 2U), 2U);
+    ASSERT_EQ(NEO6M_Stream_Resync(noise, 0U), 0U);
+}
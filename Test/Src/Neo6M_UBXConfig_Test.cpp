@@ -0,0 +1,195 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_Stream.h"
+    #include "Neo6M_UBXConfig.h"
+}
+
+/* Simulated receiver: decodes every command it gets and answers with ACK-ACK,
+   or ACK-NAK for the first nakCount commands with class/id nakCls/nakId */
+struct FakeReceiver
+{
+    Stream_Ctx_t            rxStream;
+    std::vector<uint8_t>    replies;
+    uint32_t                tick;
+    uint32_t                writes;
+    uint8_t                 nakCls;
+    uint8_t                 nakId;
+    uint8_t                 nakCount;
+    uint8_t                 silent;
+};
+
+static void FakeReceiver_OnCommand(void *pUser, UBX_Frame_t const* pFrame)
+{
+    FakeReceiver *pRx = (FakeReceiver*)pUser;
+    uint8_t ackPayload[2] = {pFrame->cls, pFrame->id};
+    uint8_t reply[16];
+    uint8_t ackId = UBX_ID_ACK_ACK;
+    uint16_t replyLen;
+
+    if (pRx->silent != 0U)
+    {
+        return;
+    }
+
+    if ((pFrame->cls == pRx->nakCls) && (pFrame->id == pRx->nakId) && (pRx->nakCount > 0U))
+    {
+        pRx->nakCount--;
+        ackId = UBX_ID_ACK_NAK;
+    }
+
+    replyLen = NEO6M_UBX_EncodeFrame(UBX_CLASS_ACK, ackId, ackPayload, 2U, reply, sizeof(reply));
+    pRx->replies.insert(pRx->replies.end(), reply, reply + replyLen);
+}
+
+static void FakeReceiver_Write(void *pUser, uint8_t const* data, uint16_t len)
+{
+    FakeReceiver *pRx = (FakeReceiver*)pUser;
+
+    pRx->writes++;
+    NEO6M_Stream_Feed(&pRx->rxStream, data, len);
+}
+
+static uint32_t FakeReceiver_Tick(void *pUser)
+{
+    return ((FakeReceiver*)pUser)->tick;
+}
+
+static void Host_OnFrame(void *pUser, UBX_Frame_t const* pFrame)
+{
+    NEO6M_UBXCfg_OnFrame((UBXCfg_Session_t*)pUser, pFrame);
+}
+
+static void FakeReceiver_Init(FakeReceiver *pRx)
+{
+    pRx->replies.clear();
+    pRx->tick       = 1000U;
+    pRx->writes     = 0U;
+    pRx->nakCls     = 0U;
+    pRx->nakId      = 0U;
+    pRx->nakCount   = 0U;
+    pRx->silent     = 0U;
+    NEO6M_Stream_Init(&pRx->rxStream, NULL, FakeReceiver_OnCommand, pRx);
+}
+
+static const uint8_t cfgRate[]      = {0xC8, 0x00, 0x01, 0x00, 0x01, 0x00};
+static const uint8_t cfgMsgGSV[]    = {0xF0, 0x03, 0x00};
+static const uint8_t cfgMsgGLL[]    = {0xF0, 0x01, 0x00};
+static const uint8_t cfgSbas[]      = {0x01, 0x03, 0x03, 0x00, 0x51, 0x62, 0x06, 0x00};
+
+static void Session_AddDefaults(UBXCfg_Session_t *pSession)
+{
+    ASSERT_EQ(NEO6M_UBXCfg_Add(pSession, UBX_CLASS_CFG, 0x08, cfgRate, sizeof(cfgRate)), NEO6M_OK);
+    ASSERT_EQ(NEO6M_UBXCfg_Add(pSession, UBX_CLASS_CFG, 0x01, cfgMsgGSV, sizeof(cfgMsgGSV)), NEO6M_OK);
+    ASSERT_EQ(NEO6M_UBXCfg_Add(pSession, UBX_CLASS_CFG, 0x01, cfgMsgGLL, sizeof(cfgMsgGLL)), NEO6M_OK);
+    ASSERT_EQ(NEO6M_UBXCfg_Add(pSession, UBX_CLASS_CFG, 0x16, cfgSbas, sizeof(cfgSbas)), NEO6M_OK);
+}
+
+TEST(NEO6M_UBXCfg, Testcase_001)
+{
+    /* All commands are sent before any reply, then acknowledged in one pass */
+    FakeReceiver        rx;
+    UBXCfg_Session_t    session;
+    Stream_Ctx_t        host;
+
+    FakeReceiver_Init(&rx);
+    NEO6M_UBXCfg_Init(&session, FakeReceiver_Write, FakeReceiver_Tick, &rx, 1000U, 3U);
+    NEO6M_Stream_Init(&host, NULL, Host_OnFrame, &session);
+    Session_AddDefaults(&session);
+
+    NEO6M_UBXCfg_Start(&session);
+    ASSERT_EQ(rx.writes, 4U);
+    ASSERT_EQ(NEO6M_UBXCfg_Poll(&session), UBXCFG_BUSY);
+
+    rx.tick += 42U;
+    NEO6M_Stream_Feed(&host, rx.replies.data(), rx.replies.size());
+
+    ASSERT_EQ(NEO6M_UBXCfg_Poll(&session), UBXCFG_DONE);
+    ASSERT_EQ(NEO6M_UBXCfg_GetElapsedMs(&session), 42U);
+    ASSERT_EQ(rx.writes, 4U);
+}
+
+TEST(NEO6M_UBXCfg, Testcase_002)
+{
+    /* NAK on the CFG-SBAS command: only that command is resent */
+    FakeReceiver        rx;
+    UBXCfg_Session_t    session;
+    Stream_Ctx_t        host;
+
+    FakeReceiver_Init(&rx);
+    rx.nakCls   = UBX_CLASS_CFG;
+    rx.nakId    = 0x16;
+    rx.nakCount = 1U;
+    NEO6M_UBXCfg_Init(&session, FakeReceiver_Write, FakeReceiver_Tick, &rx, 1000U, 3U);
+    NEO6M_Stream_Init(&host, NULL, Host_OnFrame, &session);
+    Session_AddDefaults(&session);
+
+    NEO6M_UBXCfg_Start(&session);
+    NEO6M_Stream_Feed(&host, rx.replies.data(), rx.replies.size());
+    rx.replies.clear();
+
+    ASSERT_EQ(session.cmds[3].state, UBXCFG_CMD_NAKED);
+    ASSERT_EQ(NEO6M_UBXCfg_Poll(&session), UBXCFG_BUSY);
+    ASSERT_EQ(rx.writes, 5U);
+    ASSERT_EQ(session.cmds[0].attempts, 1U);
+    ASSERT_EQ(session.cmds[3].attempts, 2U);
+
+    NEO6M_Stream_Feed(&host, rx.replies.data(), rx.replies.size());
+    ASSERT_EQ(NEO6M_UBXCfg_Poll(&session), UBXCFG_DONE);
+}
+
+TEST(NEO6M_UBXCfg, Testcase_003)
+{
+    /* Receiver stays silent: commands time out, are retried, then fail */
+    FakeReceiver        rx;
+    UBXCfg_Session_t    session;
+
+    FakeReceiver_Init(&rx);
+    rx.silent = 1U;
+    NEO6M_UBXCfg_Init(&session, FakeReceiver_Write, FakeReceiver_Tick, &rx, 100U, 2U);
+    Session_AddDefaults(&session);
+
+    NEO6M_UBXCfg_Start(&session);
+    rx.tick += 99U;
+    ASSERT_EQ(NEO6M_UBXCfg_Poll(&session), UBXCFG_BUSY);
+    ASSERT_EQ(rx.writes, 4U);
+
+    rx.tick += 1U;
+    ASSERT_EQ(NEO6M_UBXCfg_Poll(&session), UBXCFG_BUSY);
+    ASSERT_EQ(rx.writes, 8U);
+
+    rx.tick += 100U;
+    ASSERT_EQ(NEO6M_UBXCfg_Poll(&session), UBXCFG_DONE_WITH_FAILURES);
+    ASSERT_EQ(session.cmds[0].state, UBXCFG_CMD_FAILED);
+    ASSERT_EQ(NEO6M_UBXCfg_GetElapsedMs(&session), 200U);
+}
+
+TEST(NEO6M_UBXCfg, Testcase_004)
+{
+    /* Replies for other messages do not complete a command */
+    UBXCfg_Session_t    session;
+    UBX_Frame_t         frame = {0};
+    FakeReceiver        rx;
+
+    FakeReceiver_Init(&rx);
+    rx.silent = 1U;
+    NEO6M_UBXCfg_Init(&session, FakeReceiver_Write, FakeReceiver_Tick, &rx, 100U, 1U);
+    Session_AddDefaults(&session);
+    NEO6M_UBXCfg_Start(&session);
+
+    frame.cls           = UBX_CLASS_ACK;
+    frame.id            = UBX_ID_ACK_ACK;
+    frame.len           = 2U;
+    frame.payload[0]    = UBX_CLASS_CFG;
+    frame.payload[1]    = 0x01;
+    NEO6M_UBXCfg_OnFrame(&session, &frame);
+
+    ASSERT_EQ(session.cmds[1].state, UBXCFG_CMD_ACKED);
+    ASSERT_EQ(session.cmds[2].state, UBXCFG_CMD_SENT);
+
+    frame.payload[1]    = 0x24;
+    NEO6M_UBXCfg_OnFrame(&session, &frame);
+    ASSERT_EQ(session.cmds[0].state, UBXCFG_CMD_SENT);
+}
@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+
+extern "C" {
+    #include "Neo6M_UBX.h"
+}
+
+TEST(NEO6M_UBX_EncodeFrame, Testcase_001)
+{
+    /* CFG-MSG poll for NMEA GxRMC */
+    uint8_t         payload[] = {0xF0, 0x04};
+    uint8_t         expected[] = {0xB5, 0x62, 0x06, 0x01, 0x02, 0x00, 0xF0, 0x04, 0xFD, 0x15};
+    uint8_t         frame[16] = {0};
+    uint16_t        frameLen;
+
+    frameLen = NEO6M_UBX_EncodeFrame(UBX_CLASS_CFG, 0x01, payload, sizeof(payload), frame, sizeof(frame));
+
+    ASSERT_EQ(frameLen, sizeof(expected));
+    ASSERT_EQ(memcmp(frame, expected, sizeof(expected)), 0);
+}
+
+TEST(NEO6M_UBX_EncodeFrame, Testcase_002)
+{
+    /* Poll request with empty payload (MON-VER) */
+    uint8_t         expected[] = {0xB5, 0x62, 0x0A, 0x04, 0x00, 0x00, 0x0E, 0x34};
+    uint8_t         frame[8] = {0};
+    uint16_t        frameLen;
+
+    frameLen = NEO6M_UBX_EncodeFrame(0x0A, 0x04, NULL, 0, frame, sizeof(frame));
+
+    ASSERT_EQ(frameLen, sizeof(expected));
+    ASSERT_EQ(memcmp(frame, expected, sizeof(expected)), 0);
+}
+
+TEST(NEO6M_UBX_EncodeFrame, Testcase_003)
+{
+    uint8_t         payload[4] = {0};
+    uint8_t         frame[11] = {0};
+
+    ASSERT_EQ(NEO6M_UBX_EncodeFrame(UBX_CLASS_CFG, 0x01, payload, sizeof(payload), frame, sizeof(frame)), 0U);
+}
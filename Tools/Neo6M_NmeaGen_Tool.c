@@ -0,0 +1,142 @@
+/**
+  *******************************************************************************
+  * @file    Neo6M_NmeaGen_Tool.c
+  * @author  Huy Nguyen
+  * @brief   Command line front end of the synthetic NMEA generator
+  *******************************************************************************
+  * @attention
+  *
+  * MIT License
+  *
+  * Copyright (c) 2023 Nguyễn Công Huy
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  *
+  ******************************************************************************
+  */
+
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <unistd.h>
+
+#include "Neo6M_NmeaGen.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TOOL_USAGE \
+    "usage: Neo6M_NmeaGen_Tool [-s seed] [-n epochs] [-r rate_hz] [-v speed_mm_s]\n" \
+    "                          [-m rmc,vtg,gga,gsa,gsv] [-c corrupt_permille]\n" \
+    "                          [-t truncate_permille] [-o file]\n"
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief      This function parses a comma separated list of sentence names.
+  * @param[in]  list                Pointer to list, e.g. "rmc,gga"
+  * @retval     NMEAGEN_* bits, 0 if a name is unknown
+  */
+static uint8_t Tool_ParseMask(char const* list)
+{
+    static char const* const names[] = {"rmc", "vtg", "gga", "gsa", "gsv"};
+    uint8_t mask = 0U;
+    uint8_t index;
+    uint8_t found;
+
+    while (*list != '\0')
+    {
+        found = 0U;
+
+        for (index = 0U; index < 5U; index++)
+        {
+            if ((strncmp(list, names[index], 3U) == 0) && ((list[3] == ',') || (list[3] == '\0')))
+            {
+                mask |= (uint8_t)(1U << index);
+                found = 1U;
+            }
+        }
+
+        if (found == 0U)
+        {
+            return 0U;
+        }
+
+        list += (list[3] == ',') ? 4 : 3;
+    }
+
+    return mask;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief      Tool entry: writes a reproducible NMEA stream to a file or stdout.
+  * @retval     0 on success, 1 on bad arguments or write error
+  */
+int main(int argc, char **argv)
+{
+    NmeaGen_Config_t config;
+    NmeaGen_Ctx_t    ctx;
+    char             epoch[NMEAGEN_MAX_EPOCH_LENGTH];
+    unsigned long    epochs = 60UL;
+    unsigned long    index;
+    uint32_t         len;
+    FILE            *pOut = stdout;
+    int              option;
+
+    NEO6M_NmeaGen_DefaultConfig(&config);
+
+    while ((option = getopt(argc, argv, "s:n:r:v:m:c:t:o:h")) != -1)
+    {
+        switch (option)
+        {
+            case 's': config.seed               = strtoull(optarg, NULL, 0); break;
+            case 'n': epochs                    = strtoul(optarg, NULL, 0); break;
+            case 'r': config.epochMs            = (uint16_t)(1000UL / ((strtoul(optarg, NULL, 0) > 0UL) ? strtoul(optarg, NULL, 0) : 1UL)); break;
+            case 'v': config.speedMmps          = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'm': config.sentenceMask       = Tool_ParseMask(optarg); break;
+            case 'c': config.corruptPermille    = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 't': config.truncatePermille   = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'o': pOut                      = fopen(optarg, "wb"); break;
+            default:  (void) fputs(TOOL_USAGE, stderr); return 1;
+        }
+    }
+
+    if ((pOut == NULL) || (config.sentenceMask == 0U))
+    {
+        (void) fputs(TOOL_USAGE, stderr);
+        return 1;
+    }
+
+    NEO6M_NmeaGen_Init(&ctx, &config);
+
+    for (index = 0UL; index < epochs; index++)
+    {
+        len = NEO6M_NmeaGen_NextEpoch(&ctx, epoch, sizeof(epoch));
+
+        if (fwrite(epoch, 1U, len, pOut) != len)
+        {
+            return 1;
+        }
+    }
+
+    (void) fprintf(stderr, "%u sentences, %u corrupted, %u truncated\n", ctx.sentences, ctx.corrupted, ctx.truncated);
+
+    return (fclose(pOut) == 0) ? 0 : 1;
+}